@@ -150,6 +150,10 @@ typedef enum {
     /* Has this item been chained into a gen2 freelist? This is only used in
      * GC debug more. */
     MVM_CF_DEBUG_IN_GEN2_FREE_LIST = 4096,
+
+    /* Is this item on one of the incremental marking lists (grey or remark)?
+     * Keeps the write barrier from adding it many times over. */
+    MVM_CF_IN_GEN2_MARK_LIST = 8192,
 } MVMCollectableFlags;
 
 #ifdef MVM_USE_OVERFLOW_SERIALIZATION_INDEX
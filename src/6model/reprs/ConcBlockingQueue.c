@@ -1,4 +1,5 @@
 #include "moar.h"
+#include <platform/threads.h>
 
 /* This representation's function pointer table. */
 static const MVMREPROps ConcBlockingQueue_this_repr;
@@ -27,9 +28,6 @@ static void initialize(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, voi
     if ((init_stat = uv_mutex_init(&body->head_lock)) < 0)
         MVM_exception_throw_adhoc(tc, "Failed to initialize mutex: %s",
             uv_strerror(init_stat));
-    if ((init_stat = uv_mutex_init(&body->tail_lock)) < 0)
-        MVM_exception_throw_adhoc(tc, "Failed to initialize mutex: %s",
-            uv_strerror(init_stat));
     if ((init_stat = uv_cond_init(&body->head_cond)) < 0)
         MVM_exception_throw_adhoc(tc, "Failed to initialize condition variable: %s",
             uv_strerror(init_stat));
@@ -78,7 +76,6 @@ static void gc_free(MVMThreadContext *tc, MVMObject *obj) {
 
     /* Clean up  */
     uv_mutex_destroy(&body->head_lock);
-    uv_mutex_destroy(&body->tail_lock);
     uv_cond_destroy(&body->head_cond);
 
     /* Clean up body */
@@ -104,6 +101,42 @@ static void compose(MVMThreadContext *tc, MVMSTable *st, MVMObject *info) {
     /* Nothing to do for this REPR. */
 }
 
+/* Takes the head lock, marking the thread blocked while waiting for it. The
+ * caller must root any objects it uses afterwards. */
+static void lock_head(MVMThreadContext *tc, MVMConcBlockingQueueBody *body) {
+    MVM_gc_mark_thread_blocked(tc);
+    uv_mutex_lock(&body->head_lock);
+    MVM_gc_mark_thread_unblocked(tc);
+}
+
+/* Gets the first node in the queue, with the head lock held. Must only be
+ * called when elems is non-zero. A pusher may have swung the tail but not
+ * yet linked its node in; it will do so right away, so we just wait. */
+static MVMConcBlockingQueueNode * first_node(MVMConcBlockingQueueBody *body) {
+    MVMConcBlockingQueueNode *first;
+    while (!(first = (MVMConcBlockingQueueNode *)MVM_load(&body->head->next)))
+        MVM_platform_thread_yield();
+    return first;
+}
+
+/* Takes the first item from the queue, with the head lock held. Must only
+ * be called when elems is non-zero. */
+static MVMObject * take(MVMThreadContext *tc, MVMConcBlockingQueueBody *body) {
+    MVMConcBlockingQueueNode *taken = first_node(body);
+    MVMObject *result;
+    MVM_fixed_size_free(tc, tc->instance->fsa, sizeof(MVMConcBlockingQueueNode), body->head);
+    body->head = taken;
+    MVM_barrier();
+    result = taken->value;
+    taken->value = NULL;
+    MVM_barrier();
+
+    /* If there's more, pass the wake-up on to another waiting thread. */
+    if (MVM_decr(&body->elems) > 1 && MVM_load(&body->waiters))
+        uv_cond_signal(&body->head_cond);
+    return result;
+}
+
 static void at_pos(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMint64 index, MVMRegister *value, MVMuint16 kind) {
     MVMConcBlockingQueueBody *body = *(MVMConcBlockingQueueBody **)data;
 
@@ -115,16 +148,12 @@ static void at_pos(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *d
             "Can only get objects from a concurrent blocking queue");
 
     if (MVM_load(&body->elems) > 0) {
-        MVMConcBlockingQueueNode *peeked;
         unsigned int interval_id;
         interval_id = MVM_telemetry_interval_start(tc, "ConcBlockingQueue.at_pos");
-        MVMROOT(tc, root, {
-            MVM_gc_mark_thread_blocked(tc);
-            uv_mutex_lock(&body->head_lock);
-            MVM_gc_mark_thread_unblocked(tc);
-        });
-        peeked = body->head->next;
-        value->o = peeked ? peeked->value : tc->instance->VMNull;
+        lock_head(tc, body);
+        value->o = MVM_load(&body->elems) > 0
+            ? first_node(body)->value
+            : tc->instance->VMNull;
         uv_mutex_unlock(&body->head_lock);
         MVM_telemetry_interval_stop(tc, interval_id, "ConcBlockingQueue.at_pos");
     }
@@ -140,7 +169,7 @@ static MVMuint64 elems(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, voi
 
 static void push(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMRegister value, MVMuint16 kind) {
     MVMConcBlockingQueueBody *body = *(MVMConcBlockingQueueBody**)data;
-    MVMConcBlockingQueueNode *add;
+    MVMConcBlockingQueueNode *add, *prev;
     AO_t orig_elems;
     MVMObject *to_add = value.o;
     unsigned int interval_id;
@@ -155,23 +184,21 @@ static void push(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *dat
     add = MVM_fixed_size_alloc_zeroed(tc, tc->instance->fsa, sizeof(MVMConcBlockingQueueNode));
 
     interval_id = MVM_telemetry_interval_start(tc, "ConcBlockingQueue.push");
-    MVMROOT2(tc, root, to_add, {
-        MVM_gc_mark_thread_blocked(tc);
-        uv_mutex_lock(&body->tail_lock);
-        MVM_gc_mark_thread_unblocked(tc);
-    });
     MVM_ASSIGN_REF(tc, &(root->header), add->value, to_add);
-    body->tail->next = add;
-    body->tail = add;
+
+    /* Make the new node the tail, then link it in after the old one. There
+     * is no GC safepoint in between, so the GC always sees the whole list. */
+    do {
+        prev = (MVMConcBlockingQueueNode *)MVM_load(&body->tail);
+    } while (!MVM_trycas(&body->tail, prev, add));
+    MVM_store(&prev->next, add);
     orig_elems = MVM_incr(&body->elems);
-    uv_mutex_unlock(&body->tail_lock);
 
-    if (orig_elems == 0) {
-        MVMROOT(tc, root, {
-            MVM_gc_mark_thread_blocked(tc);
-            uv_mutex_lock(&body->head_lock);
-            MVM_gc_mark_thread_unblocked(tc);
-        });
+    /* Wake up a waiting thread, if there is one. Since both incrementing
+     * elems above and incrementing waiters are full barriers, either we see
+     * the waiter here or it sees the new element before it waits. */
+    if (MVM_load(&body->waiters)) {
+        lock_head(tc, body);
         uv_cond_signal(&body->head_cond);
         uv_mutex_unlock(&body->head_lock);
     }
@@ -198,29 +225,20 @@ static void unshift(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *
 
     add = MVM_fixed_size_alloc_zeroed(tc, tc->instance->fsa, sizeof(MVMConcBlockingQueueNode));
 
-    /* We'll need to hold both the head and the tail lock, in case head == tail
-     * and push would update tail->next - without the tail lock, this could
-     * race. Ensure that we lock in the same order */
+    /* Pushers may be linking a node in after the tail at any time, and the
+     * current dummy head node may be the tail, so we can't insert after it.
+     * Instead, the value goes into the current dummy node, and the new node
+     * becomes the dummy node in front of it. */
     MVMROOT2(tc, root, to_add, {
-        MVM_gc_mark_thread_blocked(tc);
-        uv_mutex_lock(&cbq->tail_lock);
-        uv_mutex_lock(&cbq->head_lock);
-        MVM_gc_mark_thread_unblocked(tc);
+        lock_head(tc, cbq);
     });
-
-    MVM_ASSIGN_REF(tc, &(root->header), add->value, to_add);
-    add->next = cbq->head->next;
-    cbq->head->next = add;
-
-    if (MVM_incr(&cbq->elems) == 0) {
-        /* add to tail as well - we still have that lock, so we can't race */
-        cbq->tail = add;
-        /* signal sleeping threads */
+    MVM_ASSIGN_REF(tc, &(root->header), cbq->head->value, to_add);
+    add->next = cbq->head;
+    cbq->head = add;
+    MVM_incr(&cbq->elems);
+    if (MVM_load(&cbq->waiters))
         uv_cond_signal(&cbq->head_cond);
-    }
-
     uv_mutex_unlock(&cbq->head_lock);
-    uv_mutex_unlock(&cbq->tail_lock);
 
     MVM_telemetry_interval_stop(tc, interval_id, "ConcBlockingQueue.unshift");
 }
@@ -228,36 +246,24 @@ static void unshift(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *
 
 static void shift(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMRegister *value, MVMuint16 kind) {
     MVMConcBlockingQueueBody *body = *(MVMConcBlockingQueueBody**)data;
-    MVMConcBlockingQueueNode *taken;
     unsigned int interval_id;
 
     if (kind != MVM_reg_obj)
         MVM_exception_throw_adhoc(tc, "Can only shift objects from a ConcBlockingQueue");
 
     interval_id = MVM_telemetry_interval_start(tc, "ConcBlockingQueue.shift");
-    MVMROOT(tc, root, {
-        MVM_gc_mark_thread_blocked(tc);
-        uv_mutex_lock(&body->head_lock);
-        MVM_gc_mark_thread_unblocked(tc);
-
+    lock_head(tc, body);
+    if (MVM_load(&body->elems) == 0) {
+        MVM_incr(&body->waiters);
         while (MVM_load(&body->elems) == 0) {
-                MVM_gc_mark_thread_blocked(tc);
-                uv_cond_wait(&body->head_cond, &body->head_lock);
-                MVM_gc_mark_thread_unblocked(tc);
+            MVM_gc_mark_thread_blocked(tc);
+            uv_cond_wait(&body->head_cond, &body->head_lock);
+            MVM_gc_mark_thread_unblocked(tc);
         }
-    });
-
-    taken = body->head->next;
-    MVM_fixed_size_free(tc, tc->instance->fsa, sizeof(MVMConcBlockingQueueNode), body->head);
-    body->head = taken;
-    MVM_barrier();
-    value->o = taken->value;
-    taken->value = NULL;
-    MVM_barrier();
-
-    if (MVM_decr(&body->elems) > 1)
-        uv_cond_signal(&body->head_cond);
+        MVM_decr(&body->waiters);
+    }
 
+    value->o = take(tc, body);
     uv_mutex_unlock(&body->head_lock);
     MVM_telemetry_interval_stop(tc, interval_id, "ConcBlockingQueue.shift");
 }
@@ -333,28 +339,17 @@ MVMObject * MVM_concblockingqueue_jit_poll(MVMThreadContext *tc, MVMObject *queu
 MVMObject * MVM_concblockingqueue_poll(MVMThreadContext *tc, MVMConcBlockingQueue *queue) {
     MVMConcBlockingQueue *cbq = (MVMConcBlockingQueue *)queue;
     MVMConcBlockingQueueBody *body = cbq->body;
-    MVMConcBlockingQueueNode *taken;
     MVMObject *result = tc->instance->VMNull;
     unsigned int interval_id;
 
-    interval_id = MVM_telemetry_interval_start(tc, "ConcBlockingQueue.poll");
-    MVMROOT(tc, cbq, { /* No need to root result as VMNull is always in gen2 */
-        MVM_gc_mark_thread_blocked(tc);
-        uv_mutex_lock(&body->head_lock);
-        MVM_gc_mark_thread_unblocked(tc);
-    });
+    /* If it's empty, don't bother with the lock. */
+    if (MVM_load(&body->elems) == 0)
+        return result;
 
-    if (MVM_load(&body->elems) > 0) {
-        taken = body->head->next;
-        MVM_fixed_size_free(tc, tc->instance->fsa, sizeof(MVMConcBlockingQueueNode), body->head);
-        body->head = taken;
-        MVM_barrier();
-        result = taken->value;
-        taken->value = NULL;
-        MVM_barrier();
-        if (MVM_decr(&body->elems) > 1)
-            uv_cond_signal(&body->head_cond);
-    }
+    interval_id = MVM_telemetry_interval_start(tc, "ConcBlockingQueue.poll");
+    lock_head(tc, body);
+    if (MVM_load(&body->elems) > 0)
+        result = take(tc, body);
 
     uv_mutex_unlock(&body->head_lock);
 
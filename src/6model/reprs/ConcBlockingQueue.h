@@ -9,18 +9,30 @@ struct MVMConcBlockingQueueNode {
  * inline, the object holds a pointer to the body. The body itself is allocated
  * by malloc() rather than GC. This prevents it from being moved which would be
  * a problem for mutexes and condition variables. Also, it prevents the GC from
- * moving the body while we are blocked on acquiring a lock (for example) */
+ * moving the body while we are blocked on acquiring a lock (for example)
+ *
+ * Pushing does not take a lock: the pusher swings the tail to its new node
+ * with a CAS, then links the old tail to it. Taking from the queue is done
+ * holding the head lock, so there's only one taker at a time; that means a
+ * node can be freed as soon as it is taken, since the pusher that linked to
+ * it is done with it by then. Takers that find the queue empty wait on the
+ * condition variable, and pushers only take the head lock to wake them if
+ * there are any waiting. */
 struct MVMConcBlockingQueueBody {
-    /* Head and tail of the queue. */
+    /* Head and tail of the queue. The head is a dummy node; the first item
+     * in the queue is the one after it. */
     MVMConcBlockingQueueNode *head;
     MVMConcBlockingQueueNode *tail;
 
     /* Number of elements currently in the queue. */
     AO_t elems;
 
-    /* Locks and condition variables storage. */
+    /* Number of threads waiting for an element to be pushed. */
+    AO_t waiters;
+
+    /* Lock held when taking from the queue, and condition variable that
+     * takers wait on when it's empty. */
     uv_mutex_t  head_lock;
-    uv_mutex_t  tail_lock;
     uv_cond_t   head_cond;
 };
 
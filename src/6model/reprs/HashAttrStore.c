@@ -21,33 +21,42 @@ static MVMObject * type_object_for(MVMThreadContext *tc, MVMObject *HOW) {
 static void copy_to(MVMThreadContext *tc, MVMSTable *st, void *src, MVMObject *dest_root, void *dest) {
     MVMHashAttrStoreBody *src_body  = (MVMHashAttrStoreBody *)src;
     MVMHashAttrStoreBody *dest_body = (MVMHashAttrStoreBody *)dest;
-    MVMHashEntry *current;
+    MVMStrHashTable *src_hashtable  = &(src_body->hashtable);
+    MVMStrHashTable *dest_hashtable = &(dest_body->hashtable);
+    MVMStrHashIterator iterator;
 
     /* NOTE: if we really wanted to, we could avoid rehashing... */
-    HASH_ITER_FAST(tc, hash_handle, src_body->hash_head, current, {
-        MVMHashEntry *new_entry = MVM_malloc(sizeof(MVMHashEntry));
-        MVM_HASH_BIND_FREE(tc, dest_body->hash_head, MVM_HASH_KEY(current), new_entry, {
-            MVM_free(new_entry);
-        });
+    MVM_str_hash_build(tc, dest_hashtable, sizeof(MVMHashEntry),
+        MVM_str_hash_count(tc, src_hashtable));
+    iterator = MVM_str_hash_first(tc, src_hashtable);
+    while (!MVM_str_hash_at_end(tc, src_hashtable, iterator)) {
+        MVMHashEntry *current   = MVM_str_hash_current(tc, src_hashtable, iterator);
+        MVMHashEntry *new_entry = MVM_str_hash_lvalue_fetch_nocheck(tc, dest_hashtable,
+            MVM_HASH_KEY(current));
         MVM_ASSIGN_REF(tc, &(dest_root->header), new_entry->value, current->value);
-    });
+        MVM_gc_write_barrier(tc, &(dest_root->header), &(MVM_HASH_KEY(current)->common.header));
+        iterator = MVM_str_hash_next(tc, src_hashtable, iterator);
+    }
 }
 
 /* Adds held objects to the GC worklist. */
 static void gc_mark(MVMThreadContext *tc, MVMSTable *st, void *data, MVMGCWorklist *worklist) {
     MVMHashAttrStoreBody *body = (MVMHashAttrStoreBody *)data;
-    MVMHashEntry *current;
+    MVMStrHashTable *hashtable = &(body->hashtable);
+    MVMStrHashIterator iterator = MVM_str_hash_first(tc, hashtable);
 
-    HASH_ITER_FAST(tc, hash_handle, body->hash_head, current, {
+    while (!MVM_str_hash_at_end(tc, hashtable, iterator)) {
+        MVMHashEntry *current = MVM_str_hash_current(tc, hashtable, iterator);
         MVM_gc_worklist_add(tc, worklist, &current->hash_handle.key);
         MVM_gc_worklist_add(tc, worklist, &current->value);
-    });
+        iterator = MVM_str_hash_next(tc, hashtable, iterator);
+    }
 }
 
 /* Called by the VM in order to free memory associated with this object. */
 static void gc_free(MVMThreadContext *tc, MVMObject *obj) {
     MVMHashAttrStore *h = (MVMHashAttrStore *)obj;
-    MVM_HASH_DESTROY(tc, hash_handle, MVMHashEntry, h->body.hash_head);
+    MVM_str_hash_demolish(tc, &(h->body.hashtable));
 }
 
 static void get_attribute(MVMThreadContext *tc, MVMSTable *st, MVMObject *root,
@@ -55,8 +64,7 @@ static void get_attribute(MVMThreadContext *tc, MVMSTable *st, MVMObject *root,
         MVMRegister *result_reg, MVMuint16 kind) {
     MVMHashAttrStoreBody *body = (MVMHashAttrStoreBody *)data;
     if (kind == MVM_reg_obj) {
-        MVMHashEntry *entry;
-        MVM_HASH_GET(tc, body->hash_head, name, entry);
+        MVMHashEntry *entry = MVM_str_hash_fetch(tc, &(body->hashtable), name);
         result_reg->o = entry != NULL ? entry->value : tc->instance->VMNull;
     }
     else {
@@ -70,19 +78,13 @@ static void bind_attribute(MVMThreadContext *tc, MVMSTable *st, MVMObject *root,
         MVMRegister value_reg, MVMuint16 kind) {
     MVMHashAttrStoreBody *body = (MVMHashAttrStoreBody *)data;
     if (kind == MVM_reg_obj) {
+        MVMStrHashTable *hashtable = &(body->hashtable);
         MVMHashEntry *entry;
-        MVM_HASH_GET(tc, body->hash_head, name, entry);
-        if (!entry) {
-            entry = MVM_malloc(sizeof(MVMHashEntry));
-            MVM_HASH_BIND_FREE(tc, body->hash_head, name, entry, {
-                MVM_free(entry);
-            });
-            MVM_ASSIGN_REF(tc, &(root->header), entry->value, value_reg.o);
-            MVM_gc_write_barrier(tc, &(root->header), &(name->common.header));
-        }
-        else {
-            MVM_ASSIGN_REF(tc, &(root->header), entry->value, value_reg.o);
-        }
+        if (!MVM_str_hash_entry_size(tc, hashtable))
+            MVM_str_hash_build(tc, hashtable, sizeof(MVMHashEntry), 0);
+        entry = MVM_str_hash_lvalue_fetch(tc, hashtable, name);
+        MVM_ASSIGN_REF(tc, &(root->header), entry->value, value_reg.o);
+        MVM_gc_write_barrier(tc, &(root->header), &(name->common.header));
     }
     else {
         MVM_exception_throw_adhoc(tc,
@@ -92,9 +94,7 @@ static void bind_attribute(MVMThreadContext *tc, MVMSTable *st, MVMObject *root,
 
 static MVMint64 is_attribute_initialized(MVMThreadContext *tc, MVMSTable *st, void *data, MVMObject *class_handle, MVMString *name, MVMint64 hint) {
     MVMHashAttrStoreBody *body = (MVMHashAttrStoreBody *)data;
-    MVMHashEntry *entry;
-    MVM_HASH_GET(tc, body->hash_head, name, entry);
-    return entry != NULL;
+    return MVM_str_hash_fetch(tc, &(body->hashtable), name) != NULL;
 }
 
 static MVMint64 hint_for(MVMThreadContext *tc, MVMSTable *st, MVMObject *class_handle, MVMString *name) {
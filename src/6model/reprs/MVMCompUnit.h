@@ -145,6 +145,10 @@ struct MVMCompUnitBody {
 
     /* Was a frame in this compilation unit invoked yet? */
     MVMuint8 invoked;
+
+    /* Hash of the bytecode, identifying the compilation unit in the
+     * specialization cache; zero if the cache is not in use. */
+    MVMuint64 spesh_cache_hash;
 };
 struct MVMCompUnit {
     MVMObject common;
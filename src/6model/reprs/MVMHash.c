@@ -3,12 +3,6 @@
 /* This representation's function pointer table. */
 static const MVMREPROps MVMHash_this_repr;
 
-MVM_STATIC_INLINE MVMString * get_string_key(MVMThreadContext *tc, MVMObject *key) {
-    if (MVM_UNLIKELY(!key || REPR(key)->ID != MVM_REPR_ID_MVMString || !IS_CONCRETE(key)))
-        MVM_exception_throw_adhoc(tc, "MVMHash representation requires MVMString keys");
-    return (MVMString *)key;
-}
-
 /* Creates a new type object of this representation, and associates it with
  * the given HOW. */
 static MVMObject * type_object_for(MVMThreadContext *tc, MVMObject *HOW) {
@@ -27,59 +21,63 @@ static MVMObject * type_object_for(MVMThreadContext *tc, MVMObject *HOW) {
 static void copy_to(MVMThreadContext *tc, MVMSTable *st, void *src, MVMObject *dest_root, void *dest) {
     MVMHashBody *src_body  = (MVMHashBody *)src;
     MVMHashBody *dest_body = (MVMHashBody *)dest;
-    MVMHashEntry *current  = NULL;
+    MVMStrHashTable *src_hashtable  = &(src_body->hashtable);
+    MVMStrHashTable *dest_hashtable = &(dest_body->hashtable);
+    MVMStrHashIterator iterator;
 
-    /* NOTE: if we really wanted to, we could avoid rehashing... */
-    HASH_ITER_FAST(tc, hash_handle, src_body->hash_head, current, {
-        MVMHashEntry *new_entry = MVM_fixed_size_alloc(tc, tc->instance->fsa,
-            sizeof(MVMHashEntry));
-        MVMString *key = MVM_HASH_KEY(current);
+    /* NOTE: if we really wanted to, we could copy the entries and index
+     * wholesale rather than rehashing... */
+    MVM_str_hash_build(tc, dest_hashtable, sizeof(MVMHashEntry),
+        MVM_str_hash_count(tc, src_hashtable));
+    iterator = MVM_str_hash_first(tc, src_hashtable);
+    while (!MVM_str_hash_at_end(tc, src_hashtable, iterator)) {
+        MVMHashEntry *current   = MVM_str_hash_current(tc, src_hashtable, iterator);
+        MVMString *key          = current->hash_handle.key;
+        MVMHashEntry *new_entry = MVM_str_hash_lvalue_fetch_nocheck(tc, dest_hashtable, key);
         MVM_ASSIGN_REF(tc, &(dest_root->header), new_entry->value, current->value);
-        MVM_HASH_BIND_FREE(tc, dest_body->hash_head, key, new_entry, {
-            MVM_fixed_size_free(tc, tc->instance->fsa, sizeof(MVMHashEntry), new_entry);
-        });
         MVM_gc_write_barrier(tc, &(dest_root->header), &(key->common.header));
-    });
+        iterator = MVM_str_hash_next(tc, src_hashtable, iterator);
+    }
 }
 
 /* Adds held objects to the GC worklist. */
 static void MVMHash_gc_mark(MVMThreadContext *tc, MVMSTable *st, void *data, MVMGCWorklist *worklist) {
-    MVMHashBody     *body = (MVMHashBody *)data;
-    MVMHashEntry *current = NULL;
-    MVM_gc_worklist_presize_for(tc, worklist, 2 * HASH_CNT(hash_handle, body->hash_head));
+    MVMHashBody *body = (MVMHashBody *)data;
+    MVMStrHashTable *hashtable = &(body->hashtable);
+    MVMuint32 pos;
+
+    /* Walk the entries directly; deleted ones have a NULL key. */
+    MVM_gc_worklist_presize_for(tc, worklist, 2 * MVM_str_hash_count(tc, hashtable));
     if (worklist->include_gen2) {
-        HASH_ITER_FAST(tc, hash_handle, body->hash_head, current, {
-            MVM_gc_worklist_add_include_gen2_nocheck(tc, worklist, &current->hash_handle.key);
-            MVM_gc_worklist_add_include_gen2_nocheck(tc, worklist, &current->value);
-        });
+        for (pos = 0; pos < hashtable->num_entries; pos++) {
+            MVMHashEntry *current = MVM_str_hash_entry_at(hashtable, pos);
+            if (current->hash_handle.key) {
+                MVM_gc_worklist_add_include_gen2_nocheck(tc, worklist, &current->hash_handle.key);
+                MVM_gc_worklist_add_include_gen2_nocheck(tc, worklist, &current->value);
+            }
+        }
     }
     else {
-        HASH_ITER_FAST(tc, hash_handle, body->hash_head, current, {
-            MVM_gc_worklist_add_no_include_gen2_nocheck(tc, worklist, &current->hash_handle.key);
-            MVM_gc_worklist_add_object_no_include_gen2_nocheck(tc, worklist, &current->value);
-        });
+        for (pos = 0; pos < hashtable->num_entries; pos++) {
+            MVMHashEntry *current = MVM_str_hash_entry_at(hashtable, pos);
+            if (current->hash_handle.key) {
+                MVM_gc_worklist_add_no_include_gen2_nocheck(tc, worklist, &current->hash_handle.key);
+                MVM_gc_worklist_add_object_no_include_gen2_nocheck(tc, worklist, &current->value);
+            }
+        }
     }
 }
 
 /* Called by the VM in order to free memory associated with this object. */
 static void gc_free(MVMThreadContext *tc, MVMObject *obj) {
     MVMHash *h = (MVMHash *)obj;
-    MVMHashEntry *current = NULL, *tmp = NULL;
-    HASH_ITER_FAST(tc, hash_handle, h->body.hash_head, current, {
-        if (current != h->body.hash_head)
-            MVM_fixed_size_free(tc, tc->instance->fsa, sizeof(MVMHashEntry), current);
-    });
-    tmp = h->body.hash_head;
-    HASH_CLEAR(tc, hash_handle, h->body.hash_head);
-    if (tmp)
-        MVM_fixed_size_free(tc, tc->instance->fsa, sizeof(MVMHashEntry), tmp);
+    MVM_str_hash_demolish(tc, &(h->body.hashtable));
 }
 
 static void at_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMObject *key_obj, MVMRegister *result, MVMuint16 kind) {
     MVMHashBody   *body = (MVMHashBody *)data;
-    MVMHashEntry *entry = NULL;
-    /* key_obj checked in MVM_HASH_GET */
-    MVM_HASH_GET(tc, body->hash_head, (MVMString *)key_obj, entry);
+    /* key_obj checked in MVM_str_hash_fetch */
+    MVMHashEntry *entry = MVM_str_hash_fetch(tc, &(body->hashtable), (MVMString *)key_obj);
     if (MVM_LIKELY(kind == MVM_reg_obj))
         result->o = entry != NULL ? entry->value : tc->instance->VMNull;
     else
@@ -91,54 +89,40 @@ void MVMHash_at_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *
 }
 
 static void bind_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMObject *key_obj, MVMRegister value, MVMuint16 kind) {
-    MVMHashBody   *body = (MVMHashBody *)data;
-    MVMHashEntry *entry = NULL;
-
-    MVMString *key = (MVMString *)key_obj; /* Checked in MVM_HASH_GET. */
+    MVMHashBody       *body = (MVMHashBody *)data;
+    MVMStrHashTable *hashtable = &(body->hashtable);
+    MVMString *key = (MVMString *)key_obj; /* Checked in MVM_str_hash_lvalue_fetch. */
+    MVMHashEntry *entry;
     if (MVM_UNLIKELY(kind != MVM_reg_obj))
         MVM_exception_throw_adhoc(tc,
             "MVMHash representation does not support native type storage");
 
-    /* first check whether we can must update the old entry. */
-    MVM_HASH_GET(tc, body->hash_head, key, entry);
-    if (!entry) {
-        entry = MVM_fixed_size_alloc(tc, tc->instance->fsa,
-            sizeof(MVMHashEntry));
-        MVM_ASSIGN_REF(tc, &(root->header), entry->value, value.o);
-        MVM_HASH_BIND_FREE(tc, body->hash_head, key, entry, {
-            MVM_fixed_size_free(tc, tc->instance->fsa, sizeof(MVMHashEntry), entry);
-        });
-        MVM_gc_write_barrier(tc, &(root->header), &(key->common.header));
-    }
-    else {
-        MVM_ASSIGN_REF(tc, &(root->header), entry->value, value.o);
-    }
+    /* The table is built lazily, since many hashes are never bound to. */
+    if (MVM_UNLIKELY(!MVM_str_hash_entry_size(tc, hashtable)))
+        MVM_str_hash_build(tc, hashtable, sizeof(MVMHashEntry), 0);
+
+    /* Finds the existing entry, or makes a new one with the key in place. */
+    entry = MVM_str_hash_lvalue_fetch(tc, hashtable, key);
+    MVM_ASSIGN_REF(tc, &(root->header), entry->value, value.o);
+    MVM_gc_write_barrier(tc, &(root->header), &(key->common.header));
 }
 void MVMHash_bind_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMObject *key_obj, MVMRegister value, MVMuint16 kind) {
     bind_key(tc, st, root, data, key_obj, value, kind);
 }
 static MVMuint64 elems(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data) {
     MVMHashBody *body = (MVMHashBody *)data;
-    return HASH_CNT(hash_handle, body->hash_head);
+    return MVM_str_hash_count(tc, &(body->hashtable));
 }
 
 static MVMint64 exists_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMObject *key_obj) {
-    MVMHashBody   *body = (MVMHashBody *)data;
-    MVMHashEntry *entry = NULL;
-    /* key_obj checked in MVM_HASH_GET */
-    MVM_HASH_GET(tc, body->hash_head, (MVMString *)key_obj, entry);
-    return entry != NULL;
+    MVMHashBody *body = (MVMHashBody *)data;
+    /* key_obj checked in MVM_str_hash_fetch */
+    return MVM_str_hash_fetch(tc, &(body->hashtable), (MVMString *)key_obj) != NULL;
 }
 
 static void delete_key(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMObject *key_obj) {
     MVMHashBody *body = (MVMHashBody *)data;
-    MVMString *key = get_string_key(tc, key_obj);
-    MVMHashEntry *old_entry = NULL, *prev_entry = NULL;
-    HASH_FIND_VM_STR_AND_DELETE(tc, hash_handle, body->hash_head, key, old_entry, prev_entry);
-    if (old_entry) {
-        MVM_fixed_size_free(tc, tc->instance->fsa,
-            sizeof(MVMHashEntry), old_entry);
-    }
+    MVM_str_hash_delete(tc, &(body->hashtable), (MVMString *)key_obj);
 }
 
 static MVMStorageSpec get_value_storage_spec(MVMThreadContext *tc, MVMSTable *st) {
@@ -174,17 +158,16 @@ static void compose(MVMThreadContext *tc, MVMSTable *st, MVMObject *info) {
 /* Deserialize the representation. */
 static void deserialize(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMSerializationReader *reader) {
     MVMHashBody *body = (MVMHashBody *)data;
+    MVMStrHashTable *hashtable = &(body->hashtable);
     MVMint64 elems = MVM_serialization_read_int(tc, reader);
     MVMint64 i;
+    MVM_str_hash_build(tc, hashtable, sizeof(MVMHashEntry), (MVMuint32)elems);
     for (i = 0; i < elems; i++) {
         MVMString *key = MVM_serialization_read_str(tc, reader);
         MVMObject *value = MVM_serialization_read_ref(tc, reader);
-        MVMHashEntry *entry = MVM_fixed_size_alloc(tc, tc->instance->fsa,
-            sizeof(MVMHashEntry));
+        MVMHashEntry *entry = MVM_str_hash_lvalue_fetch(tc, hashtable, key);
         MVM_ASSIGN_REF(tc, &(root->header), entry->value, value);
-        MVM_HASH_BIND_FREE(tc, body->hash_head, key, entry, {
-            MVM_fixed_size_free(tc, tc->instance->fsa, sizeof(MVMHashEntry), entry);
-        });
+        MVM_gc_write_barrier(tc, &(root->header), &(key->common.header));
     }
 }
 
@@ -195,21 +178,21 @@ static int cmp_strings(const void *s1, const void *s2) {
 }
 static void serialize(MVMThreadContext *tc, MVMSTable *st, void *data, MVMSerializationWriter *writer) {
     MVMHashBody *body = (MVMHashBody *)data;
-    MVMHashEntry *current = NULL;
-    MVMuint64 elems = HASH_CNT(hash_handle, body->hash_head);
+    MVMStrHashTable *hashtable = &(body->hashtable);
+    MVMuint64 elems = MVM_str_hash_count(tc, hashtable);
     MVMString **keys = MVM_malloc(sizeof(MVMString *) * elems);
     MVMuint64 i = 0;
+    MVMStrHashIterator iterator = MVM_str_hash_first(tc, hashtable);
     MVM_serialization_write_int(tc, writer, elems);
-    HASH_ITER_FAST(tc, hash_handle, body->hash_head, current, {
-        keys[i++] = MVM_HASH_KEY(current);
-    });
+    while (!MVM_str_hash_at_end(tc, hashtable, iterator)) {
+        MVMHashEntry *current = MVM_str_hash_current(tc, hashtable, iterator);
+        keys[i++] = current->hash_handle.key;
+        iterator = MVM_str_hash_next(tc, hashtable, iterator);
+    }
     cmp_tc = tc;
     qsort(keys, elems, sizeof(MVMString*), cmp_strings);
     for (i = 0; i < elems; i++) {
-        MVMHashEntry *entry;
-        MVM_HASH_GET_FREE(tc, body->hash_head, keys[i], entry, {
-            MVM_free(keys);
-        });
+        MVMHashEntry *entry = MVM_str_hash_fetch_nocheck(tc, hashtable, keys[i]);
         MVM_serialization_write_str(tc, writer, keys[i]);
         MVM_serialization_write_ref(tc, writer, entry->value);
     }
@@ -246,9 +229,12 @@ static void spesh(MVMThreadContext *tc, MVMSTable *st, MVMSpeshGraph *g, MVMSpes
 }
 
 static MVMuint64 unmanaged_size(MVMThreadContext *tc, MVMSTable *st, void *data) {
-    MVMHashBody *body = (MVMHashBody *)data;
-
-    return sizeof(MVMHashEntry) * HASH_CNT(hash_handle, body->hash_head);
+    MVMStrHashTable *hashtable = &(((MVMHashBody *)data)->hashtable);
+    MVMuint64 size = (MVMuint64)hashtable->alloc_entries * hashtable->entry_size;
+    if (hashtable->buckets)
+        size += ((MVMuint64)1 << hashtable->official_size_log2)
+            * (sizeof(MVMStrHashBucket) + 1);
+    return size;
 }
 
 /* Initializes the representation. */
@@ -1,16 +1,17 @@
 /* Representation used by VM-level hashes. */
 
 struct MVMHashEntry {
+    /* key object (must be first) */
+    MVMStrHashHandle hash_handle;
+
     /* value object */
     MVMObject *value;
-
-    /* the uthash hash handle inline struct, including the key. */
-    UT_hash_handle hash_handle;
 };
 
 struct MVMHashBody {
-    /* uthash updates this pointer directly. */
-    MVMHashEntry *hash_head;
+    /* Open addressing table; entries are MVMHashEntry, and are kept in
+     * insertion order. */
+    MVMStrHashTable hashtable;
 };
 struct MVMHash {
     MVMObject common;
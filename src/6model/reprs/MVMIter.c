@@ -104,15 +104,18 @@ static void shift(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *da
                 MVM_exception_throw_adhoc(tc, "Wrong register kind in iteration");
             }
             return;
-        case MVM_ITER_MODE_HASH:
-            body->hash_state.curr = body->hash_state.next;
-            if (!body->hash_state.curr)
+        case MVM_ITER_MODE_HASH: {
+            MVMStrHashTable *hashtable = &(((MVMHash *)target)->body.hashtable);
+            /* Entries may have been deleted since we last looked. */
+            body->hash_state.curr = MVM_str_hash_skip_deleted(tc, hashtable,
+                body->hash_state.next);
+            if (MVM_str_hash_at_end(tc, hashtable, body->hash_state.curr))
                 MVM_exception_throw_adhoc(tc, "Iteration past end of iterator");
-            body->hash_state.next = HASH_ITER_NEXT_ITEM(tc,
-                &(body->hash_state.next->hash_handle),
-                &(body->hash_state.bucket_state));
+            body->hash_state.next = body->hash_state.curr;
+            body->hash_state.next.pos++;
             value->o = root;
             return;
+        }
         default:
             MVM_exception_throw_adhoc(tc, "Unknown iteration mode");
     }
@@ -221,13 +224,9 @@ MVMObject * MVM_iter(MVMThreadContext *tc, MVMObject *target) {
             iterator = (MVMIter *)MVM_repr_alloc_init(tc,
                 MVM_hll_current(tc)->hash_iterator_type);
             iterator->body.mode = MVM_ITER_MODE_HASH;
-            iterator->body.hash_state.bucket_state = 0;
-            iterator->body.hash_state.curr         = NULL;
-            iterator->body.hash_state.next         = HASH_ITER_FIRST_ITEM(
-                ((MVMHash *)target)->body.hash_head
-                    ? ((MVMHash *)target)->body.hash_head->hash_handle.tbl
-                    : NULL,
-                &(iterator->body.hash_state.bucket_state));
+            iterator->body.hash_state.curr.pos = (MVMuint32)-1;
+            iterator->body.hash_state.next     = MVM_str_hash_first(tc,
+                &(((MVMHash *)target)->body.hashtable));
             MVM_ASSIGN_REF(tc, &(iterator->common.header), iterator->body.target, target);
         }
         else if (REPR(target)->ID == MVM_REPR_ID_MVMContext) {
@@ -252,20 +251,29 @@ MVMint64 MVM_iter_istrue(MVMThreadContext *tc, MVMIter *iter) {
             return iter->body.array_state.index + 1 < iter->body.array_state.limit ? 1 : 0;
             break;
         case MVM_ITER_MODE_HASH:
-            return iter->body.hash_state.next != NULL ? 1 : 0;
+            return MVM_iter_istrue_hash(tc, iter);
             break;
         default:
             MVM_exception_throw_adhoc(tc, "Invalid iteration mode used");
     }
 }
 
+MVMint64 MVM_iter_istrue_hash(MVMThreadContext *tc, MVMIter *iter) {
+    MVMStrHashTable *hashtable = &(((MVMHash *)iter->body.target)->body.hashtable);
+    return MVM_str_hash_at_end(tc, hashtable,
+        MVM_str_hash_skip_deleted(tc, hashtable, iter->body.hash_state.next)) ? 0 : 1;
+}
+
 MVMString * MVM_iterkey_s(MVMThreadContext *tc, MVMIter *iterator) {
+    MVMHashEntry *entry;
     if (REPR(iterator)->ID != MVM_REPR_ID_MVMIter
             || iterator->body.mode != MVM_ITER_MODE_HASH)
         MVM_exception_throw_adhoc(tc, "This is not a hash iterator, it's a %s (%s)", REPR(iterator)->name, MVM_6model_get_debug_name(tc, (MVMObject *)iterator));
-    if (!iterator->body.hash_state.curr)
-        MVM_exception_throw_adhoc(tc, "You have not advanced to the first item of the hash iterator, or have gone past the end");
-    return MVM_HASH_KEY(iterator->body.hash_state.curr);
+    entry = MVM_str_hash_current(tc, &(((MVMHash *)iterator->body.target)->body.hashtable),
+        iterator->body.hash_state.curr);
+    if (!entry)
+        MVM_exception_throw_adhoc(tc, "You have not advanced to the first item of the hash iterator, or have gone past the end, or the item was deleted");
+    return MVM_HASH_KEY(entry);
 }
 
 MVMObject * MVM_iterval(MVMThreadContext *tc, MVMIter *iterator) {
@@ -282,9 +290,12 @@ MVMObject * MVM_iterval(MVMThreadContext *tc, MVMIter *iterator) {
         REPR(target)->pos_funcs.at_pos(tc, STABLE(target), target, OBJECT_BODY(target), body->array_state.index, &result, MVM_reg_obj);
     }
     else if (iterator->body.mode == MVM_ITER_MODE_HASH) {
-        if (!iterator->body.hash_state.curr)
-            MVM_exception_throw_adhoc(tc, "You have not advanced to the first item of the hash iterator, or have gone past the end");
-        result.o = iterator->body.hash_state.curr->value;
+        MVMHashEntry *entry = MVM_str_hash_current(tc,
+            &(((MVMHash *)iterator->body.target)->body.hashtable),
+            iterator->body.hash_state.curr);
+        if (!entry)
+            MVM_exception_throw_adhoc(tc, "You have not advanced to the first item of the hash iterator, or have gone past the end, or the item was deleted");
+        result.o = entry->value;
         if (!result.o)
             result.o = tc->instance->VMNull;
     }
@@ -16,8 +16,9 @@ struct MVMIterBody {
     /* next hash item to give or next array index */
     union {
         struct {
-            MVMHashEntry *curr, *next;
-            unsigned      bucket_state;
+            /* Position of the current item (past the end before the first
+             * shift), and the position to start looking for the next. */
+            MVMStrHashIterator curr, next;
         } hash_state;
         struct {
             MVMint64 index;
@@ -35,5 +36,6 @@ const MVMREPROps * MVMIter_initialize(MVMThreadContext *tc);
 
 MVMObject * MVM_iter(MVMThreadContext *tc, MVMObject *target);
 MVMint64 MVM_iter_istrue(MVMThreadContext *tc, MVMIter *iter);
+MVMint64 MVM_iter_istrue_hash(MVMThreadContext *tc, MVMIter *iter);
 MVMString * MVM_iterkey_s(MVMThreadContext *tc, MVMIter *iterator);
 MVMObject * MVM_iterval(MVMThreadContext *tc, MVMIter *iterator);
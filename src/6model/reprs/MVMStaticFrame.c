@@ -52,31 +52,22 @@ static void copy_to(MVMThreadContext *tc, MVMSTable *st, void *src, MVMObject *d
     {
         MVMuint16 *local_types = MVM_malloc(sizeof(MVMuint16) * src_body->num_locals);
         MVMuint16 *lexical_types = MVM_malloc(sizeof(MVMuint16) * src_body->num_lexicals);
-        MVMLexicalRegistry **lexical_names_list = MVM_malloc(sizeof(MVMLexicalRegistry *) * src_body->num_lexicals);
+        MVMString **lexical_names_list = MVM_malloc(sizeof(MVMString *) * src_body->num_lexicals);
         memcpy(local_types, src_body->local_types, sizeof(MVMuint16) * src_body->num_locals);
         if (src_body->num_lexicals) {
+            MVMuint16 i;
             memcpy(lexical_types, src_body->lexical_types,
                 sizeof(MVMuint16) * src_body->num_lexicals);
-            memcpy(lexical_names_list, src_body->lexical_names_list,
-                sizeof(MVMLexicalRegistry *) * src_body->num_lexicals);
+            /* don't need to clone the strings */
+            for (i = 0; i < src_body->num_lexicals; i++)
+                MVM_ASSIGN_REF(tc, &(dest_root->header), lexical_names_list[i],
+                    src_body->lexical_names_list[i]);
         }
         dest_body->local_types = local_types;
         dest_body->lexical_types = lexical_types;
         dest_body->lexical_names_list = lexical_names_list;
-    }
-    {
-        MVMLexicalRegistry *current;
-
-        /* NOTE: if we really wanted to, we could avoid rehashing... */
-        HASH_ITER_FAST(tc, hash_handle, src_body->lexical_names, current, {
-            MVMLexicalRegistry *new_entry = MVM_malloc(sizeof(MVMLexicalRegistry));
-            MVM_HASH_BIND_FREE(tc, dest_body->lexical_names, current->key, new_entry, {
-                MVM_free(new_entry);
-            });
-            /* don't need to clone the string */
-            MVM_ASSIGN_REF(tc, &(dest_root->header), new_entry->key, current->key);
-            new_entry->value = current->value;
-        });
+        MVM_index_hash_build(tc, &dest_body->lexical_names, lexical_names_list,
+            src_body->num_lexicals);
     }
 
     /* Static environment needs to be copied, and any objects WB'd. */
@@ -119,7 +110,6 @@ static void copy_to(MVMThreadContext *tc, MVMSTable *st, void *src, MVMObject *d
 /* Adds held objects to the GC worklist. */
 static void gc_mark(MVMThreadContext *tc, MVMSTable *st, void *data, MVMGCWorklist *worklist) {
     MVMStaticFrameBody *body = (MVMStaticFrameBody *)data;
-    MVMLexicalRegistry *current;
     MVMStaticFrameDebugLocal *current_debug_local;
 
     /* mvmobjects */
@@ -133,11 +123,12 @@ static void gc_mark(MVMThreadContext *tc, MVMSTable *st, void *data, MVMGCWorkli
     if (!body->fully_deserialized)
         return;
 
-    /* lexical names hash keys */
-    HASH_ITER_FAST(tc, hash_handle, body->lexical_names, current, {
-        MVM_gc_worklist_add(tc, worklist, &current->hash_handle.key);
-        MVM_gc_worklist_add(tc, worklist, &current->key);
-    });
+    /* lexical names */
+    if (body->lexical_names_list) {
+        MVMuint16 i;
+        for (i = 0; i < body->num_lexicals; i++)
+            MVM_gc_worklist_add(tc, worklist, &body->lexical_names_list[i]);
+    }
 
     /* static env */
     if (body->static_env) {
@@ -168,7 +159,7 @@ static void gc_free(MVMThreadContext *tc, MVMObject *obj) {
         MVM_free(body->bytecode);
         body->bytecode = body->orig_bytecode;
     }
-
+    MVM_free(body->spesh_preload);
 
     /* If it's not fully deserialized, none of the following can apply. */
     if (!body->fully_deserialized)
@@ -180,7 +171,7 @@ static void gc_free(MVMThreadContext *tc, MVMObject *obj) {
     MVM_free(body->local_types);
     MVM_free(body->lexical_types);
     MVM_free(body->lexical_names_list);
-    MVM_HASH_DESTROY(tc, hash_handle, MVMLexicalRegistry, body->lexical_names);
+    MVM_index_hash_demolish(tc, &body->lexical_names);
 }
 
 static const MVMStorageSpec storage_spec = {
@@ -216,9 +207,11 @@ static MVMuint64 unmanaged_size(MVMThreadContext *tc, MVMSTable *st, void *data)
         if (body->bytecode != body->orig_bytecode)
             size += body->bytecode_size;
 
-        size += sizeof(MVMLexicalRegistry *) * body->num_lexicals;
+        size += sizeof(MVMString *) * body->num_lexicals;
 
-        size += sizeof(MVMLexicalRegistry) * body->num_lexicals;
+        if (body->lexical_names.buckets)
+            size += ((size_t)1 << body->lexical_names.official_size_log2)
+                * (sizeof(MVMIndexHashBucket) + 1);
 
         size += sizeof(MVMFrameHandler) * body->num_handlers;
 
@@ -245,7 +238,6 @@ static MVMuint64 unmanaged_size(MVMThreadContext *tc, MVMSTable *st, void *data)
 
 static void describe_refs(MVMThreadContext *tc, MVMHeapSnapshotState *ss, MVMSTable *st, void *data) {
     MVMStaticFrameBody *body = (MVMStaticFrameBody *)data;
-    MVMLexicalRegistry *current;
 
     static MVMuint64 cache_1 = 0;
     static MVMuint64 cache_2 = 0;
@@ -271,11 +263,13 @@ static void describe_refs(MVMThreadContext *tc, MVMHeapSnapshotState *ss, MVMSTa
     if (!body->fully_deserialized)
         return;
 
-    /* lexical names hash keys */
-    HASH_ITER_FAST(tc, hash_handle, body->lexical_names, current, {
-        MVM_profile_heap_add_collectable_rel_const_cstr_cached(tc, ss,
-            (MVMCollectable *)current->key, "Lexical name", &nonstatic_cache_1);
-    });
+    /* lexical names */
+    if (body->lexical_names_list) {
+        MVMuint16 i;
+        for (i = 0; i < body->num_lexicals; i++)
+            MVM_profile_heap_add_collectable_rel_const_cstr_cached(tc, ss,
+                (MVMCollectable *)body->lexical_names_list[i], "Lexical name", &nonstatic_cache_1);
+    }
 
     /* static env */
     if (body->static_env) {
@@ -13,9 +13,10 @@ struct MVMStaticFrameBody {
     /* The list of lexical types. */
     MVMuint16 *lexical_types;
 
-    /* Lexicals name map. */
-    MVMLexicalRegistry *lexical_names;
-    MVMLexicalRegistry **lexical_names_list;
+    /* The list of lexical names, and a map from names to their index in
+     * that list. */
+    MVMString **lexical_names_list;
+    MVMIndexHashTable lexical_names;
 
     /* Defaults for lexicals upon new frame creation. */
     MVMRegister *static_env;
@@ -37,6 +38,19 @@ struct MVMStaticFrameBody {
 
     /* Does the frame contain specializable instructions? */
     MVMuint8 specializable;
+
+    /* Was the frame hot in this or an earlier run, according to the
+     * specialization cache? */
+    MVMuint8 spesh_cache_hot;
+
+    /* The index of the frame in its compilation unit, if it was loaded from
+     * bytecode; used to name it in the specialization cache. */
+    MVMuint32 cu_frame_idx;
+
+    /* Statistics recorded for the frame in an earlier run, if any, in the
+     * text form they were dumped in; used to seed its statistics when it is
+     * first logged. */
+    char *spesh_preload;
     /* Zero if the frame was never invoked. Above zero is the instrumentation
      * level the VM was atlast time the frame was invoked. See MVMInstance for
      * the VM instance wide field for this. */
@@ -17,6 +17,11 @@ static MVMObject * type_object_for(MVMThreadContext *tc, MVMObject *HOW) {
     return st->WHAT;
 }
 
+/* Gets the string that a body belongs to. */
+static MVMString * body_string(void *data) {
+    return (MVMString *)((char *)data - offsetof(MVMString, body));
+}
+
 /* Copies the body of one object to another. */
 static void copy_to(MVMThreadContext *tc, MVMSTable *st, void *src, MVMObject *dest_root, void *dest) {
     MVMStringBody *src_body     = (MVMStringBody *)src;
@@ -25,6 +30,8 @@ static void copy_to(MVMThreadContext *tc, MVMSTable *st, void *src, MVMObject *d
     dest_body->num_strands      = src_body->num_strands;
     dest_body->num_graphs       = src_body->num_graphs;
     dest_body->cached_hash_code = src_body->cached_hash_code;
+    /* A view's graphemes are copied like any others, so the copy is never a
+     * view itself. */
     switch (dest_body->storage_type) {
         case MVM_STRING_GRAPHEME_32:
             if (dest_body->num_graphs) {
@@ -60,12 +67,16 @@ static void gc_mark(MVMThreadContext *tc, MVMSTable *st, void *data, MVMGCWorkli
         for (i = 0; i < body->num_strands; i++)
             MVM_gc_worklist_add(tc, worklist, &(strands[i].blob_string));
     }
+    else if (MVM_STRING_IS_VIEW(body_string(data))) {
+        MVM_gc_worklist_add(tc, worklist, &(((MVMStringView *)body_string(data))->view_of));
+    }
 }
 
 /* Called by the VM in order to free memory associated with this object. */
 static void gc_free(MVMThreadContext *tc, MVMObject *obj) {
     MVMString *str = (MVMString *)obj;
-    MVM_free(str->body.storage.any);
+    if (!MVM_STRING_IS_VIEW(str))
+        MVM_free(str->body.storage.any);
     str->body.num_graphs = str->body.num_strands = 0;
 }
 
@@ -91,6 +102,8 @@ static void compose(MVMThreadContext *tc, MVMSTable *st, MVMObject *info) {
 /* Calculates the non-GC-managed memory we hold on to. */
 static MVMuint64 unmanaged_size(MVMThreadContext *tc, MVMSTable *st, void *data) {
     MVMStringBody *body = (MVMStringBody *)data;
+    if (MVM_STRING_IS_VIEW(body_string(data)))
+        return 0;
     switch (body->storage_type) {
         case MVM_STRING_GRAPHEME_32:
             return sizeof(MVMGrapheme32) * body->num_graphs;
@@ -101,6 +114,22 @@ static MVMuint64 unmanaged_size(MVMThreadContext *tc, MVMSTable *st, void *data)
     }
 }
 
+static void describe_refs(MVMThreadContext *tc, MVMHeapSnapshotState *ss, MVMSTable *st, void *data) {
+    MVMStringBody *body = (MVMStringBody *)data;
+    if (body->storage_type == MVM_STRING_STRAND) {
+        MVMStringStrand *strands = body->storage.strands;
+        MVMuint64 cache = 0;
+        MVMuint16 i;
+        for (i = 0; i < body->num_strands; i++)
+            MVM_profile_heap_add_collectable_rel_const_cstr_cached(tc, ss,
+                (MVMCollectable *)strands[i].blob_string, "Strand", &cache);
+    }
+    else if (MVM_STRING_IS_VIEW(body_string(data))) {
+        MVM_profile_heap_add_collectable_rel_const_cstr(tc, ss,
+            (MVMCollectable *)((MVMStringView *)body_string(data))->view_of, "View of");
+    }
+}
+
 /* Initializes the representation. */
 const MVMREPROps * MVMString_initialize(MVMThreadContext *tc) {
     return &MVMString_this_repr;
@@ -133,5 +162,5 @@ static const MVMREPROps MVMString_this_repr = {
     "MVMString", /* name */
     MVM_REPR_ID_MVMString,
     unmanaged_size,
-    NULL, /* describe_refs */
+    describe_refs,
 };
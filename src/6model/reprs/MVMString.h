@@ -8,6 +8,10 @@
  *     draw out a distinction with the ASCII range buffer because we can do
  *     some I/O simplifications when we know all is in the ASCII range).
  *
+ * An 8-bit buffer of ASCII codepoints may also be a view of an immutable byte
+ * blob belonging to some other object, rather than a copy of it; see
+ * MVMStringView.
+ *
  * A buffer of strands represents a string made up of other non-strand
  * strings. That is, there's no recursive strands. This simplifies the
  * process of iteration enormously. A strand may refer to just part of
@@ -69,5 +73,17 @@ struct MVMString {
     MVMStringBody body;
 };
 
+/* A string whose graphemes are not its own but a view of an immutable byte
+ * blob that another object holds (such as the bytecode of a compilation
+ * unit, or a private copy of a file read by map_fhb), along with that object. We keep it alive, and don't free the memory
+ * when we are freed. Views always have MVM_STRING_GRAPHEME_ASCII storage.
+ * Only views are allocated with room for view_of, so we can tell them apart
+ * by their size, and other strings don't pay for it. */
+struct MVMStringView {
+    MVMString  str;
+    MVMObject *view_of;
+};
+#define MVM_STRING_IS_VIEW(s) ((s)->common.header.size == sizeof(MVMStringView))
+
 /* Function for REPR setup. */
 const MVMREPROps * MVMString_initialize(MVMThreadContext *tc);
@@ -34,12 +34,10 @@ static MVMint64 try_get_slot(MVMThreadContext *tc, MVMP6opaqueREPRData *repr_dat
         MVMP6opaqueNameMap *cur_map_entry = repr_data->name_to_index_mapping;
         while (cur_map_entry->class_key != NULL) {
             if (cur_map_entry->class_key == class_key) {
-                MVMuint16 i;
-                for (i = 0; i < cur_map_entry->num_attrs; i++) {
-                    if (MVM_string_equal(tc, cur_map_entry->names[i], name)) {
-                        return cur_map_entry->slots[i];
-                    }
-                }
+                MVMuint32 i = MVM_index_hash_fetch(tc, &cur_map_entry->name_hash,
+                    cur_map_entry->names, name);
+                if (i != MVM_INDEX_HASH_NOT_FOUND)
+                    return cur_map_entry->slots[i];
             }
             cur_map_entry++;
         }
@@ -47,6 +45,20 @@ static MVMint64 try_get_slot(MVMThreadContext *tc, MVMP6opaqueREPRData *repr_dat
     return -1;
 }
 
+/* Frees the name to slot mappings. */
+static void free_name_maps(MVMThreadContext *tc, MVMP6opaqueREPRData *repr_data) {
+    if (repr_data->name_to_index_mapping) {
+        MVMP6opaqueNameMap *cur_map_entry = repr_data->name_to_index_mapping;
+        while (cur_map_entry->class_key != NULL) {
+            MVM_free(cur_map_entry->names);
+            MVM_free(cur_map_entry->slots);
+            MVM_index_hash_demolish(tc, &cur_map_entry->name_hash);
+            cur_map_entry++;
+        }
+        MVM_free(repr_data->name_to_index_mapping);
+    }
+}
+
 /* Creates a new type object of this representation, and associates it with
  * the given HOW. */
 static MVMObject * type_object_for(MVMThreadContext *tc, MVMObject *HOW) {
@@ -187,15 +199,7 @@ static void gc_free_repr_data(MVMThreadContext *tc, MVMSTable *st) {
     if (repr_data == NULL)
         return;
 
-    if (repr_data->name_to_index_mapping) {
-        MVMP6opaqueNameMap *cur_map_entry = repr_data->name_to_index_mapping;
-        while (cur_map_entry->class_key != NULL) {
-            MVM_free(cur_map_entry->names);
-            MVM_free(cur_map_entry->slots);
-            cur_map_entry++;
-        }
-        MVM_free(repr_data->name_to_index_mapping);
-    }
+    free_name_maps(tc, repr_data);
 
     MVM_free(repr_data->attribute_offsets);
     MVM_free(repr_data->flattened_stables);
@@ -210,16 +214,8 @@ static void gc_free_repr_data(MVMThreadContext *tc, MVMSTable *st) {
 }
 
 /* Frees the representation data.*/
-static void free_repr_data(MVMP6opaqueREPRData *repr_data) {
-    if (repr_data->name_to_index_mapping) {
-        MVMP6opaqueNameMap *cur_map_entry = repr_data->name_to_index_mapping;
-        while (cur_map_entry->class_key != NULL) {
-            MVM_free(cur_map_entry->names);
-            MVM_free(cur_map_entry->slots);
-            cur_map_entry++;
-        }
-        MVM_free(repr_data->name_to_index_mapping);
-    }
+static void free_repr_data(MVMThreadContext *tc, MVMP6opaqueREPRData *repr_data) {
+    free_name_maps(tc, repr_data);
 
     MVM_free(repr_data->attribute_offsets);
     MVM_free(repr_data->flattened_stables);
@@ -790,7 +786,7 @@ static void compose(MVMThreadContext *tc, MVMSTable *st, MVMObject *info_hash) {
                     MVM_free_null(name_map->names);
                     MVM_free_null(name_map->slots);
                 }
-                free_repr_data(repr_data);
+                free_repr_data(tc, repr_data);
                 MVM_exception_throw_adhoc(tc, "P6opaque: %s missing attribute name for attribute %"PRId64, MVM_6model_get_stable_debug_name(tc, st), i);
             }
 
@@ -843,7 +839,7 @@ static void compose(MVMThreadContext *tc, MVMSTable *st, MVMObject *info_hash) {
                                         MVM_free_null(name_map->names);
                                         MVM_free_null(name_map->slots);
                                     }
-                                    free_repr_data(repr_data);
+                                    free_repr_data(tc, repr_data);
                                     MVM_exception_throw_adhoc(tc,
                                         "While composing %s: Duplicate box_target for native int: attributes %d and %"PRId64, MVM_6model_get_stable_debug_name(tc, st), repr_data->unbox_int_slot, i);
                                 }
@@ -855,7 +851,7 @@ static void compose(MVMThreadContext *tc, MVMSTable *st, MVMObject *info_hash) {
                                         MVM_free_null(name_map->names);
                                         MVM_free_null(name_map->slots);
                                     }
-                                    free_repr_data(repr_data);
+                                    free_repr_data(tc, repr_data);
                                     MVM_exception_throw_adhoc(tc,
                                         "While composing %s: Duplicate box_target for native num: attributes %d and %"PRId64, MVM_6model_get_stable_debug_name(tc, st), repr_data->unbox_num_slot, i);
                                 }
@@ -867,7 +863,7 @@ static void compose(MVMThreadContext *tc, MVMSTable *st, MVMObject *info_hash) {
                                         MVM_free_null(name_map->names);
                                         MVM_free_null(name_map->slots);
                                     }
-                                    free_repr_data(repr_data);
+                                    free_repr_data(tc, repr_data);
                                     MVM_exception_throw_adhoc(tc,
                                         "While composing %s: Duplicate box_target for native str: attributes %d and %"PRId64, MVM_6model_get_stable_debug_name(tc, st), repr_data->unbox_str_slot, i);
                                 }
@@ -910,7 +906,7 @@ static void compose(MVMThreadContext *tc, MVMSTable *st, MVMObject *info_hash) {
                         MVM_free_null(name_map->names);
                         MVM_free_null(name_map->slots);
                     }
-                    free_repr_data(repr_data);
+                    free_repr_data(tc, repr_data);
                     MVM_exception_throw_adhoc(tc,
                         "While composing %s: Duplicate positional delegate attributes: %d and %"PRId64"", MVM_6model_get_stable_debug_name(tc, st), repr_data->pos_del_slot, cur_slot);
                 }
@@ -921,7 +917,7 @@ static void compose(MVMThreadContext *tc, MVMSTable *st, MVMObject *info_hash) {
                         MVM_free_null(name_map->names);
                         MVM_free_null(name_map->slots);
                     }
-                    free_repr_data(repr_data);
+                    free_repr_data(tc, repr_data);
                     MVM_exception_throw_adhoc(tc,
                         "While composing %s: Positional delegate attribute must be a reference type", MVM_6model_get_stable_debug_name(tc, st));
                 }
@@ -932,7 +928,7 @@ static void compose(MVMThreadContext *tc, MVMSTable *st, MVMObject *info_hash) {
                         MVM_free_null(name_map->names);
                         MVM_free_null(name_map->slots);
                     }
-                    free_repr_data(repr_data);
+                    free_repr_data(tc, repr_data);
                     MVM_exception_throw_adhoc(tc,
                         "While composing %s: Duplicate associative delegate attributes: %d and %"PRId64, MVM_6model_get_stable_debug_name(tc, st), repr_data->pos_del_slot, cur_slot);
                 }
@@ -943,7 +939,7 @@ static void compose(MVMThreadContext *tc, MVMSTable *st, MVMObject *info_hash) {
                         MVM_free_null(name_map->names);
                         MVM_free_null(name_map->slots);
                     }
-                    free_repr_data(repr_data);
+                    free_repr_data(tc, repr_data);
                     MVM_exception_throw_adhoc(tc,
                         "While composing %s: Associative delegate attribute must be a reference type", MVM_6model_get_stable_debug_name(tc, st));
                 }
@@ -960,6 +956,9 @@ static void compose(MVMThreadContext *tc, MVMSTable *st, MVMObject *info_hash) {
             cur_slot++;
         }
 
+        /* The names for this class are final now, so build their index. */
+        MVM_index_hash_build(tc, &name_map->name_hash, name_map->names, num_attrs);
+
         /* Increment name map type index. */
         cur_type++;
     }
@@ -1122,13 +1121,13 @@ static void deserialize_repr_data(MVMThreadContext *tc, MVMSTable *st, MVMSerial
             MVMuint16 repr_id = MVM_serialization_read_int(tc, reader);
             MVMuint16 slot = MVM_serialization_read_int(tc, reader);
             if (slot > repr_data->num_attributes) {
-                free_repr_data(repr_data);
+                free_repr_data(tc, repr_data);
                 MVM_exception_throw_adhoc(tc, "Serialization error: P6opaque's unbox slot out of range (slot %d > %d attributes).", slot, repr_data->num_attributes);
             }
             if (repr_id < MVM_REPR_MAX_COUNT)
                 repr_data->unbox_slots[repr_id] = slot;
             else {
-                free_repr_data(repr_data);
+                free_repr_data(tc, repr_data);
                 MVM_exception_throw_adhoc(tc, "Serialization error: P6opaque's unbox slot repr id out of range.");
             }
         }
@@ -1137,7 +1136,7 @@ static void deserialize_repr_data(MVMThreadContext *tc, MVMSTable *st, MVMSerial
     }
 
     num_classes = (MVMuint16)MVM_serialization_read_int(tc, reader);
-    repr_data->name_to_index_mapping = (MVMP6opaqueNameMap *)MVM_malloc((num_classes + 1) * sizeof(MVMP6opaqueNameMap));
+    repr_data->name_to_index_mapping = (MVMP6opaqueNameMap *)MVM_calloc(num_classes + 1, sizeof(MVMP6opaqueNameMap));
     for (i = 0; i < num_classes; i++) {
         MVMint32 num_attrs = 0;
 
@@ -1155,6 +1154,8 @@ static void deserialize_repr_data(MVMThreadContext *tc, MVMSTable *st, MVMSerial
         }
 
         repr_data->name_to_index_mapping[i].num_attrs = num_attrs;
+        MVM_index_hash_build(tc, &repr_data->name_to_index_mapping[i].name_hash,
+            repr_data->name_to_index_mapping[i].names, num_attrs);
     }
 
     /* set the last one to be NULL */
@@ -1200,7 +1201,7 @@ static void deserialize_repr_data(MVMThreadContext *tc, MVMSTable *st, MVMSerial
                 repr_data->gc_cleanup_slots[cur_gc_cleanup_slot++] = i;
 
             if (spec->align == 0) {
-                free_repr_data(repr_data);
+                free_repr_data(tc, repr_data);
                 MVM_exception_throw_adhoc(tc, "Serialization error: Storage Spec of P6opaque must not have align set to 0.");
             }
 
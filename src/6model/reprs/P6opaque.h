@@ -17,14 +17,15 @@ struct MVMP6opaque {
 };
 
 /* This is used in the name to slot mapping. Indicates the class key that
- * we have the mappings for, followed by arrays of names and slots. (Yeah,
- * could use a hash, but much code will resolve these statically to the
- * slots). */
+ * we have the mappings for, followed by arrays of names and slots, and an
+ * index over the names for the lookups that can't be resolved statically
+ * to a slot. */
 struct MVMP6opaqueNameMap {
-    MVMObject  *class_key;
-    MVMString **names;
-    MVMuint16  *slots;
-    MVMuint32   num_attrs;
+    MVMObject         *class_key;
+    MVMString        **names;
+    MVMuint16         *slots;
+    MVMuint32          num_attrs;
+    MVMIndexHashTable  name_hash;
 };
 
 /* The P6opaque REPR data has the slot mapping, allocation size and
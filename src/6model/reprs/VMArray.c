@@ -1,5 +1,6 @@
 #include "moar.h"
 #include "limits.h"
+#include "platform/mmap.h"
 
 /* This representation's function pointer table. */
 static const MVMREPROps VMArray_this_repr;
@@ -18,6 +19,17 @@ static void exit_single_user(MVMThreadContext *tc, MVMArrayBody *arr) {
 #endif
 }
 
+/* Arrays whose slots are a memory-mapped file can't change size, and those
+ * mapped read-only can't have their elements changed either. */
+MVM_STATIC_INLINE void check_resizable(MVMThreadContext *tc, MVMArrayBody *body) {
+    if (body->mapping)
+        MVM_exception_throw_adhoc(tc, "MVMArray: Cannot change the size of a memory-mapped buffer");
+}
+MVM_STATIC_INLINE void check_writable(MVMThreadContext *tc, MVMArrayBody *body) {
+    if (body->mapping && !body->mapping->writable)
+        MVM_exception_throw_adhoc(tc, "MVMArray: Cannot modify a read-only memory-mapped buffer");
+}
+
 /* Creates a new type object of this representation, and associates it with
  * the given HOW. */
 static MVMObject * type_object_for(MVMThreadContext *tc, MVMObject *HOW) {
@@ -103,7 +115,17 @@ static void VMArray_gc_mark(MVMThreadContext *tc, MVMSTable *st, void *data, MVM
 /* Called by the VM in order to free memory associated with this object. */
 static void gc_free(MVMThreadContext *tc, MVMObject *obj) {
     MVMArray *arr = (MVMArray *)obj;
-    MVM_free(arr->body.slots.any);
+    if (arr->body.mapping) {
+        MVMArrayMapping *mapping = arr->body.mapping;
+        if (mapping->private_copy)
+            MVM_platform_free_pages(mapping->block, mapping->size);
+        else
+            MVM_platform_unmap_file(mapping->block, mapping->handle, mapping->size);
+        MVM_free(mapping);
+    }
+    else {
+        MVM_free(arr->body.slots.any);
+    }
 }
 
 /* Marks the representation data in an STable.*/
@@ -311,6 +333,7 @@ static void set_size_internal(MVMThreadContext *tc, MVMArrayBody *body, MVMuint6
 
     if (n == elems)
         return;
+    check_resizable(tc, body);
 
     if (start > 0 && n + start > ssize) {
         /* if there aren't enough slots at the end, shift off empty slots
@@ -382,6 +405,7 @@ static void bind_pos(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void
     MVMuint64        real_index;
 
     /* Handle negative indexes and resizing if needed. */
+    check_writable(tc, body);
     enter_single_user(tc, body);
     if (index < 0) {
         index += body->elems;
@@ -554,6 +578,7 @@ static void pop(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data
     if (body->elems < 1)
         MVM_exception_throw_adhoc(tc,
             "MVMArray: Can't pop from an empty array");
+    check_resizable(tc, body);
 
     enter_single_user(tc, body);
     body->elems--;
@@ -728,6 +753,7 @@ static void shift(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *da
     if (body->elems < 1)
         MVM_exception_throw_adhoc(tc,
             "MVMArray: Can't shift from an empty array");
+    check_resizable(tc, body);
 
     enter_single_user(tc, body);
     switch (repr_data->slot_type) {
@@ -893,6 +919,7 @@ static void write_buf(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void
     if (offset < 0) {
         MVM_exception_throw_adhoc(tc, "MVMArray: Index out of bounds");
     }
+    check_writable(tc, body);
 
     /* resize the array if necessary*/
     if (elems < offset + count)
@@ -930,6 +957,10 @@ static void asplice(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *
     MVMint64 start;
     MVMint64 tail;
 
+    check_writable(tc, body);
+    if (elems1 != count)
+        check_resizable(tc, body);
+
     /* start from end? */
     if (offset < 0) {
         offset += elems0;
@@ -1085,6 +1116,7 @@ static AO_t * pos_as_atomic(MVMThreadContext *tc, MVMSTable *st, MVMObject *root
         index += body->elems;
     if (index < 0 || (MVMuint64)index >= body->elems)
         MVM_exception_throw_adhoc(tc, "Index out of bounds in atomic operation on array");
+    check_writable(tc, body);
 
     if (sizeof(AO_t) == 8 && (repr_data->slot_type == MVM_ARRAY_I64 ||
             repr_data->slot_type == MVM_ARRAY_U64))
@@ -1388,6 +1420,8 @@ static void spesh(MVMThreadContext *tc, MVMSTable *st, MVMSpeshGraph *g, MVMSpes
 static MVMuint64 unmanaged_size(MVMThreadContext *tc, MVMSTable *st, void *data) {
     MVMArrayREPRData *repr_data = (MVMArrayREPRData *) st->REPR_data;
     MVMArrayBody     *body      = (MVMArrayBody *)data;
+    if (body->mapping)
+        return body->mapping->private_copy ? body->mapping->size : 0;
     return body->ssize * repr_data->elem_size;
 }
 
@@ -1434,6 +1468,7 @@ static void vmarray_bind_pos_int64(MVMThreadContext *tc, MVMSTable *st, void *da
     MVMuint64        real_index;
 
     /* Handle negative indexes and resizing if needed. */
+    check_writable(tc, body);
     enter_single_user(tc, body);
     if (index < 0) {
         index += body->elems;
@@ -32,6 +32,10 @@ struct MVMArrayBody {
         void       *any;
     } slots;
 
+    /* If the slots are a file mapped into memory rather than memory that we
+     * allocated, the details of the mapping; otherwise NULL. */
+    MVMArrayMapping *mapping;
+
 #if MVM_ARRAY_CONC_DEBUG
     AO_t in_use;
 #endif 
@@ -41,6 +45,26 @@ struct MVMArray {
     MVMArrayBody body;
 };
 
+/* A file mapped into memory as the slots of an array. The slots can't be
+ * reallocated, so such an array can't change size, and if the mapping is
+ * read-only then its elements can't be changed either. It is unmapped when
+ * the array is freed. */
+struct MVMArrayMapping {
+    /* The start of the mapped memory, its size, and any handle the platform
+     * needs in order to unmap it. */
+    void   *block;
+    size_t  size;
+    void   *handle;
+
+    /* Whether it may be written to. */
+    MVMuint8 writable;
+
+    /* Whether the memory is not a mapping of the file but read-only pages of
+     * our own holding a copy of it. Such memory never changes, so strings can
+     * be views of it. */
+    MVMuint8 private_copy;
+};
+
 /* Types of things we may be storing. */
 #define MVM_ARRAY_OBJ   0
 #define MVM_ARRAY_STR   1
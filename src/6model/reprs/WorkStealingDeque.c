@@ -0,0 +1,247 @@
+#include "moar.h"
+
+/* This representation's function pointer table. */
+static const MVMREPROps WorkStealingDeque_this_repr;
+
+/* Allocates an array with space for the specified number of items. */
+static MVMWorkStealingDequeArray * allocate_array(MVMThreadContext *tc, MVMuint64 size) {
+    MVMWorkStealingDequeArray *array = MVM_malloc(sizeof(MVMWorkStealingDequeArray)
+        + (size - 1) * sizeof(MVMObject *));
+    array->size = size;
+    return array;
+}
+
+/* Creates a new type object of this representation, and associates it with
+ * the given HOW. */
+static MVMObject * type_object_for(MVMThreadContext *tc, MVMObject *HOW) {
+    MVMSTable *st  = MVM_gc_allocate_stable(tc, &WorkStealingDeque_this_repr, HOW);
+
+    MVMROOT(tc, st, {
+        MVMObject *obj = MVM_gc_allocate_type_object(tc, st);
+        MVM_ASSIGN_REF(tc, &(st->header), st->WHAT, obj);
+        st->size = sizeof(MVMWorkStealingDeque);
+    });
+
+    return st->WHAT;
+}
+
+/* Initializes a new instance. */
+static void initialize(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data) {
+    MVMWorkStealingDequeBody *body = (MVMWorkStealingDequeBody *)data;
+    body->array = allocate_array(tc, MVM_WSDEQUE_INITIAL_SIZE);
+}
+
+/* Copies the body of one object to another. */
+static void copy_to(MVMThreadContext *tc, MVMSTable *st, void *src, MVMObject *dest_root, void *dest) {
+    MVM_exception_throw_adhoc(tc, "Cannot copy object with representation WorkStealingDeque");
+}
+
+/* Called by the VM to mark any GCable items. */
+static void gc_mark(MVMThreadContext *tc, MVMSTable *st, void *data, MVMGCWorklist *worklist) {
+    /* The world is stopped, and no operation on the deque has a safepoint in
+     * it, so we can just walk the items between top and bottom. */
+    MVMWorkStealingDequeBody *body = (MVMWorkStealingDequeBody *)data;
+    MVMWorkStealingDequeArray *array = body->array;
+    AO_t i;
+    if (!array)
+        return;
+    for (i = body->top; (MVMint64)(intptr_t)body->bottom - (MVMint64)(intptr_t)i > 0; i++)
+        MVM_gc_worklist_add(tc, worklist, &array->items[i & (array->size - 1)]);
+}
+
+static MVMuint64 unmanaged_size(MVMThreadContext *tc, MVMSTable *st, void *data) {
+    MVMWorkStealingDequeBody *body = (MVMWorkStealingDequeBody *)data;
+    return body->array ? body->array->size * sizeof(MVMObject *) : 0;
+}
+
+/* Called by the VM in order to free memory associated with this object. */
+static void gc_free(MVMThreadContext *tc, MVMObject *obj) {
+    MVMWorkStealingDeque *deque = (MVMWorkStealingDeque *)obj;
+    MVM_free(deque->body.array);
+    deque->body.array = NULL;
+}
+
+static const MVMStorageSpec storage_spec = {
+    MVM_STORAGE_SPEC_REFERENCE, /* inlineable */
+    0,                          /* bits */
+    0,                          /* align */
+    MVM_STORAGE_SPEC_BP_NONE,   /* boxed_primitive */
+    0,                          /* can_box */
+    0,                          /* is_unsigned */
+};
+
+/* Gets the storage specification for this representation. */
+static const MVMStorageSpec * get_storage_spec(MVMThreadContext *tc, MVMSTable *st) {
+    return &storage_spec;
+}
+
+/* Compose the representation. */
+static void compose(MVMThreadContext *tc, MVMSTable *st, MVMObject *info) {
+    /* Nothing to do for this REPR. */
+}
+
+/* Gets the number of items in the deque. When other threads are using it,
+ * this is only a snapshot. */
+static MVMuint64 elems(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data) {
+    MVMWorkStealingDequeBody *body = (MVMWorkStealingDequeBody *)data;
+    AO_t top = MVM_load(&body->top);
+    MVMint64 num = (MVMint64)(intptr_t)MVM_load(&body->bottom) - (MVMint64)(intptr_t)top;
+    return num > 0 ? (MVMuint64)num : 0;
+}
+
+/* Set the size of the STable. */
+static void deserialize_stable_size(MVMThreadContext *tc, MVMSTable *st, MVMSerializationReader *reader) {
+    st->size = sizeof(MVMWorkStealingDeque);
+}
+
+/* Initializes the representation. */
+const MVMREPROps * MVMWorkStealingDeque_initialize(MVMThreadContext *tc) {
+    return &WorkStealingDeque_this_repr;
+}
+
+static const MVMREPROps WorkStealingDeque_this_repr = {
+    type_object_for,
+    MVM_gc_allocate_object,
+    initialize,
+    copy_to,
+    MVM_REPR_DEFAULT_ATTR_FUNCS,
+    MVM_REPR_DEFAULT_BOX_FUNCS,
+    MVM_REPR_DEFAULT_POS_FUNCS,
+    MVM_REPR_DEFAULT_ASS_FUNCS,
+    elems,
+    get_storage_spec,
+    NULL, /* change_type */
+    NULL, /* serialize */
+    NULL, /* deserialize */
+    NULL, /* serialize_repr_data */
+    NULL, /* deserialize_repr_data */
+    deserialize_stable_size,
+    gc_mark,
+    gc_free,
+    NULL, /* gc_cleanup */
+    NULL, /* gc_mark_repr_data */
+    NULL, /* gc_free_repr_data */
+    compose,
+    NULL, /* spesh */
+    "WorkStealingDeque", /* name */
+    MVM_REPR_ID_WorkStealingDeque,
+    unmanaged_size,
+    NULL /* describe_refs */
+};
+
+/* Checks that we have a concrete work-stealing deque, and gets its body. */
+static MVMWorkStealingDequeBody * get_body(MVMThreadContext *tc, MVMObject *deque, const char *op) {
+    if (REPR(deque)->ID != MVM_REPR_ID_WorkStealingDeque || !IS_CONCRETE(deque))
+        MVM_exception_throw_adhoc(tc,
+            "%s requires a concrete object with REPR WorkStealingDeque, got %s (%s)",
+            op, REPR(deque)->name, MVM_6model_get_debug_name(tc, deque));
+    return &((MVMWorkStealingDeque *)deque)->body;
+}
+
+/* Checks that the current thread owns the deque, making it the owner if the
+ * deque doesn't have one yet. */
+static void check_owner(MVMThreadContext *tc, MVMWorkStealingDequeBody *body, const char *op) {
+    AO_t owner = MVM_load(&body->owner);
+    if (owner != (AO_t)tc->thread_id) {
+        if (owner || !MVM_trycas(&body->owner, 0, (AO_t)tc->thread_id))
+            MVM_exception_throw_adhoc(tc,
+                "Can only %s on a work-stealing deque from the thread that owns it; other threads must steal",
+                op);
+    }
+}
+
+/* Grows the array to twice its size. Only called by the owner. */
+static MVMWorkStealingDequeArray * grow(MVMThreadContext *tc, MVMWorkStealingDequeBody *body,
+        AO_t top, AO_t bottom) {
+    MVMWorkStealingDequeArray *old_array = body->array;
+    MVMWorkStealingDequeArray *new_array = allocate_array(tc, old_array->size * 2);
+    AO_t i;
+    for (i = top; i != bottom; i++)
+        new_array->items[i & (new_array->size - 1)] = old_array->items[i & (old_array->size - 1)];
+    MVM_store(&body->array, new_array);
+
+    /* Thieves may still be looking at the old array. */
+    uv_mutex_lock(&(tc->instance->mutex_free_at_safepoint));
+    MVM_free_at_safepoint(tc, old_array);
+    uv_mutex_unlock(&(tc->instance->mutex_free_at_safepoint));
+
+    return new_array;
+}
+
+/* Pushes an item onto the bottom of the deque. Only the owner may do this. */
+void MVM_workstealingdeque_push(MVMThreadContext *tc, MVMObject *deque, MVMObject *value) {
+    MVMWorkStealingDequeBody *body = get_body(tc, deque, "wsdequepush");
+    MVMWorkStealingDequeArray *array;
+    AO_t top, bottom;
+    check_owner(tc, body, "push");
+
+    bottom = body->bottom;
+    top    = MVM_load(&body->top);
+    array  = body->array;
+    if (((MVMint64)(intptr_t)bottom - (MVMint64)(intptr_t)top) >= (MVMint64)array->size)
+        array = grow(tc, body, top, bottom);
+    MVM_ASSIGN_REF(tc, &(deque->header), array->items[bottom & (array->size - 1)], value);
+
+    /* Make the item visible to thieves. */
+    MVM_barrier();
+    MVM_store(&body->bottom, bottom + 1);
+}
+
+/* Pops an item from the bottom of the deque, returning VMNull if it is
+ * empty. Only the owner may do this. */
+MVMObject * MVM_workstealingdeque_pop(MVMThreadContext *tc, MVMObject *deque) {
+    MVMWorkStealingDequeBody *body = get_body(tc, deque, "wsdequepop");
+    MVMWorkStealingDequeArray *array;
+    MVMObject *result = NULL;
+    AO_t top, bottom;
+    check_owner(tc, body, "pop");
+
+    /* Claim the bottom item before looking at top; a thief does it the
+     * other way around, so we can't both think we got the same item unless
+     * it's the last one. */
+    bottom = body->bottom - 1;
+    array  = body->array;
+    MVM_store(&body->bottom, bottom);
+    MVM_barrier();
+    top = MVM_load(&body->top);
+
+    if (((MVMint64)(intptr_t)bottom - (MVMint64)(intptr_t)top) >= 0) {
+        result = array->items[bottom & (array->size - 1)];
+        if (bottom == top) {
+            /* The last item; race the thieves for it. */
+            if (!MVM_trycas(&body->top, top, top + 1))
+                result = NULL;
+            MVM_store(&body->bottom, bottom + 1);
+        }
+    }
+    else {
+        /* Empty. */
+        MVM_store(&body->bottom, bottom + 1);
+    }
+
+    return result ? result : tc->instance->VMNull;
+}
+
+/* Steals an item from the top of the deque, returning VMNull if it is
+ * empty. Any thread may do this. */
+MVMObject * MVM_workstealingdeque_steal(MVMThreadContext *tc, MVMObject *deque) {
+    MVMWorkStealingDequeBody *body = get_body(tc, deque, "wsdequesteal");
+    while (1) {
+        MVMWorkStealingDequeArray *array;
+        MVMObject *result;
+        AO_t top, bottom;
+
+        top = MVM_load(&body->top);
+        MVM_barrier();
+        bottom = MVM_load(&body->bottom);
+        if (((MVMint64)(intptr_t)bottom - (MVMint64)(intptr_t)top) <= 0)
+            return tc->instance->VMNull;
+
+        array  = (MVMWorkStealingDequeArray *)MVM_load(&body->array);
+        result = array->items[top & (array->size - 1)];
+        if (MVM_trycas(&body->top, top, top + 1))
+            return result;
+
+        /* Another thief, or the owner, took it first; try again. */
+    }
+}
@@ -0,0 +1,50 @@
+/* The circular array holding the items of a work-stealing deque. The size
+ * is always a power of two. */
+struct MVMWorkStealingDequeArray {
+    MVMuint64  size;
+    MVMObject *items[1];
+};
+
+/* A work-stealing deque, in the style of Chase and Lev. One thread owns the
+ * deque, and it alone may push and pop items, working at the bottom end like
+ * a stack. Any thread may steal items from the top end. The owner doesn't
+ * have to synchronize with thieves except when taking the very last item;
+ * thieves race each other to increment top with a CAS.
+ *
+ * The owner is the first thread to push or pop. A scheduler will usually make
+ * one deque per worker thread, have each worker push the work it creates
+ * onto its own deque, and have idle workers steal from the others.
+ *
+ * None of the operations contain a GC safepoint, so the GC always sees the
+ * deque in a consistent state, and any object that a thief reads out of the
+ * array is still valid when its CAS succeeds. When the owner grows the array,
+ * thieves may still be reading the old one, so it is only freed at the next
+ * safepoint. */
+struct MVMWorkStealingDequeBody {
+    /* The index of the next item to steal, and one past the last item that
+     * was pushed. */
+    AO_t top;
+    AO_t bottom;
+
+    /* The items. */
+    MVMWorkStealingDequeArray *array;
+
+    /* The ID of the thread that owns the deque, or 0 if nothing was pushed
+     * or popped yet. */
+    AO_t owner;
+};
+struct MVMWorkStealingDeque {
+    MVMObject common;
+    MVMWorkStealingDequeBody body;
+};
+
+/* The number of items the array initially has space for. */
+#define MVM_WSDEQUE_INITIAL_SIZE 32
+
+/* Function for REPR setup. */
+const MVMREPROps * MVMWorkStealingDeque_initialize(MVMThreadContext *tc);
+
+/* Operations on work-stealing deques. */
+void MVM_workstealingdeque_push(MVMThreadContext *tc, MVMObject *deque, MVMObject *value);
+MVMObject * MVM_workstealingdeque_pop(MVMThreadContext *tc, MVMObject *deque);
+MVMObject * MVM_workstealingdeque_steal(MVMThreadContext *tc, MVMObject *deque);
@@ -911,10 +911,11 @@ static void flatten_args(MVMThreadContext *tc, MVMArgProcContext *ctx) {
             arg_info.arg = ctx->args[arg_pos];
 
             if (arg_info.arg.o && REPR(arg_info.arg.o)->ID == MVM_REPR_ID_MVMHash) {
-                MVMHashBody *body = &((MVMHash *)arg_info.arg.o)->body;
-                MVMHashEntry *current;
+                MVMStrHashTable *hashtable = &(((MVMHash *)arg_info.arg.o)->body.hashtable);
+                MVMStrHashIterator iterator = MVM_str_hash_first(tc, hashtable);
 
-                HASH_ITER_FAST(tc, hash_handle, body->hash_head, current, {
+                while (!MVM_str_hash_at_end(tc, hashtable, iterator)) {
+                    MVMHashEntry *current = MVM_str_hash_current(tc, hashtable, iterator);
                     MVMString *arg_name = MVM_HASH_KEY(current);
                     if (!seen_name(tc, arg_name, new_args, new_num_pos, new_arg_pos)) {
                         if (new_arg_pos + 1 >= new_args_size) {
@@ -928,7 +929,8 @@ static void flatten_args(MVMThreadContext *tc, MVMArgProcContext *ctx) {
                         (new_args + new_arg_pos++)->o = current->value;
                         new_arg_flags[new_flag_pos++] = MVM_CALLSITE_ARG_NAMED | MVM_CALLSITE_ARG_OBJ;
                     }
-                });
+                    iterator = MVM_str_hash_next(tc, hashtable, iterator);
+                }
             }
             else if (arg_info.arg.o) {
                 MVM_free(new_arg_flags);
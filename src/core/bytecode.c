@@ -493,6 +493,7 @@ static MVMStaticFrame ** deserialize_frames(MVMThreadContext *tc, MVMCompUnit *c
         static_frame = (MVMStaticFrame *)MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTStaticFrame);
         MVM_ASSIGN_REF(tc, &(cu->common.header), frames[i], static_frame);
         static_frame_body = &static_frame->body;
+        static_frame_body->cu_frame_idx = i;
         bytecode_pos = read_int32(pos, 0);
         bytecode_size = read_int32(pos, 4);
         if (bytecode_pos >= rs->bytecode_size) {
@@ -645,29 +646,21 @@ void MVM_bytecode_finish_frame(MVMThreadContext *tc, MVMCompUnit *cu,
 
     /* Read the lexical types. */
     if (sf->body.num_lexicals) {
-        /* Allocate names hash and types list. */
+        /* Allocate names and types lists. */
         sf->body.lexical_types = MVM_malloc(sizeof(MVMuint16) * sf->body.num_lexicals);
-        sf->body.lexical_names_list = MVM_malloc(sizeof(MVMLexicalRegistry *) * sf->body.num_lexicals);
+        sf->body.lexical_names_list = MVM_malloc(sizeof(MVMString *) * sf->body.num_lexicals);
 
         /* Read in data. */
         for (j = 0; j < sf->body.num_lexicals; j++) {
             MVMString *name = get_heap_string(tc, cu, NULL, pos, 6 * j + 2);
-            MVMLexicalRegistry *entry = MVM_calloc(1, sizeof(MVMLexicalRegistry));
-            MVM_HASH_BIND_FREE(tc, sf->body.lexical_names, name, entry, {
-                if (sf->body.num_locals) {
-                    MVM_free_null(sf->body.local_types);
-                }
-                MVM_free_null(sf->body.lexical_types);
-                MVM_free_null(sf->body.lexical_names_list);
-                MVM_free(entry);
-            });
-
-            MVM_ASSIGN_REF(tc, &(sf->common.header), entry->key, name);
-            sf->body.lexical_names_list[j] = entry;
-            entry->value = j;
-
+            MVM_ASSIGN_REF(tc, &(sf->common.header), sf->body.lexical_names_list[j], name);
             sf->body.lexical_types[j] = read_int16(pos, 6 * j);
         }
+
+        /* The names are fixed from here on, so build the lookup for them. */
+        MVM_index_hash_build(tc, &sf->body.lexical_names, sf->body.lexical_names_list,
+            sf->body.num_lexicals);
+
         pos += 6 * sf->body.num_lexicals;
     }
 
@@ -715,6 +708,7 @@ void MVM_bytecode_finish_frame(MVMThreadContext *tc, MVMCompUnit *cu,
             if (sf->body.num_lexicals) {
                 MVM_free_null(sf->body.lexical_types);
                 MVM_free_null(sf->body.lexical_names_list);
+                MVM_index_hash_demolish(tc, &sf->body.lexical_names);
             }
             if (sf->body.num_handlers) {
                 MVM_free_null(sf->body.handlers);
@@ -737,6 +731,7 @@ void MVM_bytecode_finish_frame(MVMThreadContext *tc, MVMCompUnit *cu,
                 if (sf->body.num_lexicals) {
                     MVM_free_null(sf->body.lexical_types);
                     MVM_free_null(sf->body.lexical_names_list);
+                    MVM_index_hash_demolish(tc, &sf->body.lexical_names);
                 }
                 if (sf->body.num_handlers) {
                     MVM_free_null(sf->body.handlers);
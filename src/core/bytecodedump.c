@@ -372,7 +372,6 @@ char * MVM_bytecode_dump(MVMThreadContext *tc, MVMCompUnit *cu) {
     MVMuint32 i, j, k;
     char *o = MVM_calloc(s, sizeof(char));
     char ***frame_lexicals = MVM_malloc(sizeof(char **) * cu->body.num_frames);
-    MVMString *name = MVM_string_utf8_decode(tc, tc->instance->VMString, "", 0);
 
     a("\nMoarVM dump of binary compilation unit:\n\n");
 
@@ -426,7 +425,6 @@ char * MVM_bytecode_dump(MVMThreadContext *tc, MVMCompUnit *cu) {
 
     for (k = 0; k < cu->body.num_frames; k++) {
         MVMStaticFrame *frame = get_frame(tc, cu, k);
-        MVMLexicalRegistry *current;
         char **lexicals;
 
         if (!frame->body.fully_deserialized) {
@@ -436,11 +434,9 @@ char * MVM_bytecode_dump(MVMThreadContext *tc, MVMCompUnit *cu) {
         lexicals = (char **)MVM_malloc(sizeof(char *) * frame->body.num_lexicals);
         frame_lexicals[k] = lexicals;
 
-        HASH_ITER(tc, hash_handle, frame->body.lexical_names, current, {
-            name->body.storage.blob_32 = (MVMint32 *)current->hash_handle.key;
-            name->body.num_graphs      = (MVMuint32)current->hash_handle.keylen / sizeof(MVMGrapheme32);
-            lexicals[current->value]   = MVM_string_utf8_encode_C_string(tc, name);
-        });
+        for (j = 0; j < frame->body.num_lexicals; j++)
+            lexicals[j] = MVM_string_utf8_encode_C_string(tc,
+                frame->body.lexical_names_list[j]);
     }
     for (k = 0; k < cu->body.num_frames; k++) {
         MVMStaticFrame *frame = get_frame(tc, cu, k);
@@ -25,6 +25,11 @@ MVMCompUnit * MVM_cu_from_bytes(MVMThreadContext *tc, MVMuint8 *bytes, MVMuint32
     cu->body.hll_config = MVM_hll_get_config_for(tc, cu->body.hll_name);
     MVM_gc_write_barrier_hit(tc, (MVMCollectable *)cu);
 
+    /* Pick up any frames that were hot, and any statistics recorded for
+     * frames, in earlier runs. */
+    MVM_spesh_cache_load(tc, cu);
+    MVM_spesh_preload_attach(tc, cu);
+
     return cu;
 }
 
@@ -233,9 +238,13 @@ MVMString * MVM_cu_obtain_string(MVMThreadContext *tc, MVMCompUnit *cu, MVMuint3
         if (cur_pos + bytes < limit) {
             MVMString *s;
             MVM_gc_allocate_gen2_default_set(tc);
-            s = decode_utf8
-                ? MVM_string_utf8_decode(tc, tc->instance->VMString, (char *)cur_pos, bytes)
-                : MVM_string_latin1_decode(tc, tc->instance->VMString, (char *)cur_pos, bytes);
+            /* The bytecode lives as long as we do, and never changes, so an
+             * ASCII string can be a view of it rather than a copy. */
+            s = MVM_string_ascii_view(tc, (MVMObject *)cu, (char *)cur_pos, bytes);
+            if (!s)
+                s = decode_utf8
+                    ? MVM_string_utf8_decode(tc, tc->instance->VMString, (char *)cur_pos, bytes)
+                    : MVM_string_latin1_decode(tc, tc->instance->VMString, (char *)cur_pos, bytes);
             MVM_ASSIGN_REF(tc, &(cu->common.header), cu->body.strings[idx], s);
             MVM_gc_allocate_gen2_default_clear(tc);
             return s;
@@ -505,6 +505,15 @@ void MVM_frame_invoke(MVMThreadContext *tc, MVMStaticFrame *static_frame,
         }
     }
 #endif
+    /* A baseline candidate does no per-offset logging, so while the frame is
+     * still being logged, run some of its invocations unspecialized; that
+     * way we keep on collecting the types and invocation targets needed to
+     * specialize it properly. */
+    if (spesh_cand >= 0 && spesh->body.spesh_candidates[spesh_cand]->is_baseline
+            && tc->spesh_log && static_frame->body.bytecode_size < MVM_SPESH_MAX_BYTECODE_SIZE
+            && spesh->body.spesh_entries_recorded < MVM_SPESH_LOG_LOGGED_ENOUGH
+            && spesh->body.spesh_entries_recorded % MVM_SPESH_LOG_BASELINE_INTERVAL == 0)
+        spesh_cand = -1;
     if (spesh_cand >= 0) {
         MVMSpeshCandidate *chosen_cand = spesh->body.spesh_candidates[spesh_cand];
         if (static_frame->body.allocate_on_heap) {
@@ -540,25 +549,28 @@ void MVM_frame_invoke(MVMThreadContext *tc, MVMStaticFrame *static_frame,
             frame->spesh_correlation_id = 0;
         }
         chosen_bytecode = static_frame->body.bytecode;
+    }
 
-        /* If we should be spesh logging, set the correlation ID. */
-        if (tc->instance->spesh_enabled && tc->spesh_log && static_frame->body.bytecode_size < MVM_SPESH_MAX_BYTECODE_SIZE) {
-            if (spesh->body.spesh_entries_recorded++ < MVM_SPESH_LOG_LOGGED_ENOUGH) {
-                MVMint32 id = ++tc->spesh_cid;
-                frame->spesh_correlation_id = id;
-                MVMROOT3(tc, static_frame, code_ref, outer, {
-                    if (on_heap) {
-                        MVMROOT(tc, frame, {
-                            MVM_spesh_log_entry(tc, id, static_frame, callsite, args);
-                        });
-                    }
-                    else {
-                        MVMROOT2(tc, frame->caller, frame->static_info, {
-                            MVM_spesh_log_entry(tc, id, static_frame, callsite, args);
-                        });
-                    }
-                });
-            }
+    /* If we should be spesh logging, set the correlation ID. Frames running
+     * a baseline candidate still log their entry, so that they go on to get
+     * hot enough to be properly specialized. */
+    if ((!frame->spesh_cand || frame->spesh_cand->is_baseline) && tc->instance->spesh_enabled
+            && tc->spesh_log && static_frame->body.bytecode_size < MVM_SPESH_MAX_BYTECODE_SIZE) {
+        if (spesh->body.spesh_entries_recorded++ < MVM_SPESH_LOG_LOGGED_ENOUGH) {
+            MVMint32 id = ++tc->spesh_cid;
+            frame->spesh_correlation_id = id;
+            MVMROOT3(tc, static_frame, code_ref, outer, {
+                if (static_frame->body.allocate_on_heap) {
+                    MVMROOT(tc, frame, {
+                        MVM_spesh_log_entry(tc, id, static_frame, callsite, args);
+                    });
+                }
+                else {
+                    MVMROOT2(tc, frame->caller, frame->static_info, {
+                        MVM_spesh_log_entry(tc, id, static_frame, callsite, args);
+                    });
+                }
+            });
         }
     }
 
@@ -1317,6 +1329,12 @@ MVMObject * MVM_frame_vivify_lexical(MVMThreadContext *tc, MVMFrame *f, MVMuint1
     }
 }
 
+/* Looks up the index of the lexical with the specified name in a static
+ * frame; returns MVM_INDEX_HASH_NOT_FOUND if it has no such lexical. */
+MVMuint32 MVM_get_lexical_by_name(MVMThreadContext *tc, MVMStaticFrame *sf, MVMString *name) {
+    return MVM_index_hash_fetch(tc, &sf->body.lexical_names, sf->body.lexical_names_list, name);
+}
+
 /* Looks up the address of the lexical with the specified name and the
  * specified type. Non-existing object lexicals produce NULL, expected
  * (for better or worse) by various things. Otherwise, an error is thrown
@@ -1324,25 +1342,20 @@ MVMObject * MVM_frame_vivify_lexical(MVMThreadContext *tc, MVMFrame *f, MVMuint1
 MVMRegister * MVM_frame_find_lexical_by_name(MVMThreadContext *tc, MVMString *name, MVMuint16 type) {
     MVMFrame *cur_frame = tc->cur_frame;
     while (cur_frame != NULL) {
-        MVMLexicalRegistry *lexical_names = cur_frame->static_info->body.lexical_names;
-        if (lexical_names) {
-            /* Indexes were formerly stored off-by-one to avoid semi-predicate issue. */
-            MVMLexicalRegistry *entry;
-            MVM_HASH_GET(tc, lexical_names, name, entry)
-            if (entry) {
-                if (MVM_LIKELY(cur_frame->static_info->body.lexical_types[entry->value] == type)) {
-                    MVMRegister *result = &cur_frame->env[entry->value];
-                    if (type == MVM_reg_obj && !result->o)
-                        MVM_frame_vivify_lexical(tc, cur_frame, entry->value);
-                    return result;
-                }
-                else {
-                    char *c_name = MVM_string_utf8_encode_C_string(tc, name);
-                    char *waste[] = { c_name, NULL };
-                    MVM_exception_throw_adhoc_free(tc, waste,
-                        "Lexical with name '%s' has wrong type",
-                            c_name);
-                }
+        MVMuint32 idx = MVM_get_lexical_by_name(tc, cur_frame->static_info, name);
+        if (idx != MVM_INDEX_HASH_NOT_FOUND) {
+            if (MVM_LIKELY(cur_frame->static_info->body.lexical_types[idx] == type)) {
+                MVMRegister *result = &cur_frame->env[idx];
+                if (type == MVM_reg_obj && !result->o)
+                    MVM_frame_vivify_lexical(tc, cur_frame, idx);
+                return result;
+            }
+            else {
+                char *c_name = MVM_string_utf8_encode_C_string(tc, name);
+                char *waste[] = { c_name, NULL };
+                MVM_exception_throw_adhoc_free(tc, waste,
+                    "Lexical with name '%s' has wrong type",
+                        c_name);
             }
         }
         cur_frame = cur_frame->outer;
@@ -1361,28 +1374,24 @@ MVMRegister * MVM_frame_find_lexical_by_name(MVMThreadContext *tc, MVMString *na
 MVM_PUBLIC void MVM_frame_bind_lexical_by_name(MVMThreadContext *tc, MVMString *name, MVMuint16 type, MVMRegister value) {
     MVMFrame *cur_frame = tc->cur_frame;
     while (cur_frame != NULL) {
-        MVMLexicalRegistry *lexical_names = cur_frame->static_info->body.lexical_names;
-        if (lexical_names) {
-            MVMLexicalRegistry *entry;
-            MVM_HASH_GET(tc, lexical_names, name, entry)
-            if (entry) {
-                if (cur_frame->static_info->body.lexical_types[entry->value] == type) {
-                    if (type == MVM_reg_obj || type == MVM_reg_str) {
-                        MVM_ASSIGN_REF(tc, &(cur_frame->header),
-                            cur_frame->env[entry->value].o, value.o);
-                    }
-                    else {
-                        cur_frame->env[entry->value] = value;
-                    }
-                    return;
+        MVMuint32 idx = MVM_get_lexical_by_name(tc, cur_frame->static_info, name);
+        if (idx != MVM_INDEX_HASH_NOT_FOUND) {
+            if (cur_frame->static_info->body.lexical_types[idx] == type) {
+                if (type == MVM_reg_obj || type == MVM_reg_str) {
+                    MVM_ASSIGN_REF(tc, &(cur_frame->header),
+                        cur_frame->env[idx].o, value.o);
                 }
                 else {
-                    char *c_name = MVM_string_utf8_encode_C_string(tc, name);
-                    char *waste[] = { c_name, NULL };
-                    MVM_exception_throw_adhoc_free(tc, waste,
-                        "Lexical with name '%s' has wrong type",
-                            c_name);
+                    cur_frame->env[idx] = value;
                 }
+                return;
+            }
+            else {
+                char *c_name = MVM_string_utf8_encode_C_string(tc, name);
+                char *waste[] = { c_name, NULL };
+                MVM_exception_throw_adhoc_free(tc, waste,
+                    "Lexical with name '%s' has wrong type",
+                        c_name);
             }
         }
         cur_frame = cur_frame->outer;
@@ -1415,25 +1424,20 @@ MVMObject * MVM_frame_find_lexical_by_name_outer(MVMThreadContext *tc, MVMString
  * the specified frame. Only works if it's an object lexical.  */
 MVMRegister * MVM_frame_find_lexical_by_name_rel(MVMThreadContext *tc, MVMString *name, MVMFrame *cur_frame) {
     while (cur_frame != NULL) {
-        MVMLexicalRegistry *lexical_names = cur_frame->static_info->body.lexical_names;
-        if (lexical_names) {
-            /* Indexes were formerly stored off-by-one to avoid semi-predicate issue. */
-            MVMLexicalRegistry *entry;
-            MVM_HASH_GET(tc, lexical_names, name, entry)
-            if (entry) {
-                if (cur_frame->static_info->body.lexical_types[entry->value] == MVM_reg_obj) {
-                    MVMRegister *result = &cur_frame->env[entry->value];
-                    if (!result->o)
-                        MVM_frame_vivify_lexical(tc, cur_frame, entry->value);
-                    return result;
-                }
-                else {
-                    char *c_name = MVM_string_utf8_encode_C_string(tc, name);
-                    char *waste[] = { c_name, NULL };
-                    MVM_exception_throw_adhoc_free(tc, waste,
-                        "Lexical with name '%s' has wrong type",
-                            c_name);
-                }
+        MVMuint32 idx = MVM_get_lexical_by_name(tc, cur_frame->static_info, name);
+        if (idx != MVM_INDEX_HASH_NOT_FOUND) {
+            if (cur_frame->static_info->body.lexical_types[idx] == MVM_reg_obj) {
+                MVMRegister *result = &cur_frame->env[idx];
+                if (!result->o)
+                    MVM_frame_vivify_lexical(tc, cur_frame, idx);
+                return result;
+            }
+            else {
+                char *c_name = MVM_string_utf8_encode_C_string(tc, name);
+                char *waste[] = { c_name, NULL };
+                MVM_exception_throw_adhoc_free(tc, waste,
+                    "Lexical with name '%s' has wrong type",
+                        c_name);
             }
         }
         cur_frame = cur_frame->outer;
@@ -1710,13 +1714,9 @@ void MVM_frame_binddynlex(MVMThreadContext *tc, MVMString *name, MVMObject *valu
 /* Returns the storage unit for the lexical in the specified frame. Does not
  * try to vivify anything - gets exactly what is there. */
 MVMRegister * MVM_frame_lexical(MVMThreadContext *tc, MVMFrame *f, MVMString *name) {
-    MVMLexicalRegistry *lexical_names = f->static_info->body.lexical_names;
-    if (MVM_LIKELY(lexical_names != NULL)) {
-        MVMLexicalRegistry *entry;
-        MVM_HASH_GET(tc, lexical_names, name, entry)
-        if (entry)
-            return &f->env[entry->value];
-    }
+    MVMuint32 idx = MVM_get_lexical_by_name(tc, f->static_info, name);
+    if (idx != MVM_INDEX_HASH_NOT_FOUND)
+        return &f->env[idx];
     {
         char *c_name = MVM_string_utf8_encode_C_string(tc, name);
         char *waste[] = { c_name, NULL };
@@ -1727,16 +1727,12 @@ MVMRegister * MVM_frame_lexical(MVMThreadContext *tc, MVMFrame *f, MVMString *na
 
 /* Returns the storage unit for the lexical in the specified frame. */
 MVMRegister * MVM_frame_try_get_lexical(MVMThreadContext *tc, MVMFrame *f, MVMString *name, MVMuint16 type) {
-    MVMLexicalRegistry *lexical_names = f->static_info->body.lexical_names;
-    if (lexical_names) {
-        MVMLexicalRegistry *entry;
-        MVM_HASH_GET(tc, lexical_names, name, entry)
-        if (entry && f->static_info->body.lexical_types[entry->value] == type) {
-            MVMRegister *result = &f->env[entry->value];
-            if (type == MVM_reg_obj && !result->o)
-                MVM_frame_vivify_lexical(tc, f, entry->value);
-            return result;
-        }
+    MVMuint32 idx = MVM_get_lexical_by_name(tc, f->static_info, name);
+    if (idx != MVM_INDEX_HASH_NOT_FOUND && f->static_info->body.lexical_types[idx] == type) {
+        MVMRegister *result = &f->env[idx];
+        if (type == MVM_reg_obj && !result->o)
+            MVM_frame_vivify_lexical(tc, f, idx);
+        return result;
     }
     return NULL;
 }
@@ -1775,14 +1771,10 @@ MVMuint16 MVM_frame_translate_to_primspec(MVMThreadContext *tc, MVMuint16 kind)
 
 /* Returns the primitive type specification for a lexical. */
 MVMuint16 MVM_frame_lexical_primspec(MVMThreadContext *tc, MVMFrame *f, MVMString *name) {
-    MVMLexicalRegistry *lexical_names = f->static_info->body.lexical_names;
-    if (lexical_names) {
-        MVMLexicalRegistry *entry;
-        MVM_HASH_GET(tc, lexical_names, name, entry)
-        if (entry)
-            return MVM_frame_translate_to_primspec(tc,
-                    f->static_info->body.lexical_types[entry->value]);
-    }
+    MVMuint32 idx = MVM_get_lexical_by_name(tc, f->static_info, name);
+    if (idx != MVM_INDEX_HASH_NOT_FOUND)
+        return MVM_frame_translate_to_primspec(tc,
+                f->static_info->body.lexical_types[idx]);
     {
         char *c_name = MVM_string_utf8_encode_C_string(tc, name);
         char *waste[] = { c_name, NULL };
@@ -288,3 +288,10 @@ MVMObject * MVM_hll_sym_get(MVMThreadContext *tc, MVMString *hll, MVMString *sym
     uv_mutex_unlock(&tc->instance->mutex_hll_syms);
     return result;
 }
+
+/* Looks up an object in the HLL symbols stash of the current frame's HLL
+ * (getcurhllsym). The HLL name is not an operand of the op, so it's looked
+ * up here rather than by the caller, which keeps it out of JIT code. */
+MVMObject * MVM_hll_sym_get_cur(MVMThreadContext *tc, MVMString *sym) {
+    return MVM_hll_sym_get(tc, tc->cur_frame->static_info->body.cu->body.hll_name, sym);
+}
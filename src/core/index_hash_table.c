@@ -0,0 +1,119 @@
+#include "moar.h"
+
+MVM_STATIC_INLINE size_t alloc_size(MVMuint8 size_log2) {
+    size_t buckets = (size_t)1 << size_log2;
+    return buckets * sizeof(MVMIndexHashBucket) + buckets;
+}
+
+static void allocate_table(MVMThreadContext *tc, MVMIndexHashTable *hashtable, MVMuint8 size_log2) {
+    size_t buckets = (size_t)1 << size_log2;
+    char *memory = MVM_calloc(1, alloc_size(size_log2));
+    hashtable->buckets            = (MVMIndexHashBucket *)memory;
+    hashtable->metadata           = (MVMuint8 *)(memory + buckets * sizeof(MVMIndexHashBucket));
+    hashtable->cur_items          = 0;
+    hashtable->official_size_log2 = size_log2;
+    hashtable->key_right_shift    = 64 - size_log2;
+    hashtable->max_probe_distance = 0;
+}
+
+/* Finds the bucket holding a key that is already in the table, or returns -1.
+ * Only used while building, to spot duplicate keys. */
+static MVMint64 find_bucket(MVMThreadContext *tc, MVMIndexHashTable *hashtable, MVMString **list, MVMString *key, MVMuint64 hash) {
+    MVMuint32 bucket = MVM_index_hash_bucket(hashtable, hash);
+    MVMuint32 mask   = MVM_index_hash_mask(hashtable);
+    MVMuint32 probe;
+    for (probe = 1; probe <= hashtable->max_probe_distance; probe++) {
+        MVMuint32 distance = hashtable->metadata[bucket];
+        if (distance < probe)
+            return -1;
+        if (distance == probe && hashtable->buckets[bucket].hash_lo == (MVMuint32)hash
+                && MVM_str_hash_keys_equal(tc, key, list[hashtable->buckets[bucket].index]))
+            return bucket;
+        bucket = (bucket + 1) & mask;
+    }
+    return -1;
+}
+
+/* Inserts the key at the given position in the list, displacing buckets that
+ * are closer to their ideal position as we go. Returns zero if we would go
+ * beyond the probe distance we can record, in which case the table must be
+ * built again at a larger size. */
+static int insert(MVMThreadContext *tc, MVMIndexHashTable *hashtable, MVMuint32 index, MVMuint64 hash) {
+    MVMuint32 mask   = MVM_index_hash_mask(hashtable);
+    MVMuint32 bucket = MVM_index_hash_bucket(hashtable, hash);
+    MVMuint32 probe  = 1;
+    MVMIndexHashBucket carry;
+    carry.index   = index;
+    carry.hash_lo = (MVMuint32)hash;
+    while (1) {
+        MVMuint32 distance = hashtable->metadata[bucket];
+        if (distance == 0 || distance < probe) {
+            if (probe > hashtable->max_probe_distance)
+                hashtable->max_probe_distance = (MVMuint8)probe;
+            if (distance == 0) {
+                hashtable->buckets[bucket]  = carry;
+                hashtable->metadata[bucket] = (MVMuint8)probe;
+                return 1;
+            }
+            else {
+                /* Take from the rich; carry on inserting what was here. */
+                MVMIndexHashBucket displaced = hashtable->buckets[bucket];
+                hashtable->buckets[bucket]  = carry;
+                hashtable->metadata[bucket] = (MVMuint8)probe;
+                carry = displaced;
+                probe = distance;
+            }
+        }
+        bucket = (bucket + 1) & mask;
+        if (++probe > MVM_STR_HASH_MAX_PROBE_DISTANCE)
+            return 0;
+    }
+}
+
+/* Builds the table for the first entries strings in list. If a string occurs
+ * more than once, lookups give the position of the last one. */
+void MVM_index_hash_build(MVMThreadContext *tc, MVMIndexHashTable *hashtable, MVMString **list, MVMuint32 entries) {
+    MVMuint8 size_log2 = MVM_INDEX_HASH_MIN_SIZE_LOG2;
+    memset(hashtable, 0, sizeof(MVMIndexHashTable));
+    if (!entries)
+        return;
+    while (((MVMuint64)1 << size_log2) * MVM_STR_HASH_LOAD_FACTOR_NUM
+            / MVM_STR_HASH_LOAD_FACTOR_DEN < entries)
+        size_log2++;
+
+    while (1) {
+        MVMuint32 i;
+        int ok = 1;
+        allocate_table(tc, hashtable, size_log2);
+        for (i = 0; i < entries; i++) {
+            MVMString *key = list[i];
+            MVMuint64 hash;
+            MVMint64 existing;
+            if (MVM_UNLIKELY(!MVM_str_hash_key_is_valid(tc, (MVMObject *)key))) {
+                MVM_index_hash_demolish(tc, hashtable);
+                MVM_str_hash_key_throw_invalid(tc, (MVMObject *)key);
+            }
+            hash     = MVM_str_hash_code(tc, key);
+            existing = find_bucket(tc, hashtable, list, key, hash);
+            if (existing >= 0) {
+                hashtable->buckets[existing].index = i;
+                continue;
+            }
+            if (!insert(tc, hashtable, i, hash)) {
+                ok = 0;
+                break;
+            }
+            hashtable->cur_items++;
+        }
+        if (ok)
+            return;
+        MVM_index_hash_demolish(tc, hashtable);
+        size_log2++;
+    }
+}
+
+/* Frees the memory held by the table, leaving it empty. */
+void MVM_index_hash_demolish(MVMThreadContext *tc, MVMIndexHashTable *hashtable) {
+    MVM_free(hashtable->buckets);
+    memset(hashtable, 0, sizeof(MVMIndexHashTable));
+}
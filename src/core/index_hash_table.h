@@ -0,0 +1,52 @@
+/* A fixed-key hash table, mapping strings to their position in an existing
+ * list of strings. It is used for lookups that are built once and then only
+ * ever read from, such as the lexical names of a static frame or the
+ * attribute names of a class in P6opaque.
+ *
+ * The table does not hold the keys itself. It is a Robin Hood hashed array of
+ * buckets, each holding the index of a string in the list along with the low
+ * 32 bits of its hash code, plus a byte of metadata per bucket (the probe
+ * distance plus one, or 0 if the bucket is empty). The list must be passed
+ * to every lookup, and the table must be rebuilt (or demolished) if the list
+ * is changed.
+ *
+ * Since all the keys are known when the table is built, we size it just once
+ * and remember the longest probe sequence, so a lookup of a name that is not
+ * present never has to scan further than that. String hash codes are cached
+ * on the MVMString, so looking up an interned name (as comes from bytecode)
+ * does not hash it again. A zeroed table is valid and empty. */
+
+/* A bucket in the table. */
+struct MVMIndexHashBucket {
+    /* Position of the key in the list. */
+    MVMuint32 index;
+    /* The low bits of the key's hash code, to avoid most string compares. */
+    MVMuint32 hash_lo;
+};
+
+struct MVMIndexHashTable {
+    /* The buckets and metadata are a single allocation, with the metadata
+     * bytes following the buckets. */
+    MVMIndexHashBucket *buckets;
+    MVMuint8 *metadata;
+
+    /* The number of keys in the table. */
+    MVMuint32 cur_items;
+
+    /* log2 of the number of buckets, and the shift to take a 64 bit hash
+     * code down to a bucket number. */
+    MVMuint8 official_size_log2;
+    MVMuint8 key_right_shift;
+
+    /* The longest probe distance (plus one) of any key in the table. */
+    MVMuint8 max_probe_distance;
+};
+
+/* Returned by lookups for a key that is not in the table. */
+#define MVM_INDEX_HASH_NOT_FOUND ((MVMuint32)~0)
+
+/* The smallest table we create; must be a power of two. */
+#define MVM_INDEX_HASH_MIN_SIZE_LOG2 2
+
+void MVM_index_hash_build(MVMThreadContext *tc, MVMIndexHashTable *hashtable, MVMString **list, MVMuint32 entries);
+void MVM_index_hash_demolish(MVMThreadContext *tc, MVMIndexHashTable *hashtable);
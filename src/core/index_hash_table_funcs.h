@@ -0,0 +1,48 @@
+/* Inline functions for MVMIndexHashTable; see index_hash_table.h for how the
+ * table is laid out. */
+
+MVM_STATIC_INLINE MVMuint32 MVM_index_hash_bucket(MVMIndexHashTable *hashtable, MVMuint64 hash) {
+    return (MVMuint32)((hash * MVM_STR_HASH_FIB) >> hashtable->key_right_shift);
+}
+
+MVM_STATIC_INLINE MVMuint32 MVM_index_hash_mask(MVMIndexHashTable *hashtable) {
+    return (1 << hashtable->official_size_log2) - 1;
+}
+
+MVM_STATIC_INLINE MVMuint32 MVM_index_hash_count(MVMThreadContext *tc, MVMIndexHashTable *hashtable) {
+    return hashtable->cur_items;
+}
+
+/* Looks up the position of a key in the list the table was built from;
+ * returns MVM_INDEX_HASH_NOT_FOUND if it is not there. The key must be a
+ * concrete MVMString. */
+MVM_STATIC_INLINE MVMuint32 MVM_index_hash_fetch_nocheck(MVMThreadContext *tc, MVMIndexHashTable *hashtable, MVMString **list, MVMString *key) {
+    MVMuint64 hash;
+    MVMuint32 bucket, mask, probe;
+    if (MVM_UNLIKELY(hashtable->cur_items == 0))
+        return MVM_INDEX_HASH_NOT_FOUND;
+    hash   = MVM_str_hash_code(tc, key);
+    bucket = MVM_index_hash_bucket(hashtable, hash);
+    mask   = MVM_index_hash_mask(hashtable);
+    for (probe = 1; probe <= hashtable->max_probe_distance; probe++) {
+        MVMuint32 distance = hashtable->metadata[bucket];
+        /* Robin Hood invariant: had the key been here, it would have taken
+         * this bucket over from an entry closer to its ideal position. */
+        if (distance < probe)
+            return MVM_INDEX_HASH_NOT_FOUND;
+        if (distance == probe && hashtable->buckets[bucket].hash_lo == (MVMuint32)hash) {
+            MVMuint32 index = hashtable->buckets[bucket].index;
+            if (MVM_str_hash_keys_equal(tc, key, list[index]))
+                return index;
+        }
+        bucket = (bucket + 1) & mask;
+    }
+    return MVM_INDEX_HASH_NOT_FOUND;
+}
+
+/* As above, but throws if the key is not a concrete string. */
+MVM_STATIC_INLINE MVMuint32 MVM_index_hash_fetch(MVMThreadContext *tc, MVMIndexHashTable *hashtable, MVMString **list, MVMString *key) {
+    if (MVM_UNLIKELY(!MVM_str_hash_key_is_valid(tc, (MVMObject *)key)))
+        MVM_str_hash_key_throw_invalid(tc, (MVMObject *)key);
+    return MVM_index_hash_fetch_nocheck(tc, hashtable, list, key);
+}
@@ -199,12 +199,40 @@ struct MVMInstance {
     /* The number of threads that have yet to acknowledge the finish. */
     AO_t gc_ack;
 
+    /* Chunks of gen2 marking work that threads with plenty to do during a
+     * full collection have shared for idle threads to take. Along with it,
+     * the number of threads taking part in the current run and how many of
+     * them are currently idle, looking for such work. */
+    MVMGCPassedWork *gc_shared_work;
+    AO_t gc_mark_participants;
+    AO_t gc_mark_idle;
+
+    /* The threads whose work the co-ordinator stole for the current run,
+     * which any thread taking part may claim, and how many are claimed. */
+    MVMThreadContext **gc_stolen;
+    MVMuint32 gc_stolen_count;
+    MVMuint32 gc_stolen_alloc;
+    AO_t gc_stolen_claimed;
+
     /* Linked list (via forwarder) of STables to free. */
     MVMSTable *stables_to_free;
 
     /* Whether the current GC run is a full collection. */
     MVMuint32 gc_full_collect;
 
+    /* Whether we may mark generation 2 incrementally ahead of a full
+     * collection, and the state of that marking (one of the
+     * MVM_GC_INCREMENTAL_* values). */
+    MVMuint32 gc_incremental_enabled;
+    MVMuint32 gc_incremental_marking;
+
+    /* How fragmented a gen2 size class must be, as the percentage of free
+     * slots after sweeping it, before we release its empty pages. */
+    MVMuint32 gc_gen2_release_percent;
+
+    /* Log file for gen2 fragmentation statistics, if we're to log them. */
+    FILE *gc_gen2_stats_log_fh;
+
     /* Are we in GC? Set by the coordinator at entry/exit of GC, and used by
      * native callback handling to decide if it should wait before trying to
      * lookup the current thread as the thread list may move under it. */
@@ -218,6 +246,9 @@ struct MVMInstance {
      * that filled its nursery fastest). */
     MVMThreadContext *thread_to_blame_for_gc;
 
+    /* The largest size a thread's nursery may grow to. */
+    MVMuint32 gc_nursery_max_size;
+
     /* Persistent object ID hash, used to give nursery objects a lifetime
      * unique ID. Plus a lock to protect it. */
     MVMObjectId *object_ids;
@@ -286,39 +317,72 @@ struct MVMInstance {
     MVMint8 spesh_inline_log;
     MVMint8 spesh_osr_enabled;
     MVMint8 spesh_pea_enabled;
+    MVMint8 spesh_licm_enabled;
     MVMint8 spesh_nodelay;
     MVMint8 spesh_blocking;
 
+    /* Flag for if warm frames get baseline JIT-compiled before they are hot
+     * enough to be specialized. */
+    MVMint8 spesh_baseline_enabled;
+
     /* Number of specializations produced, and limit on number of
      * specializations (zero if no limit). */
-    MVMint32 spesh_produced;
+    AO_t spesh_produced;
     MVMint32 spesh_limit;
 
     /* Mutex taken when install specializations. */
     uv_mutex_t mutex_spesh_install;
 
-    /* The thread object representing the spesh thread */
-    MVMObject *spesh_thread;
+    /* The number of specialization worker threads, and the thread objects
+     * representing them. */
+    MVMuint32 spesh_workers;
+    MVMObject **spesh_threads;
 
-    /* The concurrent queue used to send logs to spesh_thread, provided it
-     * is enabled. */
+    /* The concurrent queue used to send logs to the spesh workers, provided
+     * it is enabled. */
     MVMObject *spesh_queue;
 
-    /* The current specialization plan; hung off here so we can mark it. */
-    MVMSpeshPlan *spesh_plan;
+    /* Workers hold this mutex while taking a log from the queue, until they
+     * hold the statistics lock, so that logs are applied to the statistics
+     * in the order they were sent. */
+    uv_mutex_t mutex_spesh_intake;
+
+    /* The statistics lock. It is held for writing while updating the
+     * statistics and planning, and then downgraded to being held for reading
+     * while producing specializations from the plan, since the plan points
+     * into the statistics. Downgrading is done without letting go of the
+     * lock, so no other worker can update the statistics in between. The
+     * mutex protects the state of the lock, and the condition variable is
+     * signalled when it may be possible to take it for writing. */
+    uv_mutex_t mutex_spesh_stats;
+    uv_cond_t cond_spesh_stats;
+    MVMuint32 spesh_stats_readers;
+    MVMuint32 spesh_stats_writing;
 
     /* The latest statistics version (incremented each time a spesh log is
-     * received by the worker thread). */
+     * received by a worker thread). */
     MVMuint32 spesh_stats_version;
 
     /* Lock and condition variable for when something needs to wait for the
-     * specialization worker to finish what it's doing before continuing.
+     * specialization workers to finish what they're doing before continuing.
      * Used by the profiler, which doesn't want the specializer tripping over
-     * frame bytecode changing to instrumented versions. */
+     * frame bytecode changing to instrumented versions. spesh_working is the
+     * number of workers that are busy. */
     uv_mutex_t mutex_spesh_sync;
     uv_cond_t cond_spesh_sync;
     MVMuint32 spesh_working;
 
+    /* Directory to keep the specialization cache in, if any, and the hot
+     * frames to write to it on exit (protected by mutex_spesh_install). */
+    char *spesh_cache_dir;
+    MVM_VECTOR_DECL(MVMSpeshCacheEntry, spesh_cache_entries);
+
+    /* File to dump the statistics of frames we plan specializations for to,
+     * if any, and statistics from an earlier run waiting for the compilation
+     * units they are for to be loaded. */
+    FILE *spesh_stats_dump_fh;
+    MVM_VECTOR_DECL(MVMSpeshPreloadRecord, spesh_preload_records);
+
     /************************************************************************
      * JIT compilation
      ************************************************************************/
@@ -339,6 +403,9 @@ struct MVMInstance {
     /* Directory name for JIT bytecode dumps */
     char *jit_bytecode_dir;
 
+    /* File for logging the ops that made the JIT give up on a frame */
+    FILE *jit_bail_log_fh;
+
     /* sequence number for JIT compiled frames */
     MVMint32 jit_seq_nr;
 
@@ -540,7 +607,8 @@ struct MVMInstance {
 
     MVMDebugServerData *debugserver;
 
-    MVMuint32 speshworker_thread_id;
+    /* The thread IDs of the specialization workers. */
+    MVMuint32 *speshworker_thread_ids;
 
     /* Log file for dynamic var performance, if we're to log it. */
     FILE *dynvar_log_fh;
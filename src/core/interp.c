@@ -494,16 +494,14 @@ void MVM_interp_run(MVMThreadContext *tc, void (*initial_invoke)(MVMThreadContex
                 if (IS_CONCRETE(code) && REPR(code)->ID == MVM_REPR_ID_MVMCode) {
                     MVMStaticFrame *sf = ((MVMCode *)code)->body.sf;
                     MVMuint8 found = 0;
+                    MVMuint32 idx;
                     if (!sf->body.fully_deserialized)
                         MVM_bytecode_finish_frame(tc, sf->body.cu, sf, 0);
-                    if (sf->body.lexical_names) {
-                        MVMLexicalRegistry *entry;
-                        MVM_HASH_GET(tc, sf->body.lexical_names, name, entry);
-                        if (entry && sf->body.lexical_types[entry->value] == MVM_reg_obj) {
-                            MVM_ASSIGN_REF(tc, &(sf->common.header), sf->body.static_env[entry->value].o, val);
-                            sf->body.static_env_flags[entry->value] = (MVMuint8)flag;
-                            found = 1;
-                        }
+                    idx = MVM_get_lexical_by_name(tc, sf, name);
+                    if (idx != MVM_INDEX_HASH_NOT_FOUND && sf->body.lexical_types[idx] == MVM_reg_obj) {
+                        MVM_ASSIGN_REF(tc, &(sf->common.header), sf->body.static_env[idx].o, val);
+                        sf->body.static_env_flags[idx] = (MVMuint8)flag;
+                        found = 1;
                     }
                     if (!found) {
                         char *c_name = MVM_string_utf8_encode_C_string(tc, name);
@@ -2755,16 +2753,10 @@ void MVM_interp_run(MVMThreadContext *tc, void (*initial_invoke)(MVMThreadContex
                 goto NEXT;
             }
             OP(getcurhllsym): {
-                MVMString *hll_name = tc->cur_frame->static_info->body.cu->body.hll_name;
-                GET_REG(cur_op, 0).o = MVM_hll_sym_get(tc, hll_name, GET_REG(cur_op, 2).s);
+                GET_REG(cur_op, 0).o = MVM_hll_sym_get_cur(tc, GET_REG(cur_op, 2).s);
                 cur_op += 4;
                 goto NEXT;
             }
-            OP(sp_gethashentryvalue): {
-                GET_REG(cur_op, 0).o = ((MVMHashEntry *)MVM_BC_get_I64(cur_op, 2))->value;
-                cur_op += 10;
-                goto NEXT;
-            }
             OP(bindcurhllsym): {
                 MVMObject *syms = tc->instance->hll_syms, *hash;
                 MVMString *hll_name = tc->cur_frame->static_info->body.cu->body.hll_name;
@@ -4447,7 +4439,7 @@ void MVM_interp_run(MVMThreadContext *tc, void (*initial_invoke)(MVMThreadContex
                 goto NEXT;
             }
             OP(osrpoint):
-                if (MVM_spesh_log_is_logging(tc))
+                if (MVM_spesh_log_is_logging_osr(tc))
                     MVM_spesh_log_osr(tc);
                 MVM_spesh_osr_poll_for_result(tc);
                 goto NEXT;
@@ -5721,6 +5713,23 @@ void MVM_interp_run(MVMThreadContext *tc, void (*initial_invoke)(MVMThreadContex
                 cur_op += 2;
                 goto NEXT;
             }
+            OP(wsdequepush):
+                MVM_workstealingdeque_push(tc, GET_REG(cur_op, 0).o, GET_REG(cur_op, 2).o);
+                cur_op += 4;
+                goto NEXT;
+            OP(wsdequepop):
+                GET_REG(cur_op, 0).o = MVM_workstealingdeque_pop(tc, GET_REG(cur_op, 2).o);
+                cur_op += 4;
+                goto NEXT;
+            OP(wsdequesteal):
+                GET_REG(cur_op, 0).o = MVM_workstealingdeque_steal(tc, GET_REG(cur_op, 2).o);
+                cur_op += 4;
+                goto NEXT;
+            OP(map_fhb):
+                MVM_io_map_bytes(tc, GET_REG(cur_op, 0).o, GET_REG(cur_op, 2).o,
+                    GET_REG(cur_op, 4).i64);
+                cur_op += 6;
+                goto NEXT;
             OP(sp_guard): {
                 MVMRegister *target = &GET_REG(cur_op, 0);
                 MVMObject *check = GET_REG(cur_op, 2).o;
@@ -5840,6 +5849,15 @@ void MVM_interp_run(MVMThreadContext *tc, void (*initial_invoke)(MVMThreadContex
                     GET_REG(cur_op, 2).o);
                 cur_op += 4;
                 goto NEXT;
+            OP(sp_issf): {
+                MVMObject *check = GET_REG(cur_op, 2).o;
+                MVMStaticFrame *want = (MVMStaticFrame *)tc->cur_frame
+                    ->effective_spesh_slots[GET_UI16(cur_op, 4)];
+                GET_REG(cur_op, 0).i64 = REPR(check)->ID == MVM_REPR_ID_MVMCode &&
+                    ((MVMCode *)check)->body.sf == want;
+                cur_op += 6;
+                goto NEXT;
+            }
             OP(sp_decont): {
                 MVMObject *obj = GET_REG(cur_op, 2).o;
                 MVMRegister *r = &GET_REG(cur_op, 0);
@@ -6440,7 +6458,7 @@ void MVM_interp_run(MVMThreadContext *tc, void (*initial_invoke)(MVMThreadContex
             OP(sp_boolify_iter_hash): {
                 MVMIter *iter = (MVMIter *)GET_REG(cur_op, 2).o;
 
-                GET_REG(cur_op, 0).i64 = iter->body.hash_state.next != NULL ? 1 : 0;
+                GET_REG(cur_op, 0).i64 = MVM_iter_istrue_hash(tc, iter);
 
                 cur_op += 4;
                 goto NEXT;
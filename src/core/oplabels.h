@@ -826,6 +826,10 @@ static const void * const LABELS[] = {
     &&OP_totalmem,
     &&OP_nextdispatcherfor,
     &&OP_takenextdispatcher,
+    &&OP_wsdequepush,
+    &&OP_wsdequepop,
+    &&OP_wsdequesteal,
+    &&OP_map_fhb,
     &&OP_sp_guard,
     &&OP_sp_guardconc,
     &&OP_sp_guardtype,
@@ -837,6 +841,7 @@ static const void * const LABELS[] = {
     &&OP_sp_guardjusttype,
     &&OP_sp_rebless,
     &&OP_sp_resolvecode,
+    &&OP_sp_issf,
     &&OP_sp_decont,
     &&OP_sp_getlex_o,
     &&OP_sp_getlex_ins,
@@ -912,7 +917,6 @@ static const void * const LABELS[] = {
     &&OP_sp_sub_I,
     &&OP_sp_mul_I,
     &&OP_sp_bool_I,
-    &&OP_sp_gethashentryvalue,
     &&OP_prof_enter,
     &&OP_prof_enterspesh,
     &&OP_prof_enterinline,
@@ -1021,10 +1025,6 @@ static const void * const LABELS[] = {
     NULL,
     NULL,
     NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
     &&OP_CALL_EXTOP,
     &&OP_CALL_EXTOP,
     &&OP_CALL_EXTOP,
@@ -826,103 +826,107 @@
 #define MVM_OP_totalmem 822
 #define MVM_OP_nextdispatcherfor 823
 #define MVM_OP_takenextdispatcher 824
-#define MVM_OP_sp_guard 825
-#define MVM_OP_sp_guardconc 826
-#define MVM_OP_sp_guardtype 827
-#define MVM_OP_sp_guardsf 828
-#define MVM_OP_sp_guardsfouter 829
-#define MVM_OP_sp_guardobj 830
-#define MVM_OP_sp_guardnotobj 831
-#define MVM_OP_sp_guardjustconc 832
-#define MVM_OP_sp_guardjusttype 833
-#define MVM_OP_sp_rebless 834
-#define MVM_OP_sp_resolvecode 835
-#define MVM_OP_sp_decont 836
-#define MVM_OP_sp_getlex_o 837
-#define MVM_OP_sp_getlex_ins 838
-#define MVM_OP_sp_getlex_no 839
-#define MVM_OP_sp_bindlex_in 840
-#define MVM_OP_sp_bindlex_os 841
-#define MVM_OP_sp_getarg_o 842
-#define MVM_OP_sp_getarg_i 843
-#define MVM_OP_sp_getarg_n 844
-#define MVM_OP_sp_getarg_s 845
-#define MVM_OP_sp_fastinvoke_v 846
-#define MVM_OP_sp_fastinvoke_i 847
-#define MVM_OP_sp_fastinvoke_n 848
-#define MVM_OP_sp_fastinvoke_s 849
-#define MVM_OP_sp_fastinvoke_o 850
-#define MVM_OP_sp_speshresolve 851
-#define MVM_OP_sp_paramnamesused 852
-#define MVM_OP_sp_getspeshslot 853
-#define MVM_OP_sp_findmeth 854
-#define MVM_OP_sp_fastcreate 855
-#define MVM_OP_sp_get_o 856
-#define MVM_OP_sp_get_i64 857
-#define MVM_OP_sp_get_i32 858
-#define MVM_OP_sp_get_i16 859
-#define MVM_OP_sp_get_i8 860
-#define MVM_OP_sp_get_n 861
-#define MVM_OP_sp_get_s 862
-#define MVM_OP_sp_bind_o 863
-#define MVM_OP_sp_bind_i64 864
-#define MVM_OP_sp_bind_i32 865
-#define MVM_OP_sp_bind_i16 866
-#define MVM_OP_sp_bind_i8 867
-#define MVM_OP_sp_bind_n 868
-#define MVM_OP_sp_bind_s 869
-#define MVM_OP_sp_bind_s_nowb 870
-#define MVM_OP_sp_p6oget_o 871
-#define MVM_OP_sp_p6ogetvt_o 872
-#define MVM_OP_sp_p6ogetvc_o 873
-#define MVM_OP_sp_p6oget_i 874
-#define MVM_OP_sp_p6oget_n 875
-#define MVM_OP_sp_p6oget_s 876
-#define MVM_OP_sp_p6oget_bi 877
-#define MVM_OP_sp_p6obind_o 878
-#define MVM_OP_sp_p6obind_i 879
-#define MVM_OP_sp_p6obind_n 880
-#define MVM_OP_sp_p6obind_s 881
-#define MVM_OP_sp_p6oget_i32 882
-#define MVM_OP_sp_p6obind_i32 883
-#define MVM_OP_sp_getvt_o 884
-#define MVM_OP_sp_getvc_o 885
-#define MVM_OP_sp_fastbox_i 886
-#define MVM_OP_sp_fastbox_bi 887
-#define MVM_OP_sp_fastbox_i_ic 888
-#define MVM_OP_sp_fastbox_bi_ic 889
-#define MVM_OP_sp_deref_get_i64 890
-#define MVM_OP_sp_deref_get_n 891
-#define MVM_OP_sp_deref_bind_i64 892
-#define MVM_OP_sp_deref_bind_n 893
-#define MVM_OP_sp_getlexvia_o 894
-#define MVM_OP_sp_getlexvia_ins 895
-#define MVM_OP_sp_bindlexvia_os 896
-#define MVM_OP_sp_bindlexvia_in 897
-#define MVM_OP_sp_getstringfrom 898
-#define MVM_OP_sp_getwvalfrom 899
-#define MVM_OP_sp_jit_enter 900
-#define MVM_OP_sp_boolify_iter 901
-#define MVM_OP_sp_boolify_iter_arr 902
-#define MVM_OP_sp_boolify_iter_hash 903
-#define MVM_OP_sp_cas_o 904
-#define MVM_OP_sp_atomicload_o 905
-#define MVM_OP_sp_atomicstore_o 906
-#define MVM_OP_sp_add_I 907
-#define MVM_OP_sp_sub_I 908
-#define MVM_OP_sp_mul_I 909
-#define MVM_OP_sp_bool_I 910
-#define MVM_OP_sp_gethashentryvalue 911
-#define MVM_OP_prof_enter 912
-#define MVM_OP_prof_enterspesh 913
-#define MVM_OP_prof_enterinline 914
-#define MVM_OP_prof_enternative 915
-#define MVM_OP_prof_exit 916
-#define MVM_OP_prof_allocated 917
-#define MVM_OP_prof_replaced 918
-#define MVM_OP_ctw_check 919
-#define MVM_OP_coverage_log 920
-#define MVM_OP_breakpoint 921
+#define MVM_OP_wsdequepush 825
+#define MVM_OP_wsdequepop 826
+#define MVM_OP_wsdequesteal 827
+#define MVM_OP_map_fhb 828
+#define MVM_OP_sp_guard 829
+#define MVM_OP_sp_guardconc 830
+#define MVM_OP_sp_guardtype 831
+#define MVM_OP_sp_guardsf 832
+#define MVM_OP_sp_guardsfouter 833
+#define MVM_OP_sp_guardobj 834
+#define MVM_OP_sp_guardnotobj 835
+#define MVM_OP_sp_guardjustconc 836
+#define MVM_OP_sp_guardjusttype 837
+#define MVM_OP_sp_rebless 838
+#define MVM_OP_sp_resolvecode 839
+#define MVM_OP_sp_issf 840
+#define MVM_OP_sp_decont 841
+#define MVM_OP_sp_getlex_o 842
+#define MVM_OP_sp_getlex_ins 843
+#define MVM_OP_sp_getlex_no 844
+#define MVM_OP_sp_bindlex_in 845
+#define MVM_OP_sp_bindlex_os 846
+#define MVM_OP_sp_getarg_o 847
+#define MVM_OP_sp_getarg_i 848
+#define MVM_OP_sp_getarg_n 849
+#define MVM_OP_sp_getarg_s 850
+#define MVM_OP_sp_fastinvoke_v 851
+#define MVM_OP_sp_fastinvoke_i 852
+#define MVM_OP_sp_fastinvoke_n 853
+#define MVM_OP_sp_fastinvoke_s 854
+#define MVM_OP_sp_fastinvoke_o 855
+#define MVM_OP_sp_speshresolve 856
+#define MVM_OP_sp_paramnamesused 857
+#define MVM_OP_sp_getspeshslot 858
+#define MVM_OP_sp_findmeth 859
+#define MVM_OP_sp_fastcreate 860
+#define MVM_OP_sp_get_o 861
+#define MVM_OP_sp_get_i64 862
+#define MVM_OP_sp_get_i32 863
+#define MVM_OP_sp_get_i16 864
+#define MVM_OP_sp_get_i8 865
+#define MVM_OP_sp_get_n 866
+#define MVM_OP_sp_get_s 867
+#define MVM_OP_sp_bind_o 868
+#define MVM_OP_sp_bind_i64 869
+#define MVM_OP_sp_bind_i32 870
+#define MVM_OP_sp_bind_i16 871
+#define MVM_OP_sp_bind_i8 872
+#define MVM_OP_sp_bind_n 873
+#define MVM_OP_sp_bind_s 874
+#define MVM_OP_sp_bind_s_nowb 875
+#define MVM_OP_sp_p6oget_o 876
+#define MVM_OP_sp_p6ogetvt_o 877
+#define MVM_OP_sp_p6ogetvc_o 878
+#define MVM_OP_sp_p6oget_i 879
+#define MVM_OP_sp_p6oget_n 880
+#define MVM_OP_sp_p6oget_s 881
+#define MVM_OP_sp_p6oget_bi 882
+#define MVM_OP_sp_p6obind_o 883
+#define MVM_OP_sp_p6obind_i 884
+#define MVM_OP_sp_p6obind_n 885
+#define MVM_OP_sp_p6obind_s 886
+#define MVM_OP_sp_p6oget_i32 887
+#define MVM_OP_sp_p6obind_i32 888
+#define MVM_OP_sp_getvt_o 889
+#define MVM_OP_sp_getvc_o 890
+#define MVM_OP_sp_fastbox_i 891
+#define MVM_OP_sp_fastbox_bi 892
+#define MVM_OP_sp_fastbox_i_ic 893
+#define MVM_OP_sp_fastbox_bi_ic 894
+#define MVM_OP_sp_deref_get_i64 895
+#define MVM_OP_sp_deref_get_n 896
+#define MVM_OP_sp_deref_bind_i64 897
+#define MVM_OP_sp_deref_bind_n 898
+#define MVM_OP_sp_getlexvia_o 899
+#define MVM_OP_sp_getlexvia_ins 900
+#define MVM_OP_sp_bindlexvia_os 901
+#define MVM_OP_sp_bindlexvia_in 902
+#define MVM_OP_sp_getstringfrom 903
+#define MVM_OP_sp_getwvalfrom 904
+#define MVM_OP_sp_jit_enter 905
+#define MVM_OP_sp_boolify_iter 906
+#define MVM_OP_sp_boolify_iter_arr 907
+#define MVM_OP_sp_boolify_iter_hash 908
+#define MVM_OP_sp_cas_o 909
+#define MVM_OP_sp_atomicload_o 910
+#define MVM_OP_sp_atomicstore_o 911
+#define MVM_OP_sp_add_I 912
+#define MVM_OP_sp_sub_I 913
+#define MVM_OP_sp_mul_I 914
+#define MVM_OP_sp_bool_I 915
+#define MVM_OP_prof_enter 916
+#define MVM_OP_prof_enterspesh 917
+#define MVM_OP_prof_enterinline 918
+#define MVM_OP_prof_enternative 919
+#define MVM_OP_prof_exit 920
+#define MVM_OP_prof_allocated 921
+#define MVM_OP_prof_replaced 922
+#define MVM_OP_ctw_check 923
+#define MVM_OP_coverage_log 924
+#define MVM_OP_breakpoint 925
 
 #define MVM_OP_EXT_BASE 1024
 #define MVM_OP_EXT_CU_LIMIT 1024
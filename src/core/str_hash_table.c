@@ -0,0 +1,212 @@
+#include "moar.h"
+
+MVM_STATIC_INLINE size_t index_alloc_size(MVMuint8 size_log2) {
+    size_t buckets = (size_t)1 << size_log2;
+    return buckets * sizeof(MVMStrHashBucket) + buckets;
+}
+
+static void allocate_index(MVMThreadContext *tc, MVMStrHashTable *hashtable, MVMuint8 size_log2) {
+    size_t buckets = (size_t)1 << size_log2;
+    char *memory = MVM_fixed_size_alloc_zeroed(tc, tc->instance->fsa,
+        index_alloc_size(size_log2));
+    hashtable->buckets            = (MVMStrHashBucket *)memory;
+    hashtable->metadata           = (MVMuint8 *)(memory + buckets * sizeof(MVMStrHashBucket));
+    hashtable->official_size_log2 = size_log2;
+    hashtable->key_right_shift    = 64 - size_log2;
+    hashtable->max_items          = (MVMuint32)(buckets
+        * MVM_STR_HASH_LOAD_FACTOR_NUM / MVM_STR_HASH_LOAD_FACTOR_DEN);
+}
+
+static void free_index(MVMThreadContext *tc, MVMStrHashTable *hashtable) {
+    if (hashtable->buckets)
+        MVM_fixed_size_free(tc, tc->instance->fsa,
+            index_alloc_size(hashtable->official_size_log2), hashtable->buckets);
+    hashtable->buckets  = NULL;
+    hashtable->metadata = NULL;
+}
+
+/* Finds the smallest index size that can hold the specified number of items
+ * without needing to grow. */
+static MVMuint8 size_log2_for(MVMuint32 items) {
+    MVMuint8 size_log2 = MVM_STR_HASH_MIN_SIZE_LOG2;
+    while (((MVMuint64)1 << size_log2) * MVM_STR_HASH_LOAD_FACTOR_NUM
+            / MVM_STR_HASH_LOAD_FACTOR_DEN <= items)
+        size_log2++;
+    return size_log2;
+}
+
+/* Inserts the entry at the given position into the index, displacing entries
+ * that are closer to their ideal bucket as we go. Returns zero if we would
+ * exceed the maximum probe distance, in which case the index is in an
+ * inconsistent state and must be rebuilt at a larger size. */
+static int insert_into_index(MVMThreadContext *tc, MVMStrHashTable *hashtable, MVMuint32 pos, MVMuint64 hash) {
+    MVMuint32 mask   = MVM_str_hash_mask(hashtable);
+    MVMuint32 bucket = MVM_str_hash_bucket(hashtable, hash);
+    MVMuint32 probe  = 1;
+    MVMStrHashBucket carry;
+    carry.entry   = pos;
+    carry.hash_lo = (MVMuint32)hash;
+    while (1) {
+        MVMuint32 distance = hashtable->metadata[bucket];
+        if (distance == 0) {
+            hashtable->buckets[bucket]  = carry;
+            hashtable->metadata[bucket] = (MVMuint8)probe;
+            return 1;
+        }
+        if (distance < probe) {
+            /* Take from the rich; carry on inserting what was here. */
+            MVMStrHashBucket displaced  = hashtable->buckets[bucket];
+            hashtable->buckets[bucket]  = carry;
+            hashtable->metadata[bucket] = (MVMuint8)probe;
+            carry = displaced;
+            probe = distance;
+        }
+        bucket = (bucket + 1) & mask;
+        if (++probe > MVM_STR_HASH_MAX_PROBE_DISTANCE)
+            return 0;
+    }
+}
+
+/* (Re)builds the index from the entries, which are the source of truth. Used
+ * when growing the index and after compacting the entries. */
+static void rebuild_index(MVMThreadContext *tc, MVMStrHashTable *hashtable, MVMuint8 size_log2) {
+    while (1) {
+        MVMuint32 pos;
+        int ok = 1;
+        free_index(tc, hashtable);
+        allocate_index(tc, hashtable, size_log2);
+        for (pos = 0; pos < hashtable->num_entries; pos++) {
+            MVMStrHashHandle *entry = MVM_str_hash_entry_at(hashtable, pos);
+            if (entry->key && !insert_into_index(tc, hashtable, pos,
+                    MVM_str_hash_code(tc, entry->key))) {
+                ok = 0;
+                break;
+            }
+        }
+        if (ok)
+            return;
+        size_log2++;
+    }
+}
+
+/* Squeezes out deleted entries, keeping the live ones in insertion order. */
+static void compact_entries(MVMThreadContext *tc, MVMStrHashTable *hashtable) {
+    MVMuint32 from, to = 0;
+    for (from = 0; from < hashtable->num_entries; from++) {
+        MVMStrHashHandle *entry = MVM_str_hash_entry_at(hashtable, from);
+        if (entry->key) {
+            if (from != to)
+                memcpy(MVM_str_hash_entry_at(hashtable, to), entry, hashtable->entry_size);
+            to++;
+        }
+    }
+    hashtable->num_entries = to;
+    rebuild_index(tc, hashtable, hashtable->official_size_log2);
+}
+
+/* Makes sure there is space to append an entry. If a good part of the entries
+ * are deleted ones, we compact instead of growing. */
+static void make_room_for_entry(MVMThreadContext *tc, MVMStrHashTable *hashtable) {
+    MVMuint32 deleted = hashtable->num_entries - hashtable->cur_items;
+    if (deleted && deleted >= hashtable->num_entries / 4) {
+        compact_entries(tc, hashtable);
+    }
+    else {
+        MVMuint32 new_alloc = hashtable->alloc_entries
+            ? hashtable->alloc_entries * 2
+            : 1 << MVM_STR_HASH_MIN_SIZE_LOG2;
+        hashtable->entries = MVM_fixed_size_realloc(tc, tc->instance->fsa,
+            hashtable->entries,
+            (size_t)hashtable->alloc_entries * hashtable->entry_size,
+            (size_t)new_alloc * hashtable->entry_size);
+        hashtable->alloc_entries = new_alloc;
+    }
+}
+
+/* Sets up an empty table holding entries of the specified size (which must
+ * include the MVMStrHashHandle at the start). If we know how many entries
+ * there will be, we can size for them up front. */
+void MVM_str_hash_build(MVMThreadContext *tc, MVMStrHashTable *hashtable, MVMuint32 entry_size, MVMuint32 entries) {
+    memset(hashtable, 0, sizeof(MVMStrHashTable));
+    hashtable->entry_size = entry_size;
+    if (entries) {
+        hashtable->entries = MVM_fixed_size_alloc(tc, tc->instance->fsa,
+            (size_t)entries * entry_size);
+        hashtable->alloc_entries = entries;
+        allocate_index(tc, hashtable, size_log2_for(entries));
+    }
+}
+
+/* Frees the memory held by the table, leaving it empty and unbuilt. */
+void MVM_str_hash_demolish(MVMThreadContext *tc, MVMStrHashTable *hashtable) {
+    if (hashtable->entries)
+        MVM_fixed_size_free(tc, tc->instance->fsa,
+            (size_t)hashtable->alloc_entries * hashtable->entry_size,
+            hashtable->entries);
+    free_index(tc, hashtable);
+    memset(hashtable, 0, sizeof(MVMStrHashTable));
+}
+
+void * MVM_str_hash_lvalue_fetch_nocheck(MVMThreadContext *tc, MVMStrHashTable *hashtable, MVMString *key) {
+    MVMStrHashHandle *entry;
+    MVMuint32 pos;
+    if (MVM_UNLIKELY(!hashtable->entry_size))
+        MVM_oops(tc, "Attempt to insert into a hash table that was not built");
+
+    entry = MVM_str_hash_fetch_nocheck(tc, hashtable, key);
+    if (entry)
+        return entry;
+
+    /* Need a new entry; make sure there's space for it and its bucket. */
+    if (hashtable->num_entries == hashtable->alloc_entries)
+        make_room_for_entry(tc, hashtable);
+    if (!hashtable->buckets)
+        allocate_index(tc, hashtable, MVM_STR_HASH_MIN_SIZE_LOG2);
+    else if (hashtable->cur_items >= hashtable->max_items)
+        rebuild_index(tc, hashtable, hashtable->official_size_log2 + 1);
+
+    pos   = hashtable->num_entries++;
+    entry = MVM_str_hash_entry_at(hashtable, pos);
+    memset(entry, 0, hashtable->entry_size);
+    entry->key = key;
+    hashtable->cur_items++;
+    if (!insert_into_index(tc, hashtable, pos, MVM_str_hash_code(tc, key)))
+        rebuild_index(tc, hashtable, hashtable->official_size_log2 + 1);
+    return entry;
+}
+
+void MVM_str_hash_delete_nocheck(MVMThreadContext *tc, MVMStrHashTable *hashtable, MVMString *key) {
+    MVMint64 found = MVM_str_hash_find_bucket(tc, hashtable, key);
+    MVMuint32 bucket, next, mask;
+    if (found < 0)
+        return;
+
+    /* Clear the entry; a NULL key marks it as deleted. */
+    bucket = (MVMuint32)found;
+    memset(MVM_str_hash_entry_at(hashtable, hashtable->buckets[bucket].entry),
+        0, hashtable->entry_size);
+    hashtable->cur_items--;
+
+    /* Backward shift deletion: pull following buckets one step closer to
+     * their ideal position until we hit an empty one or one already there. */
+    mask = MVM_str_hash_mask(hashtable);
+    next = (bucket + 1) & mask;
+    while (hashtable->metadata[next] > 1) {
+        hashtable->buckets[bucket]  = hashtable->buckets[next];
+        hashtable->metadata[bucket] = hashtable->metadata[next] - 1;
+        bucket = next;
+        next   = (next + 1) & mask;
+    }
+    hashtable->metadata[bucket] = 0;
+
+    /* Deleted entries at the end can just be dropped. */
+    while (hashtable->num_entries
+            && !((MVMStrHashHandle *)MVM_str_hash_entry_at(hashtable,
+                hashtable->num_entries - 1))->key)
+        hashtable->num_entries--;
+}
+
+void MVM_str_hash_key_throw_invalid(MVMThreadContext *tc, MVMObject *key) {
+    MVM_exception_throw_adhoc(tc, "Hash keys must be concrete strings (got %s)",
+        MVM_6model_get_debug_name(tc, key));
+}
@@ -0,0 +1,84 @@
+/* An open-addressing hash table keyed on MVMString, used for VM-level hashes.
+ *
+ * The table is split in two parts:
+ *
+ *  - The entries, stored contiguously in insertion order. Each entry is
+ *    entry_size bytes and starts with an MVMStrHashHandle (that is, the key).
+ *    Deleting an entry leaves a hole (an entry with a NULL key) behind, which
+ *    is squeezed out the next time we would need to grow the entry storage.
+ *    Iterating the entries in order gives us insertion order iteration.
+ *
+ *  - The index, a Robin Hood hashed array of buckets. For each bucket we keep
+ *    a byte of metadata (the probe distance plus one, or 0 if the bucket is
+ *    empty), together with the position of the entry it points at and the low
+ *    32 bits of the key's hash code. The metadata lives in its own array, so
+ *    that a probe sequence is a short linear scan of bytes, and we only go to
+ *    the entry itself (and compare the strings) when the hash bits match.
+ *
+ * Keys are not copied; the table holds MVMString pointers, and anything that
+ * embeds a table must mark them (and whatever else is in the entries) in its
+ * gc_mark. A table that has all fields zeroed is valid and empty, but must be
+ * set up with MVM_str_hash_build before anything is inserted. */
+
+/* Every entry stored in an MVMStrHashTable must start with one of these. */
+struct MVMStrHashHandle {
+    MVMString *key;
+};
+
+/* A bucket in the index. */
+struct MVMStrHashBucket {
+    /* Position of the entry in the entries array. */
+    MVMuint32 entry;
+    /* The low bits of the key's hash code, to avoid most string compares. */
+    MVMuint32 hash_lo;
+};
+
+struct MVMStrHashTable {
+    /* Entries, in insertion order; num_entries of alloc_entries are used. */
+    char *entries;
+
+    /* The index; buckets and metadata are a single allocation, with the
+     * metadata bytes following the buckets. */
+    MVMStrHashBucket *buckets;
+    MVMuint8 *metadata;
+
+    /* The size of each entry, including the MVMStrHashHandle. */
+    MVMuint32 entry_size;
+
+    /* The number of live (not deleted) entries. */
+    MVMuint32 cur_items;
+
+    /* The number of entries used (live and deleted) and allocated. */
+    MVMuint32 num_entries;
+    MVMuint32 alloc_entries;
+
+    /* Once cur_items reaches this, we grow the index. */
+    MVMuint32 max_items;
+
+    /* log2 of the number of buckets in the index, and the shift to take a
+     * 64 bit hash code down to a bucket number. */
+    MVMuint8 official_size_log2;
+    MVMuint8 key_right_shift;
+};
+
+/* Iteration state; just a position in the entries array. */
+struct MVMStrHashIterator {
+    MVMuint32 pos;
+};
+
+/* Load factor, as a fraction of the number of buckets. */
+#define MVM_STR_HASH_LOAD_FACTOR_NUM 3
+#define MVM_STR_HASH_LOAD_FACTOR_DEN 4
+
+/* The smallest index we create; must be a power of two. */
+#define MVM_STR_HASH_MIN_SIZE_LOG2 3
+
+/* Probe distances are kept in a byte; if an insert would need to probe
+ * further than this, we grow the index instead. */
+#define MVM_STR_HASH_MAX_PROBE_DISTANCE 255
+
+void MVM_str_hash_build(MVMThreadContext *tc, MVMStrHashTable *hashtable, MVMuint32 entry_size, MVMuint32 entries);
+void MVM_str_hash_demolish(MVMThreadContext *tc, MVMStrHashTable *hashtable);
+void * MVM_str_hash_lvalue_fetch_nocheck(MVMThreadContext *tc, MVMStrHashTable *hashtable, MVMString *key);
+void MVM_str_hash_delete_nocheck(MVMThreadContext *tc, MVMStrHashTable *hashtable, MVMString *key);
+MVM_NO_RETURN void MVM_str_hash_key_throw_invalid(MVMThreadContext *tc, MVMObject *key) MVM_NO_RETURN_ATTRIBUTE;
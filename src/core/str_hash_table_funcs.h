@@ -0,0 +1,134 @@
+/* Inline functions for MVMStrHashTable; see str_hash_table.h for how the
+ * table is laid out. These live in their own header as they need the string
+ * ops, which are declared after the REPR headers that embed the table. */
+
+/* Fibonacci hashing: multiply by 2**64 / phi and take the top bits. */
+#define MVM_STR_HASH_FIB UINT64_C(11400714819323198485)
+
+MVM_STATIC_INLINE MVMuint64 MVM_str_hash_code(MVMThreadContext *tc, MVMString *key) {
+    if (!key->body.cached_hash_code)
+        MVM_string_compute_hash_code(tc, key);
+    return key->body.cached_hash_code;
+}
+
+MVM_STATIC_INLINE MVMuint32 MVM_str_hash_bucket(MVMStrHashTable *hashtable, MVMuint64 hash) {
+    return (MVMuint32)((hash * MVM_STR_HASH_FIB) >> hashtable->key_right_shift);
+}
+
+MVM_STATIC_INLINE MVMuint32 MVM_str_hash_mask(MVMStrHashTable *hashtable) {
+    return (1 << hashtable->official_size_log2) - 1;
+}
+
+MVM_STATIC_INLINE void * MVM_str_hash_entry_at(MVMStrHashTable *hashtable, MVMuint32 pos) {
+    return hashtable->entries + (size_t)pos * hashtable->entry_size;
+}
+
+MVM_STATIC_INLINE MVMuint32 MVM_str_hash_entry_size(MVMThreadContext *tc, MVMStrHashTable *hashtable) {
+    return hashtable->entry_size;
+}
+
+MVM_STATIC_INLINE MVMuint32 MVM_str_hash_count(MVMThreadContext *tc, MVMStrHashTable *hashtable) {
+    return hashtable->cur_items;
+}
+
+MVM_STATIC_INLINE int MVM_str_hash_key_is_valid(MVMThreadContext *tc, MVMObject *key) {
+    return !MVM_is_null(tc, key) && REPR(key)->ID == MVM_REPR_ID_MVMString && IS_CONCRETE(key);
+}
+
+MVM_STATIC_INLINE int MVM_str_hash_keys_equal(MVMThreadContext *tc, MVMString *a, MVMString *b) {
+    return a == b || (a->body.num_graphs == b->body.num_graphs
+        && MVM_string_substrings_equal_nocheck(tc, a, 0, a->body.num_graphs, b, 0));
+}
+
+/* Looks up the bucket holding the key; returns the bucket number, or -1 if
+ * the key is not in the table. */
+MVM_STATIC_INLINE MVMint64 MVM_str_hash_find_bucket(MVMThreadContext *tc, MVMStrHashTable *hashtable, MVMString *key) {
+    MVMuint64 hash;
+    MVMuint32 bucket, mask, probe;
+    if (MVM_UNLIKELY(hashtable->cur_items == 0))
+        return -1;
+    hash   = MVM_str_hash_code(tc, key);
+    bucket = MVM_str_hash_bucket(hashtable, hash);
+    mask   = MVM_str_hash_mask(hashtable);
+    probe  = 1;
+    while (1) {
+        MVMuint32 distance = hashtable->metadata[bucket];
+        /* Robin Hood invariant: had the key been here, it would have taken
+         * this bucket over from an entry closer to its ideal position. */
+        if (distance < probe)
+            return -1;
+        if (distance == probe && hashtable->buckets[bucket].hash_lo == (MVMuint32)hash) {
+            MVMStrHashHandle *entry = MVM_str_hash_entry_at(hashtable,
+                hashtable->buckets[bucket].entry);
+            if (MVM_str_hash_keys_equal(tc, key, entry->key))
+                return bucket;
+        }
+        bucket = (bucket + 1) & mask;
+        probe++;
+    }
+}
+
+/* Fetches the entry for a key, or NULL if there is none. The key must be a
+ * concrete MVMString. */
+MVM_STATIC_INLINE void * MVM_str_hash_fetch_nocheck(MVMThreadContext *tc, MVMStrHashTable *hashtable, MVMString *key) {
+    MVMint64 bucket = MVM_str_hash_find_bucket(tc, hashtable, key);
+    return bucket < 0
+        ? NULL
+        : MVM_str_hash_entry_at(hashtable, hashtable->buckets[bucket].entry);
+}
+
+/* As above, but throws if the key is not a concrete string. */
+MVM_STATIC_INLINE void * MVM_str_hash_fetch(MVMThreadContext *tc, MVMStrHashTable *hashtable, MVMString *key) {
+    if (MVM_UNLIKELY(!MVM_str_hash_key_is_valid(tc, (MVMObject *)key)))
+        MVM_str_hash_key_throw_invalid(tc, (MVMObject *)key);
+    return MVM_str_hash_fetch_nocheck(tc, hashtable, key);
+}
+
+/* Fetches the entry for a key, creating it if needed. A new entry has its
+ * key set and everything else zeroed. The table must have been built. */
+MVM_STATIC_INLINE void * MVM_str_hash_lvalue_fetch(MVMThreadContext *tc, MVMStrHashTable *hashtable, MVMString *key) {
+    if (MVM_UNLIKELY(!MVM_str_hash_key_is_valid(tc, (MVMObject *)key)))
+        MVM_str_hash_key_throw_invalid(tc, (MVMObject *)key);
+    return MVM_str_hash_lvalue_fetch_nocheck(tc, hashtable, key);
+}
+
+MVM_STATIC_INLINE void MVM_str_hash_delete(MVMThreadContext *tc, MVMStrHashTable *hashtable, MVMString *key) {
+    if (MVM_UNLIKELY(!MVM_str_hash_key_is_valid(tc, (MVMObject *)key)))
+        MVM_str_hash_key_throw_invalid(tc, (MVMObject *)key);
+    MVM_str_hash_delete_nocheck(tc, hashtable, key);
+}
+
+/* Iteration is in insertion order. Deleting entries while iterating is fine;
+ * inserting may compact the entries, after which an iterator may skip or
+ * revisit entries. */
+MVM_STATIC_INLINE MVMStrHashIterator MVM_str_hash_skip_deleted(MVMThreadContext *tc, MVMStrHashTable *hashtable, MVMStrHashIterator iterator) {
+    while (iterator.pos < hashtable->num_entries
+            && !((MVMStrHashHandle *)MVM_str_hash_entry_at(hashtable, iterator.pos))->key)
+        iterator.pos++;
+    return iterator;
+}
+
+MVM_STATIC_INLINE MVMStrHashIterator MVM_str_hash_first(MVMThreadContext *tc, MVMStrHashTable *hashtable) {
+    MVMStrHashIterator iterator;
+    iterator.pos = 0;
+    return MVM_str_hash_skip_deleted(tc, hashtable, iterator);
+}
+
+MVM_STATIC_INLINE MVMStrHashIterator MVM_str_hash_next(MVMThreadContext *tc, MVMStrHashTable *hashtable, MVMStrHashIterator iterator) {
+    iterator.pos++;
+    return MVM_str_hash_skip_deleted(tc, hashtable, iterator);
+}
+
+MVM_STATIC_INLINE int MVM_str_hash_at_end(MVMThreadContext *tc, MVMStrHashTable *hashtable, MVMStrHashIterator iterator) {
+    return iterator.pos >= hashtable->num_entries;
+}
+
+/* Gets the entry an iterator points at; returns NULL if it is past the end
+ * or the entry was deleted since the iterator got there. */
+MVM_STATIC_INLINE void * MVM_str_hash_current(MVMThreadContext *tc, MVMStrHashTable *hashtable, MVMStrHashIterator iterator) {
+    MVMStrHashHandle *entry;
+    if (iterator.pos >= hashtable->num_entries)
+        return NULL;
+    entry = MVM_str_hash_entry_at(hashtable, iterator.pos);
+    return entry->key ? entry : NULL;
+}
@@ -111,6 +111,13 @@ struct MVMThreadContext {
     MVMuint32 nursery_fromspace_size;
     MVMuint32 nursery_tospace_size;
 
+    /* What we use to adapt the nursery size: the percentage of it that
+     * survived the last collection, the number of collections in a row that
+     * found it mostly empty, and when this thread last caused a GC run. */
+    MVMuint32 nursery_survival_percent;
+    MVMuint32 nursery_idle_collections;
+    MVMuint64 nursery_last_blamed_time;
+
     /* Non-zero is we should allocate in gen2; incremented/decremented as we
      * enter/leave a region wanting gen2 allocation. */
     MVMuint32 allocate_in_gen2;
@@ -135,6 +142,16 @@ struct MVMThreadContext {
     MVMuint32             alloc_gen2roots;
     MVMCollectable      **gen2roots;
 
+    /* While generation 2 is being marked incrementally, the objects that are
+     * yet to be scanned (the grey list), and those that the full collection
+     * must visit again in its final remark. See gc/incremental.c. */
+    MVMuint32             num_gen2_grey;
+    MVMuint32             alloc_gen2_grey;
+    MVMCollectable      **gen2_grey;
+    MVMuint32             num_gen2_remark;
+    MVMuint32             alloc_gen2_remark;
+    MVMCollectable      **gen2_remark;
+
     /* Finalize queue objects, which need to have a finalizer invoked once
      * they are no longer referenced from anywhere except this queue. */
     MVMuint32             num_finalize;
@@ -237,6 +254,12 @@ struct MVMThreadContext {
      * optimization process, giving less GC latency. */
     MVMSpeshGraph *spesh_active_graph;
 
+    /* If this is a spesh worker, the plan it is currently producing
+     * specializations from, so we can mark it, and the number of the
+     * specialization it is currently producing. */
+    MVMSpeshPlan *spesh_plan;
+    MVMint32 spesh_produced;
+
     /* We try to do better at OSR by creating a fresh log when we enter a new
      * compilation unit. However, for things that EVAL or do a ton of BEGIN,
      * we risk high memory use. Use this to throttle it by limiting the number
@@ -589,7 +589,7 @@ MVM_PUBLIC void MVM_debugserver_notify_unhandled_exception(MVMThreadContext *tc,
 }
 
 static MVMuint8 is_thread_id_eligible(MVMInstance *vm, MVMuint32 id) {
-    if (id == vm->debugserver->thread_id || id == vm->speshworker_thread_id) {
+    if (id == vm->debugserver->thread_id || MVM_spesh_worker_is_worker_thread(vm, id)) {
         return 0;
     }
     return 1;
@@ -936,7 +936,7 @@ static void send_is_execution_suspended_info(MVMThreadContext *dtc, cmp_ctx_t *c
     while (cur_thread) {
         if ((MVM_load(&cur_thread->body.tc->gc_status) & MVMSUSPENDSTATUS_MASK) != MVMSuspendState_SUSPENDED
                 && cur_thread->body.thread_id != vm->debugserver->thread_id
-                && cur_thread->body.thread_id != vm->speshworker_thread_id) {
+                && !MVM_spesh_worker_is_worker_thread(vm, cur_thread->body.thread_id)) {
             result = 0;
             break;
         }
@@ -1407,7 +1407,6 @@ static MVMint32 request_context_lexicals(MVMThreadContext *dtc, cmp_ctx_t *ctx,
         ? find_handle_target(dtc, argument->handle_id)
         : dtc->instance->VMNull;
     MVMStaticFrame *static_info;
-    MVMLexicalRegistry *lexical_names;
     MVMStaticFrameDebugLocal *debug_locals;
 
     MVMFrame *frame;
@@ -1423,21 +1422,18 @@ static MVMint32 request_context_lexicals(MVMThreadContext *dtc, cmp_ctx_t *ctx,
     }
 
     static_info = frame->static_info;
-    lexical_names = static_info->body.lexical_names;
     debug_locals = static_info->body.instrumentation
         ? static_info->body.instrumentation->debug_locals
         : NULL;
-    if (lexical_names || debug_locals) {
-        MVMLexicalRegistry *entry;
+    if (static_info->body.num_lexicals || debug_locals) {
         MVMStaticFrameDebugLocal *debug_entry;
-        MVMuint64 lexical_index = 0;
+        MVMuint64 lexical_index;
 
         /* Count up total number of symbols; that is, the lexicals plus the
          * debug names where the names to not overlap with the lexicals. */
         MVMuint64 lexcount = static_info->body.num_lexicals;
         HASH_ITER(dtc, hash_handle, debug_locals, debug_entry, {
-            MVM_HASH_GET(dtc, lexical_names, debug_entry->name, entry);
-            if (!entry)
+            if (MVM_get_lexical_by_name(dtc, static_info, debug_entry->name) == MVM_INDEX_HASH_NOT_FOUND)
                 lexcount++;
         });
 
@@ -1453,17 +1449,18 @@ static MVMint32 request_context_lexicals(MVMThreadContext *dtc, cmp_ctx_t *ctx,
         if (dtc->instance->debugserver->debugspam_protocol)
             fprintf(stderr, "will write %"PRIu64" lexicals\n", lexcount);
 
-        HASH_ITER(dtc, hash_handle, lexical_names, entry, {
-            MVMuint16 lextype = static_info->body.lexical_types[entry->value];
-            MVMRegister *result = &frame->env[entry->value];
+        for (lexical_index = 0; lexical_index < static_info->body.num_lexicals; lexical_index++) {
+            MVMString *name = static_info->body.lexical_names_list[lexical_index];
+            MVMuint16 lextype = static_info->body.lexical_types[lexical_index];
+            MVMRegister *result = &frame->env[lexical_index];
             char *c_key_name;
             MVMint32 was_from_local = 0;
-            if (entry->key && IS_CONCRETE(entry->key)) {
+            if (name && IS_CONCRETE(name)) {
                 /* Lexical has a name (should always be the case, really). Check
                  * there is no debug local override for it (which means the lexical
                  * was lowered into a local, but preserved for some reason). */
-                c_key_name = MVM_string_utf8_encode_C_string(dtc, entry->key);
-                MVM_HASH_GET_FREE(dtc, debug_locals, entry->key, debug_entry, {
+                c_key_name = MVM_string_utf8_encode_C_string(dtc, name);
+                MVM_HASH_GET_FREE(dtc, debug_locals, name, debug_entry, {
                     MVM_free(c_key_name);
                 });
                 if (debug_entry && static_info->body.local_types[debug_entry->local_idx] == lextype) {
@@ -1477,17 +1474,15 @@ static MVMint32 request_context_lexicals(MVMThreadContext *dtc, cmp_ctx_t *ctx,
             }
             if (!was_from_local && lextype == MVM_reg_obj && !result->o) {
                 /* XXX this can't allocate? */
-                MVM_frame_vivify_lexical(dtc, frame, entry->value);
+                MVM_frame_vivify_lexical(dtc, frame, lexical_index);
             }
             write_one_context_lexical(dtc, ctx, c_key_name, lextype, result);
             if (dtc->instance->debugserver->debugspam_protocol)
                 fprintf(stderr, "wrote a lexical\n");
-            lexical_index++;
-        });
+        }
 
         HASH_ITER(dtc, hash_handle, debug_locals, debug_entry, {
-            MVM_HASH_GET(dtc, lexical_names, debug_entry->name, entry);
-            if (!entry) {
+            if (MVM_get_lexical_by_name(dtc, static_info, debug_entry->name) == MVM_INDEX_HASH_NOT_FOUND) {
                 char *c_key_name = MVM_string_utf8_encode_C_string(dtc, debug_entry->name);
                 MVMRegister *result = &frame->work[debug_entry->local_idx];
                 MVMuint16 lextype = static_info->body.local_types[debug_entry->local_idx];
@@ -1850,29 +1845,27 @@ static MVMint32 request_object_metadata(MVMThreadContext *dtc, cmp_ctx_t *ctx, r
 
         if (IS_CONCRETE(target)) {
             MVMHashBody *body = (MVMHashBody *)OBJECT_BODY(target);
-            MVMHashEntry *handle = body->hash_head;
-            UT_hash_table *tbl = handle ? body->hash_head->hash_handle.tbl : 0;
-
-            if (tbl) {
-                cmp_write_str(ctx, "mvmhash_num_buckets", 19);
-                cmp_write_int(ctx, tbl->num_buckets);
-                cmp_write_str(ctx, "mvmhash_num_items", 17);
-                cmp_write_int(ctx, tbl->num_items);
-                cmp_write_str(ctx, "mvmhash_nonideal_items", 22);
-                cmp_write_int(ctx, tbl->nonideal_items);
-                cmp_write_str(ctx, "mvmhash_ineff_expands", 21);
-                cmp_write_int(ctx, tbl->ineff_expands);
-            }
-            else {
-                cmp_write_str(ctx, "mvmhash_num_buckets", 19);
-                cmp_write_int(ctx, 0);
-                cmp_write_str(ctx, "mvmhash_num_items", 17);
-                cmp_write_int(ctx, 0);
-                cmp_write_str(ctx, "mvmhash_nonideal_items", 22);
-                cmp_write_int(ctx, 0);
-                cmp_write_str(ctx, "mvmhash_ineff_expands", 21);
-                cmp_write_int(ctx, 0);
-            }
+            MVMStrHashTable *hashtable = &(body->hashtable);
+            MVMuint32 num_buckets = hashtable->buckets
+                ? 1 << hashtable->official_size_log2
+                : 0;
+            MVMuint32 nonideal_items = 0;
+            MVMuint32 i;
+
+            /* Items that had to probe past their ideal bucket. */
+            for (i = 0; i < num_buckets; i++)
+                if (hashtable->metadata[i] > 1)
+                    nonideal_items++;
+
+            cmp_write_str(ctx, "mvmhash_num_buckets", 19);
+            cmp_write_int(ctx, num_buckets);
+            cmp_write_str(ctx, "mvmhash_num_items", 17);
+            cmp_write_int(ctx, MVM_str_hash_count(dtc, hashtable));
+            cmp_write_str(ctx, "mvmhash_nonideal_items", 22);
+            cmp_write_int(ctx, nonideal_items);
+            /* The open addressing table never gives up on expanding. */
+            cmp_write_str(ctx, "mvmhash_ineff_expands", 21);
+            cmp_write_int(ctx, 0);
         }
 
         write_object_features(dtc, ctx, 0, 0, 1);
@@ -2157,9 +2150,10 @@ static MVMint32 request_object_associatives(MVMThreadContext *dtc, cmp_ctx_t *ct
 
     if (REPR(target)->ID == MVM_REPR_ID_MVMHash) {
         MVMHashBody *body = (MVMHashBody *)OBJECT_BODY(target);
-        MVMuint64 count = HASH_CNT(hash_handle, body->hash_head);
+        MVMStrHashTable *hashtable = &(body->hashtable);
+        MVMuint64 count = MVM_str_hash_count(dtc, hashtable);
 
-        MVMHashEntry *entry = NULL;
+        MVMStrHashIterator iterator = MVM_str_hash_first(dtc, hashtable);
 
         cmp_write_map(ctx, 4);
         cmp_write_str(ctx, "id", 2);
@@ -2173,7 +2167,8 @@ static MVMint32 request_object_associatives(MVMThreadContext *dtc, cmp_ctx_t *ct
         cmp_write_str(ctx, "contents", 8);
         cmp_write_map(ctx, count);
 
-        HASH_ITER(dtc, hash_handle, body->hash_head, entry, {
+        while (!MVM_str_hash_at_end(dtc, hashtable, iterator)) {
+            MVMHashEntry *entry = MVM_str_hash_current(dtc, hashtable, iterator);
             char *key = MVM_string_utf8_encode_C_string(dtc, entry->hash_handle.key);
             MVMObject *value = entry->value;
             char *value_debug_name = value ? MVM_6model_get_debug_name(dtc, value) : "VMNull";
@@ -2198,7 +2193,8 @@ static MVMint32 request_object_associatives(MVMThreadContext *dtc, cmp_ctx_t *ct
                 cmp_write_bool(ctx, STABLE(value)->container_spec == NULL ? 0 : 1);
 
             MVM_free(key);
-        });
+            iterator = MVM_str_hash_next(dtc, hashtable, iterator);
+        }
     }
 
     return 0;
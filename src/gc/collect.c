@@ -18,6 +18,9 @@ static void process_worklist(MVMThreadContext *tc, MVMGCWorklist *worklist, Work
 static void pass_work_item(MVMThreadContext *tc, WorkToPass *wtp, MVMCollectable **item_ptr);
 static void pass_leftover_work(MVMThreadContext *tc, WorkToPass *wtp);
 static void add_in_tray_to_worklist(MVMThreadContext *tc, MVMGCWorklist *worklist);
+static void add_shared_work_to_worklist(MVMThreadContext *tc, MVMGCWorklist *worklist);
+static void share_work(MVMThreadContext *tc, MVMGCWorklist *worklist);
+static void remark(MVMThreadContext *tc, MVMGCWorklist *worklist, WorkToPass *wtp, MVMCollectable **items, MVMuint32 num_items);
 
 /* The size of the nursery that a new thread should get. The main thread will
  * get a full-size one right away. */
@@ -29,6 +32,40 @@ MVMuint32 MVM_gc_new_thread_nursery_size(MVMInstance *i) {
         : MVM_NURSERY_SIZE;
 }
 
+/* Decides on the size of a thread's next tospace, from how it has been
+ * using the nursery that just became its fromspace. A thread that caused
+ * the GC run has its nursery doubled until it reaches the standard size,
+ * and beyond that (up to the maximum) if it is filling it quickly and little
+ * of it survives. A thread whose nursery grew past the standard size, but
+ * that keeps being pulled into GC runs with it mostly empty, has it shrunk
+ * back down. Survivors will always fit, since we only shrink to half the
+ * size when less than a quarter was used. */
+static MVMuint32 next_nursery_size(MVMThreadContext *tc) {
+    MVMuint32 size = tc->nursery_fromspace_size;
+    MVMuint32 max  = tc->instance->gc_nursery_max_size;
+    if (tc->instance->thread_to_blame_for_gc == tc) {
+        MVMuint64 now      = uv_hrtime();
+        MVMuint64 interval = now - tc->nursery_last_blamed_time;
+        tc->nursery_last_blamed_time = now;
+        tc->nursery_idle_collections = 0;
+        if (size < MVM_NURSERY_SIZE)
+            return size * 2;
+        if (size < max && interval < MVM_NURSERY_GROW_INTERVAL
+                && tc->nursery_survival_percent <= MVM_NURSERY_GROW_SURVIVAL_PERCENT)
+            return size * 2 < max ? size * 2 : max;
+    }
+    else if (size > MVM_NURSERY_SIZE) {
+        MVMuint32 used = (char *)tc->nursery_alloc - (char *)tc->nursery_fromspace;
+        if (used >= size / 4)
+            tc->nursery_idle_collections = 0;
+        else if (++tc->nursery_idle_collections == MVM_NURSERY_SHRINK_COLLECTIONS) {
+            tc->nursery_idle_collections = 0;
+            return size / 2 > MVM_NURSERY_SIZE ? size / 2 : MVM_NURSERY_SIZE;
+        }
+    }
+    return size;
+}
+
 /* Does a garbage collection run. Exactly what it does is configured by the
  * couple of arguments that it takes.
  *
@@ -65,6 +102,12 @@ void MVM_gc_collect(MVMThreadContext *tc, MVMuint8 what_to_do, MVMuint8 gen) {
         GCDEBUG_LOG(tc, MVM_GC_DEBUG_COLLECT, "Thread %d run %d : processing %d items from in tray \n", worklist->items);
         process_worklist(tc, worklist, &wtp, gen);
     }
+    else if (what_to_do == MVMGCWhatToDo_SharedWork) {
+        /* We just need to process a chunk of shared work, if there is any. */
+        add_shared_work_to_worklist(tc, worklist);
+        GCDEBUG_LOG(tc, MVM_GC_DEBUG_COLLECT, "Thread %d run %d : processing %d items from shared work \n", worklist->items);
+        process_worklist(tc, worklist, &wtp, gen);
+    }
     else if (what_to_do == MVMGCWhatToDo_Finalizing) {
         /* Need to process the finalizing queue. */
         MVMuint32 i;
@@ -82,15 +125,8 @@ void MVM_gc_collect(MVMThreadContext *tc, MVMuint8 what_to_do, MVMuint8 gen) {
         tc->nursery_fromspace = tc->nursery_tospace;
         tc->nursery_fromspace_size = tc->nursery_tospace_size;
 
-        /* Decide on this threads's tospace size. If fromspace was already at
-         * the maximum nursery size, then that is the new tospace size. If
-         * not, then see if this thread caused the current GC run, and grant
-         * it a bigger tospace. Otherwise, new tospace size is left as the
-         * last tospace size. */
-        if (tc->nursery_tospace_size < MVM_NURSERY_SIZE) {
-            if (tc->instance->thread_to_blame_for_gc == tc)
-                tc->nursery_tospace_size *= 2;
-        }
+        /* Decide on this threads's tospace size. */
+        tc->nursery_tospace_size = next_nursery_size(tc);
 
         /* If the old fromspace matches the target size, just re-use it. If
          * not, free it and allocate a new tospace. */
@@ -146,6 +182,17 @@ void MVM_gc_collect(MVMThreadContext *tc, MVMuint8 what_to_do, MVMuint8 gen) {
         GCDEBUG_LOG(tc, MVM_GC_DEBUG_COLLECT, "Thread %d run %d : processing %d items from thread temps\n", worklist->items);
         process_worklist(tc, worklist, &wtp, gen);
 
+        /* If gen2 was being marked incrementally, visit the objects that
+         * marking left to the remark, and those still to be marked. */
+        if (gen == MVMGCGenerations_Both) {
+            remark(tc, worklist, &wtp, tc->gen2_remark, tc->num_gen2_remark);
+            remark(tc, worklist, &wtp, tc->gen2_grey, tc->num_gen2_grey);
+            GCDEBUG_LOG(tc, MVM_GC_DEBUG_COLLECT, "Thread %d run %d : remarked %d items from incremental marking\n",
+                tc->num_gen2_remark + tc->num_gen2_grey);
+            tc->num_gen2_remark = 0;
+            tc->num_gen2_grey = 0;
+        }
+
         /* Add things that are roots for the first generation because they are
         * pointed to by objects in the second generation and process them
         * (also per-thread). Note we need not do this if we're doing a full
@@ -234,8 +281,11 @@ static void process_worklist(MVMThreadContext *tc, MVMGCWorklist *worklist, Work
         }
 
         /* If it's owned by a different thread, we need to pass it over to
-         * the owning thread. */
-        if (item->owner != tc->thread_id) {
+         * the owning thread. The exception is a gen2 object (which we only
+         * get this far with in a full collection): marking it does not move
+         * it, so any thread can do it. Two threads may race to mark the same
+         * object, but all that costs is scanning it twice. */
+        if (item->owner != tc->thread_id && !item_gen2) {
             GCDEBUG_LOG(tc, MVM_GC_DEBUG_COLLECT, "Thread %d run %d : sending a handle %p to object %p to thread %d\n", item_ptr, item, item->owner);
             pass_work_item(tc, wtp, item_ptr);
             continue;
@@ -311,6 +361,11 @@ static void process_worklist(MVMThreadContext *tc, MVMGCWorklist *worklist, Work
                  * to mark it as live. */
                 if (gen == MVMGCGenerations_Both)
                     new_addr->flags |= MVM_CF_GEN2_LIVE;
+
+                /* If gen2 is being marked incrementally, then the remark
+                 * will need to visit it. */
+                else if (tc->instance->gc_incremental_marking)
+                    MVM_gc_incremental_defer(tc, new_addr);
             }
             else {
                 /* No, so it will live in the nursery for another GC
@@ -358,9 +413,35 @@ static void process_worklist(MVMThreadContext *tc, MVMGCWorklist *worklist, Work
                     MVM_gc_write_barrier_no_update_referenced(tc, new_addr, *j);
             }
         }
+
+        /* If we have a good amount of work left and some other threads are
+         * out of it, give them some. */
+        if (gen == MVMGCGenerations_Both && worklist->items >= MVM_GC_SHARE_WORK_THRESHOLD) {
+            AO_t idle = MVM_load(&tc->instance->gc_mark_idle);
+            if (idle && idle < MVM_load(&tc->instance->gc_mark_participants)
+                    && !MVM_load(&tc->instance->gc_shared_work))
+                share_work(tc, worklist);
+        }
     }
 }
 
+/* Visits objects left by incremental marking for the remark. Those that were
+ * marked must be scanned again, since they may have been written to without
+ * a barrier; the rest are treated as roots. Note that the list must not be
+ * changed until the collection is over, since the worklist points into it. */
+static void remark(MVMThreadContext *tc, MVMGCWorklist *worklist, WorkToPass *wtp, MVMCollectable **items, MVMuint32 num_items) {
+    MVMuint32 i;
+    for (i = 0; i < num_items; i++) {
+        if (items[i]->flags & MVM_CF_GEN2_LIVE)
+            MVM_gc_mark_collectable(tc, worklist, items[i]);
+        else
+            MVM_gc_worklist_add(tc, worklist, &items[i]);
+        if (worklist->items >= MVM_GC_SHARE_WORK_THRESHOLD)
+            process_worklist(tc, worklist, wtp, MVMGCGenerations_Both);
+    }
+    process_worklist(tc, worklist, wtp, MVMGCGenerations_Both);
+}
+
 /* Marks a collectable item (object, type object, STable). */
 void MVM_gc_mark_collectable(MVMThreadContext *tc, MVMGCWorklist *worklist, MVMCollectable *new_addr) {
     MVMuint16 i;
@@ -439,6 +520,17 @@ void MVM_gc_mark_collectable(MVMThreadContext *tc, MVMGCWorklist *worklist, MVMC
     }
 }
 
+/* Adds a chain of work, linked through next from first to last, to the
+ * specified tray, chaining anything already in it after us. */
+static void push_work_chain(MVMGCPassedWork * volatile *tray, MVMGCPassedWork *first, MVMGCPassedWork *last) {
+    while (1) {
+        MVMGCPassedWork *orig = *tray;
+        last->next = orig;
+        if (MVM_casptr(tray, orig, first) == orig)
+            return;
+    }
+}
+
 /* Adds a chunk of work to another thread's in-tray. */
 static void push_work_to_thread_in_tray(MVMThreadContext *tc, MVMuint32 target, MVMGCPassedWork *work) {
     MVMGCPassedWork * volatile *target_tray;
@@ -464,12 +556,7 @@ static void push_work_to_thread_in_tray(MVMThreadContext *tc, MVMuint32 target,
     /* Pass the work, chaining any other in-tray entries for the thread
      * after us. */
     target_tray = &target_tc->gc_in_tray;
-    while (1) {
-        MVMGCPassedWork *orig = *target_tray;
-        work->next = orig;
-        if (MVM_casptr(target_tray, orig, work) == orig)
-            return;
-    }
+    push_work_chain(target_tray, work, work);
 }
 
 /* Adds work to list of items to pass over to another thread, and if we
@@ -552,6 +639,71 @@ static void add_in_tray_to_worklist(MVMThreadContext *tc, MVMGCWorklist *worklis
     }
 }
 
+/* Moves some of the unmarked gen2 objects from the bottom of the worklist
+ * (that is, those we would get to last) into a chunk of shared work, which
+ * any thread that runs out of marking work may take. Only gen2 objects are
+ * shared, since they can be marked by any thread; nursery objects must be
+ * copied by their owner. */
+static void share_work(MVMThreadContext *tc, MVMGCWorklist *worklist) {
+    MVMGCPassedWork *work = NULL;
+    MVMuint32 window = 2 * MVM_GC_PASS_WORK_SIZE;
+    MVMuint32 from, to = 0;
+
+    for (from = 0; from < window; from++) {
+        MVMCollectable **item_ptr = worklist->list[from];
+        MVMCollectable *item = *item_ptr;
+        if (item && (item->flags & MVM_CF_SECOND_GEN) && !(item->flags & MVM_CF_GEN2_LIVE)
+                && (!work || work->num_items < MVM_GC_PASS_WORK_SIZE)) {
+            if (!work)
+                work = MVM_calloc(1, sizeof(MVMGCPassedWork));
+            work->items[work->num_items++] = item_ptr;
+        }
+        else {
+            worklist->list[to++] = item_ptr;
+        }
+    }
+    if (!work)
+        return;
+
+    /* Fill the gap we left in the window from the top of the worklist. The
+     * threshold for sharing work makes sure the two don't overlap. */
+    while (to < window)
+        worklist->list[to++] = worklist->list[--worklist->items];
+
+    GCDEBUG_LOG(tc, MVM_GC_DEBUG_COLLECT, "Thread %d run %d : sharing %d items of work\n", work->num_items);
+    push_work_chain(&tc->instance->gc_shared_work, work, work);
+}
+
+/* Takes a chunk of shared work, if any, and adds it to the worklist. */
+static void add_shared_work_to_worklist(MVMThreadContext *tc, MVMGCWorklist *worklist) {
+    MVMGCPassedWork * volatile *shared = &tc->instance->gc_shared_work;
+    MVMGCPassedWork *head, *rest;
+    MVMuint32 i;
+
+    /* Take everything that's there (taking just the first chunk would be
+     * open to the ABA problem, as chunks are freed and allocated anew). */
+    while (1) {
+        head = *shared;
+        if (head == NULL)
+            return;
+        if (MVM_casptr(shared, head, NULL) == head)
+            break;
+    }
+
+    /* Keep the first chunk, and put the rest back for other threads. */
+    rest = head->next;
+    if (rest) {
+        MVMGCPassedWork *last = rest;
+        while (last->next)
+            last = last->next;
+        push_work_chain(shared, rest, last);
+    }
+
+    for (i = 0; i < head->num_items; i++)
+        MVM_gc_worklist_add(tc, worklist, head->items[i]);
+    MVM_free(head);
+}
+
 /* Save dead STable pointers to delete later.. */
 static void MVM_gc_collect_enqueue_stable_for_deletion(MVMThreadContext *tc, MVMSTable *st) {
     MVMSTable *old_head;
@@ -653,12 +805,13 @@ void MVM_gc_collect_free_stables(MVMThreadContext *tc) {
     tc->instance->stables_to_free = NULL;
 }
 
-/* Goes through the unmarked objects in the second generation heap and builds
- * free lists out of them. Also does any required finalization. */
-void MVM_gc_collect_free_gen2_unmarked(MVMThreadContext *executing_thread, MVMThreadContext *tc, MVMint32 global_destruction) {
-    /* Visit each of the size class bins. */
+/* Sweeps a size class bin of the second generation heap, building its free
+ * list out of the unmarked objects, doing any required finalization, and
+ * clearing the marks on the living ones. */
+static void sweep_bin(MVMThreadContext *executing_thread, MVMThreadContext *tc, MVMuint32 bin, MVMint32 global_destruction) {
     MVMGen2Allocator *gen2 = tc->gen2;
-    MVMuint32 bin, obj_size, page, i;
+    MVMuint32 obj_size, page, num_pages;
+    MVMuint32 num_slots = 0, num_free = 0, empty_pages = 0, released = 0;
     MVMuint8 do_prof_log = 0;
 
     char ***freelist_insert_pos;
@@ -666,129 +819,153 @@ void MVM_gc_collect_free_gen2_unmarked(MVMThreadContext *executing_thread, MVMTh
     if (executing_thread->prof_data)
         do_prof_log = 1;
 
-    for (bin = 0; bin < MVM_GEN2_BINS; bin++) {
-        /* If we've nothing allocated in this size class, skip it. */
-        if (gen2->size_classes[bin].pages == NULL)
-            continue;
-
-        /* Calculate object size for this bin. */
-        obj_size = (bin + 1) << MVM_GEN2_BIN_BITS;
-
-        /* freelist_insert_pos is a pointer to a memory location that
-         * stores the address of the last traversed free list node (char **). */
-        /* Initialize freelist insertion position to free list head. */
-        freelist_insert_pos = &gen2->size_classes[bin].free_list;
-
-        /* Visit each page. */
-        for (page = 0; page < gen2->size_classes[bin].num_pages; page++) {
-            /* Visit all the objects, looking for dead ones and reset the
-             * mark for each of them. */
-            char *cur_ptr = gen2->size_classes[bin].pages[page];
-            char *end_ptr = page + 1 == gen2->size_classes[bin].num_pages
-                ? gen2->size_classes[bin].alloc_pos
-                : cur_ptr + obj_size * MVM_GEN2_PAGE_ITEMS;
-            while (cur_ptr < end_ptr) {
-                MVMCollectable *col = (MVMCollectable *)cur_ptr;
-
-                /* Is this already a free list slot? If so, it becomes the
-                 * new free list insert position. */
-                if (*freelist_insert_pos == (char **)cur_ptr) {
-                    freelist_insert_pos = (char ***)cur_ptr;
-                }
+    /* Calculate object size for this bin. */
+    obj_size = (bin + 1) << MVM_GEN2_BIN_BITS;
+
+    /* freelist_insert_pos is a pointer to a memory location that
+     * stores the address of the last traversed free list node (char **). */
+    /* Initialize freelist insertion position to free list head. */
+    freelist_insert_pos = &gen2->size_classes[bin].free_list;
+
+    /* Visit each page. */
+    num_pages = gen2->size_classes[bin].num_pages;
+    for (page = 0; page < num_pages; page++) {
+        /* Visit all the objects, looking for dead ones and reset the
+         * mark for each of them. */
+        char *cur_ptr = gen2->size_classes[bin].pages[page];
+        char *end_ptr = page + 1 == num_pages
+            ? gen2->size_classes[bin].alloc_pos
+            : cur_ptr + obj_size * MVM_GEN2_PAGE_ITEMS;
+        MVMuint32 page_free = 0;
+        num_slots += (end_ptr - cur_ptr) / obj_size;
+        while (cur_ptr < end_ptr) {
+            MVMCollectable *col = (MVMCollectable *)cur_ptr;
+
+            /* Is this already a free list slot? If so, it becomes the
+             * new free list insert position. */
+            if (*freelist_insert_pos == (char **)cur_ptr) {
+                freelist_insert_pos = (char ***)cur_ptr;
+                page_free++;
+            }
 
-                /* Otherwise, it must be a collectable of some kind. Is it
-                 * live? */
-                else if (col->flags & MVM_CF_GEN2_LIVE) {
-                    /* Yes; clear the mark. */
-                    col->flags &= ~MVM_CF_GEN2_LIVE;
-                }
-                else {
-                    GCDEBUG_LOG(tc, MVM_GC_DEBUG_COLLECT, "Thread %d run %d : collecting an object %p in the gen2\n", col);
-                    /* No, it's dead. Do any cleanup. */
+            /* Otherwise, it must be a collectable of some kind. Is it
+             * live? */
+            else if (col->flags & MVM_CF_GEN2_LIVE) {
+                /* Yes; clear the mark, and note it's no longer on any
+                 * incremental marking list. */
+                col->flags &= ~(MVM_CF_GEN2_LIVE | MVM_CF_IN_GEN2_MARK_LIST);
+            }
+            else {
+                GCDEBUG_LOG(tc, MVM_GC_DEBUG_COLLECT, "Thread %d run %d : collecting an object %p in the gen2\n", col);
+                /* No, it's dead. Do any cleanup. */
 #if MVM_GC_DEBUG
-                    col->flags |= MVM_CF_DEBUG_IN_GEN2_FREE_LIST;
+                col->flags |= MVM_CF_DEBUG_IN_GEN2_FREE_LIST;
 #endif
-                    if (col->flags & MVM_CF_TYPE_OBJECT) {
+                if (col->flags & MVM_CF_TYPE_OBJECT) {
 #ifdef MVM_USE_OVERFLOW_SERIALIZATION_INDEX
-                        if (col->flags & MVM_CF_SERIALZATION_INDEX_ALLOCATED)
-                            MVM_free(col->sc_forward_u.sci);
+                    if (col->flags & MVM_CF_SERIALZATION_INDEX_ALLOCATED)
+                        MVM_free(col->sc_forward_u.sci);
 #endif
-                    }
-                    else if (col->flags & MVM_CF_STABLE) {
-                        if (
+                }
+                else if (col->flags & MVM_CF_STABLE) {
+                    if (
 #ifdef MVM_USE_OVERFLOW_SERIALIZATION_INDEX
-                            !(col->flags & MVM_CF_SERIALZATION_INDEX_ALLOCATED) &&
+                        !(col->flags & MVM_CF_SERIALZATION_INDEX_ALLOCATED) &&
 #endif
-                            col->sc_forward_u.sc.sc_idx == 0
-                            && col->sc_forward_u.sc.idx == (unsigned)MVM_DIRECT_SC_IDX_SENTINEL) {
-                            /* We marked it dead last time, kill it. */
-                            MVM_6model_stable_gc_free(tc, (MVMSTable *)col);
-                        }
-                        else {
+                        col->sc_forward_u.sc.sc_idx == 0
+                        && col->sc_forward_u.sc.idx == (unsigned)MVM_DIRECT_SC_IDX_SENTINEL) {
+                        /* We marked it dead last time, kill it. */
+                        MVM_6model_stable_gc_free(tc, (MVMSTable *)col);
+                    }
+                    else {
 #ifdef MVM_USE_OVERFLOW_SERIALIZATION_INDEX
-                            if (col->flags & MVM_CF_SERIALZATION_INDEX_ALLOCATED) {
-                                /* Whatever happens next, we can free this
-                                   memory immediately, because no-one will be
-                                   serializing a dead STable. */
-                                assert(!(col->sc_forward_u.sci->sc_idx == 0
-                                         && col->sc_forward_u.sci->idx
-                                         == MVM_DIRECT_SC_IDX_SENTINEL));
-                                MVM_free(col->sc_forward_u.sci);
-                                col->flags &= ~MVM_CF_SERIALZATION_INDEX_ALLOCATED;
-                            }
+                        if (col->flags & MVM_CF_SERIALZATION_INDEX_ALLOCATED) {
+                            /* Whatever happens next, we can free this
+                               memory immediately, because no-one will be
+                               serializing a dead STable. */
+                            assert(!(col->sc_forward_u.sci->sc_idx == 0
+                                     && col->sc_forward_u.sci->idx
+                                     == MVM_DIRECT_SC_IDX_SENTINEL));
+                            MVM_free(col->sc_forward_u.sci);
+                            col->flags &= ~MVM_CF_SERIALZATION_INDEX_ALLOCATED;
+                        }
 #endif
-                            if (global_destruction) {
-                                /* We're in global destruction, so enqueue to the end
-                                 * like we do in the nursery */
-                                MVM_gc_collect_enqueue_stable_for_deletion(tc, (MVMSTable *)col);
-                            } else {
-                                /* There will definitely be another gc run, so mark it as "died last time". */
-                                col->sc_forward_u.sc.sc_idx = 0;
-                                col->sc_forward_u.sc.idx = MVM_DIRECT_SC_IDX_SENTINEL;
-                            }
-                            /* Skip the freelist updating. */
-                            cur_ptr += obj_size;
-                            continue;
+                        if (global_destruction) {
+                            /* We're in global destruction, so enqueue to the end
+                             * like we do in the nursery */
+                            MVM_gc_collect_enqueue_stable_for_deletion(tc, (MVMSTable *)col);
+                        } else {
+                            /* There will definitely be another gc run, so mark it as "died last time". */
+                            col->sc_forward_u.sc.sc_idx = 0;
+                            col->sc_forward_u.sc.idx = MVM_DIRECT_SC_IDX_SENTINEL;
                         }
+                        /* Skip the freelist updating. */
+                        cur_ptr += obj_size;
+                        continue;
                     }
-                    else if (col->flags & MVM_CF_FRAME) {
-                        MVM_frame_destroy(tc, (MVMFrame *)col);
+                }
+                else if (col->flags & MVM_CF_FRAME) {
+                    MVM_frame_destroy(tc, (MVMFrame *)col);
+                }
+                else {
+                    /* Object instance; call gc_free if needed. */
+                    MVMObject *obj = (MVMObject *)col;
+                    if (do_prof_log) {
+                        MVM_profiler_log_gc_deallocate(executing_thread, obj);
                     }
-                    else {
-                        /* Object instance; call gc_free if needed. */
-                        MVMObject *obj = (MVMObject *)col;
-                        if (do_prof_log) {
-                            MVM_profiler_log_gc_deallocate(executing_thread, obj);
-                        }
-                        if (STABLE(obj) && REPR(obj)->gc_free)
-                            REPR(obj)->gc_free(tc, obj);
+                    if (STABLE(obj) && REPR(obj)->gc_free)
+                        REPR(obj)->gc_free(tc, obj);
 #ifdef MVM_USE_OVERFLOW_SERIALIZATION_INDEX
-                        if (col->flags & MVM_CF_SERIALZATION_INDEX_ALLOCATED)
-                            MVM_free(col->sc_forward_u.sci);
+                    if (col->flags & MVM_CF_SERIALZATION_INDEX_ALLOCATED)
+                        MVM_free(col->sc_forward_u.sci);
 #endif
-                    }
-
-                    /* Chain in to the free list. */
-                    *((char **)cur_ptr) = (char *)*freelist_insert_pos;
-                    *freelist_insert_pos = (char **)cur_ptr;
-
-                    /* Update the pointer to the insert position to point to us */
-                    freelist_insert_pos = (char ***)cur_ptr;
                 }
 
-                /* Move to the next object. */
-                cur_ptr += obj_size;
+                /* Chain in to the free list. */
+                *((char **)cur_ptr) = (char *)*freelist_insert_pos;
+                *freelist_insert_pos = (char **)cur_ptr;
+
+                /* Update the pointer to the insert position to point to us */
+                freelist_insert_pos = (char ***)cur_ptr;
+                page_free++;
             }
+
+            /* Move to the next object. */
+            cur_ptr += obj_size;
         }
+
+        /* We never release the page we're allocating in. */
+        num_free += page_free;
+        if (page_free == MVM_GEN2_PAGE_ITEMS && page + 1 < num_pages)
+            empty_pages++;
     }
-    
-    /* Also need to consider overflows. */
+
+    /* If enough of the size class is free, give its empty pages back. */
+    if (empty_pages && (MVMuint64)num_free * 100
+            > (MVMuint64)num_slots * tc->instance->gc_gen2_release_percent)
+        released = MVM_gc_gen2_release_empty_pages(gen2, bin);
+
+    if (tc->instance->gc_gen2_stats_log_fh)
+        fprintf(tc->instance->gc_gen2_stats_log_fh,
+            "gc %d thread %d size %u: %u pages, %u of %u slots free (%u%%), %u empty pages released\n",
+            (int)MVM_load(&tc->instance->gc_seq_number), tc->thread_id, obj_size,
+            num_pages, num_free, num_slots,
+            num_slots ? (MVMuint32)((MVMuint64)num_free * 100 / num_slots) : 0,
+            released);
+}
+
+/* Frees the unmarked over-sized objects in the second generation heap, and
+ * clears the marks on the living ones. */
+static void sweep_overflows(MVMThreadContext *tc) {
+    MVMGen2Allocator *gen2 = tc->gen2;
+    MVMuint32 i;
+
     for (i = 0; i < gen2->num_overflows; i++) {
         if (gen2->overflows[i]) {
             MVMCollectable *col = gen2->overflows[i];
             if (col->flags & MVM_CF_GEN2_LIVE) {
                 /* A living over-sized object; just clear the mark. */
-                col->flags &= ~MVM_CF_GEN2_LIVE;
+                col->flags &= ~(MVM_CF_GEN2_LIVE | MVM_CF_IN_GEN2_MARK_LIST);
             }
             else {
                 /* Dead over-sized object. We know if it's this big it cannot
@@ -814,3 +991,20 @@ void MVM_gc_collect_free_gen2_unmarked(MVMThreadContext *executing_thread, MVMTh
     /* And finally compact the overflow list */
     MVM_gc_gen2_compact_overflows(gen2);
 }
+
+/* Goes through the unmarked objects in the second generation heap and builds
+ * free lists out of them. Also does any required finalization. */
+void MVM_gc_collect_free_gen2_unmarked(MVMThreadContext *executing_thread, MVMThreadContext *tc, MVMint32 global_destruction) {
+    /* Visit each of the size class bins. */
+    MVMGen2Allocator *gen2 = tc->gen2;
+    MVMuint32 bin;
+    for (bin = 0; bin < MVM_GEN2_BINS; bin++) {
+        /* If we've nothing allocated in this size class, skip it. */
+        if (gen2->size_classes[bin].pages == NULL)
+            continue;
+        sweep_bin(executing_thread, tc, bin, global_destruction);
+    }
+
+    /* Also need to consider overflows. */
+    sweep_overflows(tc);
+}
@@ -9,6 +9,19 @@
  * often done for GC stress testing) then this value will be ignored. */
 #define MVM_NURSERY_THREAD_START 131072
 
+/* Threads that fill their nursery quickly can have it grow past the size
+ * above, up to this size (or as set by MVM_GC_NURSERY_MAX_SIZE). This only
+ * happens if the thread is filling it more often than every so many
+ * nanoseconds, and if no more than a small percentage of it survives each
+ * collection, so that the bigger nursery means fewer collections without
+ * much more copying. A nursery that has grown past the standard size is
+ * halved again after it has been less than a quarter full in so many
+ * collections in a row that were started by other threads. */
+#define MVM_NURSERY_MAX_SIZE                33554432
+#define MVM_NURSERY_GROW_INTERVAL           10000000
+#define MVM_NURSERY_GROW_SURVIVAL_PERCENT   10
+#define MVM_NURSERY_SHRINK_COLLECTIONS      8
+
 /* How many bytes should have been promoted into gen2 before we decide to
  * do a full GC run? This defaults to a percentage of the resident set, with
  * a minimum to avoid small processes doing a load of gen2 collections. */
@@ -28,7 +41,10 @@ typedef enum {
     MVMGCWhatToDo_InTray = 2,
 
     /* Only process the finalizing list. */
-    MVMGCWhatToDo_Finalizing = 4
+    MVMGCWhatToDo_Finalizing = 4,
+
+    /* Only process a chunk of gen2 marking work shared by another thread. */
+    MVMGCWhatToDo_SharedWork = 8
 } MVMGCWhatToDo;
 
 /* What generation(s) to collect? */
@@ -44,8 +60,15 @@ typedef enum {
  * off to the next thread. (Power of 2, minus 2, is a decent choice.) */
 #define MVM_GC_PASS_WORK_SIZE   62
 
+/* During a full collection, a thread whose worklist has grown to at least
+ * this many items will share some of the gen2 objects on it with threads
+ * that have run out of marking work. */
+#define MVM_GC_SHARE_WORK_THRESHOLD (4 * MVM_GC_PASS_WORK_SIZE)
+
 /* Represents a piece of work (some addresses to visit) that have been passed
- * from one thread doing GC to another thread doing GC. */
+ * from one thread doing GC to another thread doing GC. Also used for chunks
+ * of work that are shared with any thread, rather than passed to a given
+ * one. */
 struct MVMGCPassedWork {
     MVMCollectable **items[MVM_GC_PASS_WORK_SIZE];
     MVMGCPassedWork *next;
@@ -114,6 +114,43 @@ void * MVM_gc_gen2_allocate_zeroed(MVMGen2Allocator *al, MVMuint32 size) {
     return a;
 }
 
+/* Frees the pages of a size class that hold nothing but free list slots,
+ * other than the page we're allocating in, removing their slots from the
+ * free list. Must only be called with the bin fully swept. The free list is
+ * in page order, so the slots of each page are a run of it. Returns the
+ * number of pages freed. */
+MVMuint32 MVM_gc_gen2_release_empty_pages(MVMGen2Allocator *al, MVMuint32 bin) {
+    MVMGen2SizeClass *sc = &al->size_classes[bin];
+    MVMuint32 page_size = MVM_GEN2_PAGE_ITEMS * ((bin + 1) << MVM_GEN2_BIN_BITS);
+    char ***freelist_pos = &sc->free_list;
+    MVMuint32 page, kept = 0;
+
+    for (page = 0; page < sc->num_pages; page++) {
+        char *start = sc->pages[page];
+        char *end = start + page_size;
+        char ***run_end = freelist_pos;
+        MVMuint32 run_length = 0;
+        while (*run_end && (char *)*run_end >= start && (char *)*run_end < end) {
+            run_end = (char ***)*run_end;
+            run_length++;
+        }
+        if (run_length == MVM_GEN2_PAGE_ITEMS && page + 1 < sc->num_pages) {
+            /* Empty; unlink its slots and free it. */
+            *freelist_pos = *run_end;
+            MVM_free(start);
+        }
+        else {
+            freelist_pos = run_end;
+            sc->pages[kept++] = start;
+        }
+    }
+
+    page = sc->num_pages - kept;
+    sc->num_pages = kept;
+    sc->cur_page = kept - 1;
+    return page;
+}
+
 /* Frees all memory associated with the second generation. */
 void MVM_gc_gen2_destroy(MVMInstance *i, MVMGen2Allocator *al) {
     MVMuint32 j, k;
@@ -264,6 +301,7 @@ void MVM_gc_gen2_transfer(MVMThreadContext *src, MVMThreadContext *dest) {
         MVM_free(src->gen2roots);
         src->gen2roots = NULL;
     }
+    MVM_gc_incremental_transfer(src, dest);
 }
 
 
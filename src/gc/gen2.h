@@ -64,6 +64,11 @@ struct MVMGen2Allocator {
 /* The number of items that go into each page. */
 #define MVM_GEN2_PAGE_ITEMS 256
 
+/* After a size class has been swept, if more than this percentage of its
+ * slots are free then its empty pages are released. Can be overridden with
+ * the MVM_GC_GEN2_RELEASE_PERCENT environment variable. */
+#define MVM_GEN2_RELEASE_PERCENT 50
+
 /* Functions. */
 MVMGen2Allocator * MVM_gc_gen2_create(MVMInstance *i);
 void * MVM_gc_gen2_allocate(MVMGen2Allocator *al, MVMuint32 size);
@@ -71,3 +76,4 @@ void * MVM_gc_gen2_allocate_zeroed(MVMGen2Allocator *al, MVMuint32 size);
 void MVM_gc_gen2_destroy(MVMInstance *i, MVMGen2Allocator *allocator);
 void MVM_gc_gen2_transfer(MVMThreadContext *src, MVMThreadContext *dest);
 void MVM_gc_gen2_compact_overflows(MVMGen2Allocator *allocator);
+MVMuint32 MVM_gc_gen2_release_empty_pages(MVMGen2Allocator *al, MVMuint32 bin);
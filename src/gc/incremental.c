@@ -0,0 +1,174 @@
+#include "moar.h"
+
+/* Incremental marking of generation 2.
+ *
+ * A full collection has to mark every live object in gen2, and for a large
+ * heap that is the bulk of the pause. Instead, once gen2 has grown a fair bit
+ * since the last full collection, we start marking it ahead of time: after
+ * each nursery collection, with the world still stopped, the co-ordinator
+ * marks a bounded number of gen2 objects, starting from the instance roots.
+ * Marked objects have MVM_CF_GEN2_LIVE set (they are "black"); objects that
+ * are known to be reachable but not yet scanned are on the per-thread grey
+ * lists. When marking has run out of grey objects, the next collection is a
+ * full one. It traces from the roots as usual, but does not look inside the
+ * objects that were already marked, so all it has to do is a final remark.
+ *
+ * Between nursery collections the mutators run, and may store a reference to
+ * an unmarked object into a marked one. We must not lose such an object, and
+ * so whenever the write barrier sees a store into a marked object, it unmarks
+ * the object and puts it back on the grey list (an incremental update barrier
+ * in the style of Steele). Since the barrier already has to look at the root
+ * to see if it is in gen2, the extra cost when not marking is one more flag
+ * test on the path where the root is in gen2.
+ *
+ * Some things are written to without any barrier at all: heap frames have
+ * their registers written directly. Also, objects in the inter-generational
+ * root set point into the nursery, which the full collection only traces
+ * through its roots. Neither can be treated as fully marked until the world
+ * is stopped for the remark, so we mark them to avoid scanning them many
+ * times, but also put them on a remark list, and the full collection scans
+ * them again. Objects promoted into gen2 while marking is going on go onto
+ * the remark list too; they are left unmarked and treated as roots by the
+ * remark (so if they die before then, they are only freed by the following
+ * full collection).
+ *
+ * An object is only ever on one of the lists at a time; MVM_CF_IN_GEN2_MARK_LIST
+ * says that it is on one, so objects that are written to over and over don't
+ * make the lists grow without bound. The flag is cleared when an item is
+ * taken off the grey list, and otherwise by the sweep after the full
+ * collection (clearing it during the collection itself could race with
+ * another GC thread setting the mark on the same object).
+ *
+ * The marking is only ever done with the world stopped, not concurrently
+ * with the mutators; the REPRs' gc_mark functions assume that the object is
+ * not changing under them, and many data structures are resized in place. */
+
+/* Pushes an item onto a list, growing it if needed. */
+static void push(MVMCollectable ***list, MVMuint32 *num, MVMuint32 *alloc, MVMCollectable *item) {
+    if (*num == *alloc) {
+        *alloc = *alloc ? *alloc * 2 : 64;
+        *list  = MVM_realloc(*list, *alloc * sizeof(MVMCollectable *));
+    }
+    (*list)[(*num)++] = item;
+}
+static void push_grey(MVMThreadContext *tc, MVMCollectable *item) {
+    if (item->flags & MVM_CF_IN_GEN2_MARK_LIST)
+        return;
+    item->flags |= MVM_CF_IN_GEN2_MARK_LIST;
+    push(&tc->gen2_grey, &tc->num_gen2_grey, &tc->alloc_gen2_grey, item);
+}
+static void push_remark(MVMThreadContext *tc, MVMCollectable *item) {
+    if (item->flags & MVM_CF_IN_GEN2_MARK_LIST)
+        return;
+    item->flags |= MVM_CF_IN_GEN2_MARK_LIST;
+    push(&tc->gen2_remark, &tc->num_gen2_remark, &tc->alloc_gen2_remark, item);
+}
+
+/* Takes the items that have been added to a worklist, and puts those that are
+ * unmarked gen2 objects onto the grey list of the specified thread. Nursery
+ * objects are left for the full collection to find. */
+static void grey_worklist(MVMThreadContext *tc, MVMGCWorklist *worklist, MVMThreadContext *owner) {
+    MVMuint32 i;
+    for (i = 0; i < worklist->items; i++) {
+        MVMCollectable *item = *(worklist->list[i]);
+        if (item && (item->flags & MVM_CF_SECOND_GEN) && !(item->flags & MVM_CF_GEN2_LIVE))
+            push_grey(owner, item);
+    }
+    worklist->items = 0;
+}
+
+/* Starts incremental marking, greying the gen2 objects that the instance-wide
+ * roots point to. Per-thread roots change too quickly to be worth marking
+ * from ahead of time; the remark will trace them. Called by the co-ordinator
+ * at the end of a nursery collection. */
+void MVM_gc_incremental_start(MVMThreadContext *tc) {
+    MVMGCWorklist *worklist = MVM_gc_worklist_create(tc, 1);
+    MVM_gc_root_add_permanents_to_worklist(tc, worklist, NULL);
+    grey_worklist(tc, worklist, tc);
+    MVM_gc_root_add_instance_roots_to_worklist(tc, worklist, NULL);
+    grey_worklist(tc, worklist, tc);
+    MVM_gc_worklist_destroy(tc, worklist);
+
+    tc->instance->gc_incremental_marking = MVM_GC_INCREMENTAL_MARKING;
+}
+
+/* Marks the items on a thread's grey list, until it is empty or the budget
+ * is used up. Returns how much of the budget was used. */
+static MVMuint32 mark_grey_list(MVMThreadContext *tc, MVMGCWorklist *worklist, MVMThreadContext *owner, MVMuint32 budget) {
+    MVMuint32 marked = 0;
+    while (owner->num_gen2_grey && marked < budget) {
+        MVMCollectable *item = owner->gen2_grey[--owner->num_gen2_grey];
+        item->flags &= ~MVM_CF_IN_GEN2_MARK_LIST;
+        if (item->flags & MVM_CF_GEN2_LIVE)
+            continue;
+        item->flags |= MVM_CF_GEN2_LIVE;
+        if (item->flags & (MVM_CF_FRAME | MVM_CF_IN_GEN2_ROOT_LIST))
+            push_remark(owner, item);
+        MVM_gc_mark_collectable(tc, worklist, item);
+        grey_worklist(tc, worklist, owner);
+        marked++;
+    }
+    return marked;
+}
+
+/* Does a step of incremental marking, marking up to budget objects. If that
+ * leaves nothing more to mark, then we're ready for the remark. Called by the
+ * co-ordinator at the end of a nursery collection. */
+void MVM_gc_incremental_step(MVMThreadContext *tc, MVMuint32 budget) {
+    MVMGCWorklist *worklist = MVM_gc_worklist_create(tc, 1);
+    MVMThread *cur_thread = (MVMThread *)MVM_load(&tc->instance->threads);
+    MVMuint32 remaining = 0;
+    while (cur_thread) {
+        MVMThreadContext *thread_tc = cur_thread->body.tc;
+        if (thread_tc) {
+            budget -= mark_grey_list(tc, worklist, thread_tc, budget);
+            remaining += thread_tc->num_gen2_grey;
+        }
+        cur_thread = cur_thread->body.next;
+    }
+    MVM_gc_worklist_destroy(tc, worklist);
+
+    if (!remaining)
+        tc->instance->gc_incremental_marking = MVM_GC_INCREMENTAL_REMARK;
+}
+
+/* Called by the write barrier when an object that was already marked is
+ * written to. Unmarks it and puts it back on the grey list, so that whatever
+ * it now references will also be marked. */
+void MVM_gc_incremental_regrey(MVMThreadContext *tc, MVMCollectable *item) {
+    if (tc->instance->gc_incremental_marking) {
+        item->flags &= ~MVM_CF_GEN2_LIVE;
+        push_grey(tc, item);
+    }
+}
+
+/* Called when an object is promoted to gen2 by a nursery collection while
+ * incremental marking is in progress, so the remark will visit it. */
+void MVM_gc_incremental_defer(MVMThreadContext *tc, MVMCollectable *item) {
+    push_remark(tc, item);
+}
+
+/* Transfers the incremental marking state of a thread that is going away to
+ * another thread. */
+void MVM_gc_incremental_transfer(MVMThreadContext *src, MVMThreadContext *dest) {
+    MVMuint32 i;
+    for (i = 0; i < src->num_gen2_grey; i++)
+        push(&dest->gen2_grey, &dest->num_gen2_grey, &dest->alloc_gen2_grey,
+            src->gen2_grey[i]);
+    for (i = 0; i < src->num_gen2_remark; i++)
+        push(&dest->gen2_remark, &dest->num_gen2_remark, &dest->alloc_gen2_remark,
+            src->gen2_remark[i]);
+    MVM_gc_incremental_destroy(src);
+}
+
+/* Frees the incremental marking state of a thread. */
+void MVM_gc_incremental_destroy(MVMThreadContext *tc) {
+    MVM_free(tc->gen2_grey);
+    MVM_free(tc->gen2_remark);
+    tc->gen2_grey         = NULL;
+    tc->num_gen2_grey     = 0;
+    tc->alloc_gen2_grey   = 0;
+    tc->gen2_remark       = NULL;
+    tc->num_gen2_remark   = 0;
+    tc->alloc_gen2_remark = 0;
+}
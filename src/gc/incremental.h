@@ -0,0 +1,28 @@
+/* Incremental marking of the second generation. Once enough has been promoted
+ * since the last full collection, the co-ordinator of each nursery collection
+ * marks a bounded number of gen2 objects, so that by the time the full
+ * collection comes around most of the live gen2 objects are already marked
+ * and it only has to do a final remark. See incremental.c for the details. */
+
+/* The states incremental marking can be in. */
+#define MVM_GC_INCREMENTAL_IDLE     0
+#define MVM_GC_INCREMENTAL_MARKING  1
+#define MVM_GC_INCREMENTAL_REMARK   2
+
+/* How many gen2 objects to mark after each nursery collection while
+ * incremental marking is in progress. */
+#define MVM_GC_INCREMENTAL_MARK_BUDGET  32768
+
+/* How many bytes should have been promoted into gen2 before we start to mark
+ * it incrementally, as a percentage of the resident set and as a minimum.
+ * Half way to a full collection gives the marking time to finish. */
+#define MVM_GC_INCREMENTAL_START_PERCENT  (MVM_GC_GEN2_THRESHOLD_PERCENT / 2)
+#define MVM_GC_INCREMENTAL_START_MINIMUM  (MVM_GC_GEN2_THRESHOLD_MINIMUM / 2)
+
+/* Functions. */
+void MVM_gc_incremental_start(MVMThreadContext *tc);
+void MVM_gc_incremental_step(MVMThreadContext *tc, MVMuint32 budget);
+void MVM_gc_incremental_regrey(MVMThreadContext *tc, MVMCollectable *item);
+void MVM_gc_incremental_defer(MVMThreadContext *tc, MVMCollectable *item);
+void MVM_gc_incremental_transfer(MVMThreadContext *src, MVMThreadContext *dest);
+void MVM_gc_incremental_destroy(MVMThreadContext *tc);
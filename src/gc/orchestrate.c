@@ -20,6 +20,42 @@ static void add_work(MVMThreadContext *tc, MVMThreadContext *stolen) {
     tc->gc_work[tc->gc_work_count++].tc = stolen;
 }
 
+/* Puts the work of the threads that the co-ordinator stole (since they were
+ * blocked or have exited) up for grabs. Otherwise the co-ordinator would do
+ * it all by itself; with a pool of worker threads that are mostly waiting
+ * for work, that is most of the collection. The first item in the work list
+ * is always the co-ordinator itself. */
+static void share_stolen_work(MVMThreadContext *tc) {
+    MVMInstance *instance = tc->instance;
+    MVMuint32 i, n = tc->gc_work_count - 1;
+    if (n > instance->gc_stolen_alloc) {
+        instance->gc_stolen_alloc = n;
+        instance->gc_stolen = MVM_realloc(instance->gc_stolen,
+            n * sizeof(MVMThreadContext *));
+    }
+    for (i = 0; i < n; i++)
+        instance->gc_stolen[i] = tc->gc_work[i + 1].tc;
+    instance->gc_stolen_count = n;
+    MVM_store(&instance->gc_stolen_claimed, 0);
+    tc->gc_work_count = 1;
+}
+
+/* Claims the work of one of the threads the co-ordinator stole, if there's
+ * any left, adding it to our work list. Returns zero if there was none. */
+static MVMuint32 claim_stolen_work(MVMThreadContext *tc) {
+    MVMInstance *instance = tc->instance;
+    AO_t claimed;
+    if (MVM_load(&instance->gc_stolen_claimed) >= instance->gc_stolen_count)
+        return 0;
+    claimed = MVM_incr(&instance->gc_stolen_claimed);
+    if (claimed >= instance->gc_stolen_count)
+        return 0;
+    GCDEBUG_LOG(tc, MVM_GC_DEBUG_ORCHESTRATE, "Thread %d run %d : claimed the stolen work of thread %d\n",
+        instance->gc_stolen[claimed]->thread_id);
+    add_work(tc, instance->gc_stolen[claimed]);
+    return 1;
+}
+
 /* Goes through all threads but the current one and notifies them that a
  * GC run is starting. Those that are blocked are considered excluded from
  * the run, and are not counted. Returns the count of threads that should be
@@ -115,6 +151,40 @@ static int process_in_tray(MVMThreadContext *tc, MVMuint8 gen) {
     return 0;
 }
 
+/* Does a chunk of the gen2 marking work that threads share during a full
+ * collection, if there is any. Returns a non-zero value if work was found
+ * and done, and zero otherwise. */
+static int process_shared_work(MVMThreadContext *tc, MVMuint8 gen) {
+    if (MVM_load(&tc->instance->gc_shared_work)) {
+        GCDEBUG_LOG(tc, MVM_GC_DEBUG_ORCHESTRATE,
+            "Thread %d run %d : Found shared work; doing it\n");
+        MVM_gc_collect(tc, MVMGCWhatToDo_SharedWork, gen);
+        return 1;
+    }
+    return 0;
+}
+
+/* Called during a full collection by a thread that is out of work. Counts
+ * itself as idle, which invites threads that are still marking to share
+ * some of their work, and waits until either there is work for it (in which
+ * case it returns non-zero) or all threads taking part are idle. */
+static int wait_for_shared_work(MVMThreadContext *tc) {
+    MVMInstance *instance = tc->instance;
+    MVM_incr(&instance->gc_mark_idle);
+    while (MVM_load(&instance->gc_mark_idle) < MVM_load(&instance->gc_mark_participants)) {
+        MVMuint32 i;
+        int has_work = MVM_load(&instance->gc_shared_work) != 0;
+        for (i = 0; i < tc->gc_work_count && !has_work; i++)
+            has_work = MVM_load(&tc->gc_work[i].tc->gc_in_tray) != 0;
+        if (has_work) {
+            MVM_decr(&instance->gc_mark_idle);
+            return 1;
+        }
+        MVM_platform_thread_yield();
+    }
+    return 0;
+}
+
 /* Called by a thread when it thinks it is done with GC. It may get some more
  * work yet, though. */
 static void clear_intrays(MVMThreadContext *tc, MVMuint8 gen) {
@@ -128,8 +198,10 @@ static void clear_intrays(MVMThreadContext *tc, MVMuint8 gen) {
                 did_work += process_in_tray(cur_thread->body.tc, gen);
             cur_thread = cur_thread->body.next;
         }
+        did_work += process_shared_work(tc, gen);
     }
 }
+static void mark_gen2_incrementally(MVMThreadContext *tc);
 static void finish_gc(MVMThreadContext *tc, MVMuint8 gen, MVMuint8 is_coordinator) {
     MVMuint32 i, did_work;
 
@@ -141,6 +213,13 @@ static void finish_gc(MVMThreadContext *tc, MVMuint8 gen, MVMuint8 is_coordinato
         did_work = 0;
         for (i = 0; i < tc->gc_work_count; i++)
             did_work += process_in_tray(tc->gc_work[i].tc, gen);
+        if (gen == MVMGCGenerations_Both) {
+            /* In a full collection, help out threads that still have marking
+             * to do before voting to finish. */
+            did_work += process_shared_work(tc, gen);
+            if (!did_work)
+                did_work = wait_for_shared_work(tc);
+        }
     }
 
     /* Decrement gc_finish to say we're done, and wait for termination. */
@@ -171,6 +250,12 @@ static void finish_gc(MVMThreadContext *tc, MVMuint8 gen, MVMuint8 is_coordinato
         MVM_finalize_walk_queues(tc, gen);
         clear_intrays(tc, gen);
 
+        if (gen == MVMGCGenerations_Nursery) {
+            GCDEBUG_LOG(tc, MVM_GC_DEBUG_ORCHESTRATE,
+                "Thread %d run %d : Co-ordinator handling incremental gen2 marking\n");
+            mark_gen2_incrementally(tc);
+        }
+
         if (gen == MVMGCGenerations_Both) {
             MVMThread *cur_thread = (MVMThread *)MVM_load(&tc->instance->threads);
             GCDEBUG_LOG(tc, MVM_GC_DEBUG_ORCHESTRATE,
@@ -217,6 +302,10 @@ static void finish_gc(MVMThreadContext *tc, MVMuint8 gen, MVMuint8 is_coordinato
         if (MVM_load(&thread_obj->body.stage) == MVM_thread_stage_clearing_nursery) {
             GCDEBUG_LOG(tc, MVM_GC_DEBUG_ORCHESTRATE,
                 "Thread %d run %d : transferring gen2 of thread %d\n", other->thread_id);
+            /* The transfer walks the free lists, so the heap must be swept
+             * first, as ours already was. */
+            if (gen == MVMGCGenerations_Both)
+                MVM_gc_collect_free_gen2_unmarked(tc, other, 0);
             MVM_gc_gen2_transfer(other, tc);
             GCDEBUG_LOG(tc, MVM_GC_DEBUG_ORCHESTRATE,
                 "Thread %d run %d : destroying thread %d\n", other->thread_id);
@@ -225,7 +314,9 @@ static void finish_gc(MVMThreadContext *tc, MVMuint8 gen, MVMuint8 is_coordinato
             MVM_store(&thread_obj->body.stage, MVM_thread_stage_destroyed);
         }
         else {
-            /* Free gen2 unmarked if full collection. */
+            /* Free gen2 unmarked if full collection. Each thread taking part
+             * does so for the threads whose work it did, so the sweep is
+             * shared out between them. */
             if (gen == MVMGCGenerations_Both) {
                 /* Tell malloc implementation to free empty pages to kernel.
                  * Currently only activated for Linux. */
@@ -245,6 +336,14 @@ static void finish_gc(MVMThreadContext *tc, MVMuint8 gen, MVMuint8 is_coordinato
                 other->thread_id);
             MVM_gc_collect_free_nursery_uncopied(tc, other, tc->gc_work[i].limit);
 
+            /* Note how much of the nursery survived, for sizing it. */
+            {
+                MVMuint64 used = (char *)tc->gc_work[i].limit - (char *)other->nursery_fromspace;
+                MVMuint64 survived = ((char *)other->nursery_alloc - (char *)other->nursery_tospace)
+                    + other->gc_promoted_bytes;
+                other->nursery_survival_percent = used ? (MVMuint32)(survived * 100 / used) : 0;
+            }
+
             /* Handle exited threads. */
             if (MVM_load(&thread_obj->body.stage) == MVM_thread_stage_exited) {
                 /* Don't bother freeing gen2; we'll do it next time */
@@ -379,13 +478,15 @@ MVMint32 MVM_gc_is_thread_blocked(MVMThreadContext *tc) {
            gc_status == MVMGCStatus_STOLEN;
 }
 
-static MVMint32 is_full_collection(MVMThreadContext *tc) {
+/* Checks if the amount promoted into gen2 since the last full collection
+ * has reached the specified minimum and percentage of the resident set. */
+static MVMint32 gen2_has_grown(MVMThreadContext *tc, MVMuint64 threshold_percent, MVMuint64 threshold_minimum) {
     MVMuint64 percent_growth, promoted;
     size_t rss;
 
     /* If it's below the absolute minimum, quickly return. */
     promoted = (MVMuint64)MVM_load(&tc->instance->gc_promoted_bytes_since_last_full);
-    if (promoted < MVM_GC_GEN2_THRESHOLD_MINIMUM)
+    if (promoted < threshold_minimum)
         return 0;
 
     /* If we're heap profiling then don't consider the resident set size, as
@@ -398,7 +499,46 @@ static MVMint32 is_full_collection(MVMThreadContext *tc) {
         rss = 50 * 1024 * 1024;
     percent_growth = (100 * promoted) / (MVMuint64)rss;
 
-    return percent_growth >= MVM_GC_GEN2_THRESHOLD_PERCENT;
+    return percent_growth >= threshold_percent;
+}
+
+static MVMint32 is_full_collection(MVMThreadContext *tc) {
+    /* If we have been marking gen2 incrementally and there's nothing left
+     * to mark, a full collection now just needs to do the remark. */
+    if (tc->instance->gc_incremental_marking == MVM_GC_INCREMENTAL_REMARK)
+        return 1;
+    return gen2_has_grown(tc, MVM_GC_GEN2_THRESHOLD_PERCENT,
+        MVM_GC_GEN2_THRESHOLD_MINIMUM);
+}
+
+/* Does incremental marking of gen2 at the end of a nursery collection,
+ * starting it if gen2 has grown enough that a full collection is coming up.
+ * We don't do it while heap profiling, since then every collection after the
+ * minimum amount of promotion is a full one. */
+static void mark_gen2_incrementally(MVMThreadContext *tc) {
+    MVMInstance *instance = tc->instance;
+    if (!instance->gc_incremental_enabled || MVM_profile_heap_profiling(tc))
+        return;
+    if (instance->gc_incremental_marking == MVM_GC_INCREMENTAL_IDLE) {
+        if (!gen2_has_grown(tc, MVM_GC_INCREMENTAL_START_PERCENT,
+                MVM_GC_INCREMENTAL_START_MINIMUM))
+            return;
+        MVM_gc_incremental_start(tc);
+    }
+    if (instance->gc_incremental_marking == MVM_GC_INCREMENTAL_MARKING)
+        MVM_gc_incremental_step(tc, MVM_GC_INCREMENTAL_MARK_BUDGET);
+}
+
+/* Does the main collection for one of the threads in our work list. */
+static void collect_thread(MVMThreadContext *tc, MVMuint32 i, MVMuint8 what_to_do, MVMuint8 gen) {
+    MVMThreadContext *other = tc->gc_work[i].tc;
+    tc->gc_work[i].limit = other->nursery_alloc;
+    GCDEBUG_LOG(tc, MVM_GC_DEBUG_ORCHESTRATE, "Thread %d run %d : starting collection for thread %d\n",
+        other->thread_id);
+    other->gc_promoted_bytes = 0;
+    if (tc->instance->profiling)
+        MVM_profiler_log_gen2_roots(tc, other->num_gen2roots, other);
+    MVM_gc_collect(other, (other == tc ? what_to_do : MVMGCWhatToDo_NoInstance), gen);
 }
 
 static void run_gc(MVMThreadContext *tc, MVMuint8 what_to_do) {
@@ -432,17 +572,12 @@ static void run_gc(MVMThreadContext *tc, MVMuint8 what_to_do) {
     if (is_coordinator)
         start_time = uv_hrtime();
 
-    /* Do GC work for ourselves and any work threads. */
-    for (i = 0, n = tc->gc_work_count ; i < n; i++) {
-        MVMThreadContext *other = tc->gc_work[i].tc;
-        tc->gc_work[i].limit = other->nursery_alloc;
-        GCDEBUG_LOG(tc, MVM_GC_DEBUG_ORCHESTRATE, "Thread %d run %d : starting collection for thread %d\n",
-            other->thread_id);
-        other->gc_promoted_bytes = 0;
-        if (tc->instance->profiling)
-            MVM_profiler_log_gen2_roots(tc, other->num_gen2roots, other);
-        MVM_gc_collect(other, (other == tc ? what_to_do : MVMGCWhatToDo_NoInstance), gen);
-    }
+    /* Do GC work for ourselves, then help with that of the threads whose
+     * work was stolen. */
+    for (i = 0, n = tc->gc_work_count ; i < n; i++)
+        collect_thread(tc, i, what_to_do, gen);
+    while (claim_stolen_work(tc))
+        collect_thread(tc, tc->gc_work_count - 1, what_to_do, gen);
 
     /* Wait for everybody to agree we're done. */
     finish_gc(tc, gen, is_coordinator);
@@ -571,13 +706,20 @@ void MVM_gc_enter_from_allocator(MVMThreadContext *tc) {
          * can also free the STables. */
         MVM_store(&tc->instance->gc_finish, num_threads + 1);
         MVM_store(&tc->instance->gc_ack, num_threads + 2);
+        MVM_store(&tc->instance->gc_mark_participants, num_threads + 1);
+        MVM_store(&tc->instance->gc_mark_idle, 0);
+
         GCDEBUG_LOG(tc, MVM_GC_DEBUG_ORCHESTRATE, "Thread %d run %d : finish votes is %d\n",
             (int)MVM_load(&tc->instance->gc_finish));
 
         /* Now we're ready to start, zero promoted since last full collection
-         * counter if this is a full collect. */
-        if (tc->instance->gc_full_collect)
+         * counter if this is a full collect. Any incremental marking of gen2
+         * ends with it; now that all the other threads have stopped, no more
+         * write barriers will want to grey objects. */
+        if (tc->instance->gc_full_collect) {
             MVM_store(&tc->instance->gc_promoted_bytes_since_last_full, 0);
+            tc->instance->gc_incremental_marking = MVM_GC_INCREMENTAL_IDLE;
+        }
 
         /* This is a safe point for us to free any STables that have been marked
          * for deletion in the previous collection (since we let finalization -
@@ -586,6 +728,9 @@ void MVM_gc_enter_from_allocator(MVMThreadContext *tc) {
         GCDEBUG_LOG(tc, MVM_GC_DEBUG_ORCHESTRATE, "Thread %d run %d : Freeing STables if needed\n");
         MVM_gc_collect_free_stables(tc);
 
+        /* Let everyone taking part help with the work we stole. */
+        share_stolen_work(tc);
+
         /* Signal to the rest to start */
         GCDEBUG_LOG(tc, MVM_GC_DEBUG_ORCHESTRATE, "Thread %d run %d : coordinator signalling start\n");
         uv_mutex_lock(&tc->instance->mutex_gc_orchestrate);
@@ -88,14 +88,13 @@ void MVM_gc_root_add_instance_roots_to_worklist(MVMThreadContext *tc, MVMGCWorkl
     add_collectable(tc, worklist, snapshot, tc->instance->event_loop_free_indices,
         "Event loop active free indices list");
 
-    add_collectable(tc, worklist, snapshot, tc->instance->spesh_thread,
-        "Specialization thread");
+    if (tc->instance->spesh_threads)
+        for (i = 0; i < tc->instance->spesh_workers; i++)
+            add_collectable(tc, worklist, snapshot, tc->instance->spesh_threads[i],
+                "Specialization thread");
     add_collectable(tc, worklist, snapshot, tc->instance->spesh_queue,
         "Specialization log queue");
 
-    if (worklist)
-        MVM_spesh_plan_gc_mark(tc, tc->instance->spesh_plan, worklist);
-
     int_to_str_cache = tc->instance->int_to_str_cache;
     for (i = 0; i < MVM_INT_TO_STR_CACHE_SIZE; i++)
         add_collectable(tc, worklist, snapshot, int_to_str_cache[i],
@@ -215,6 +214,8 @@ void MVM_gc_root_add_tc_roots_to_worklist(MVMThreadContext *tc, MVMGCWorklist *w
         else
             MVM_spesh_graph_describe(tc, tc->spesh_active_graph, snapshot);
     }
+    if (worklist)
+        MVM_spesh_plan_gc_mark(tc, tc->spesh_plan, worklist);
     if (worklist)
         MVM_spesh_plugin_guard_list_mark(tc, tc->plugin_guards, tc->num_plugin_guards, worklist);
     if (tc->temp_plugin_guards)
@@ -8,11 +8,20 @@
  * run - even a nursery only one - since somewhere it has references
  * to a nursery object. */
 void MVM_gc_write_barrier_hit(MVMThreadContext *tc, MVMCollectable *update_root) {
+    if (update_root->flags & MVM_CF_GEN2_LIVE)
+        MVM_gc_incremental_regrey(tc, update_root);
     if (!(update_root->flags & MVM_CF_IN_GEN2_ROOT_LIST))
         MVM_gc_root_gen2_add(tc, update_root);
 }
 void MVM_gc_write_barrier_hit_by(MVMThreadContext *tc, MVMCollectable *update_root,
                                  MVMCollectable *referenced) {
+    /* If gen2 is being marked incrementally and the object was already
+     * marked, but the one it now references was not, it needs to be scanned
+     * again. */
+    if (update_root->flags & ~referenced->flags & MVM_CF_GEN2_LIVE)
+        MVM_gc_incremental_regrey(tc, update_root);
+    if (referenced->flags & MVM_CF_SECOND_GEN)
+        return;
     if (!(update_root->flags & MVM_CF_IN_GEN2_ROOT_LIST))
         MVM_gc_root_gen2_add(tc, update_root);
     referenced->flags |= MVM_CF_REF_FROM_GEN2;
@@ -5,9 +5,14 @@ MVM_PUBLIC void MVM_gc_write_barrier_hit_by(MVMThreadContext *tc, MVMCollectable
 
 /* Ensures that if a generation 2 object comes to hold a reference to a
  * nursery object, then the generation 2 object becomes an inter-generational
- * root. */
+ * root. Also, while gen2 is being marked incrementally, ensures that if an
+ * object that was already marked comes to hold a reference to one that is
+ * not, the object will be scanned again (an object is only ever marked when
+ * incremental marking is in progress or during a full collection). */
 MVM_STATIC_INLINE void MVM_gc_write_barrier(MVMThreadContext *tc, MVMCollectable *update_root, MVMCollectable *referenced) {
-    if (((update_root->flags & MVM_CF_SECOND_GEN) && referenced && !(referenced->flags & MVM_CF_SECOND_GEN)))
+    if (((update_root->flags & MVM_CF_SECOND_GEN) && referenced
+            && (!(referenced->flags & MVM_CF_SECOND_GEN)
+                || (update_root->flags & ~referenced->flags & MVM_CF_GEN2_LIVE))))
         MVM_gc_write_barrier_hit_by(tc, update_root, referenced);
 }
 MVM_STATIC_INLINE void MVM_gc_write_barrier_no_update_referenced(MVMThreadContext *tc, MVMCollectable *update_root, MVMCollectable *referenced) {
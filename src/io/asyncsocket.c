@@ -473,6 +473,7 @@ static const MVMIOOps op_table = {
     &introspection,
     NULL,
     NULL,
+    NULL,
     NULL
 };
 
@@ -479,6 +479,7 @@ static const MVMIOOps op_table = {
     &introspection,
     NULL,
     NULL,
+    NULL,
     NULL
 };
 
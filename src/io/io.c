@@ -133,6 +133,45 @@ void MVM_io_read_bytes(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *res
     ((MVMArray *)result)->body.elems    = bytes_read;
 }
 
+/* Maps the contents of the handle into memory as the slots of the result
+ * buffer, which must be empty, so it can be read (and, if writable, written)
+ * without any further system calls or copying. The mode is one of the
+ * MVM_IO_MAP_* values. */
+void MVM_io_map_bytes(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *result, MVMint64 mode) {
+    MVMOSHandle *handle = verify_is_handle(tc, oshandle, "map bytes");
+    MVMArrayMapping *mapping;
+
+    /* Ensure the target is in the correct form. */
+    if (!IS_CONCRETE(result) || REPR(result)->ID != MVM_REPR_ID_VMArray)
+        MVM_exception_throw_adhoc(tc, "map_fhb requires a native array to map into");
+    if (((MVMArrayREPRData *)STABLE(result)->REPR_data)->slot_type != MVM_ARRAY_U8
+        && ((MVMArrayREPRData *)STABLE(result)->REPR_data)->slot_type != MVM_ARRAY_I8)
+        MVM_exception_throw_adhoc(tc, "map_fhb requires a native array of uint8 or int8");
+    if (((MVMArray *)result)->body.slots.any)
+        MVM_exception_throw_adhoc(tc, "map_fhb requires an empty native array");
+    if (mode < MVM_IO_MAP_READ || mode > MVM_IO_MAP_PRIVATE)
+        MVM_exception_throw_adhoc(tc, "map_fhb got unknown mode %"PRId64, mode);
+
+    if (handle->body.ops->mappable) {
+        MVMROOT2(tc, handle, result, {
+            uv_mutex_t *mutex = acquire_mutex(tc, handle);
+            mapping = handle->body.ops->mappable->map(tc, handle, mode);
+            release_mutex(tc, mutex);
+        });
+    }
+    else
+        MVM_exception_throw_adhoc(tc, "Cannot map this kind of handle into memory");
+
+    /* An empty file has nothing to map, and gives an ordinary empty buffer. */
+    if (mapping) {
+        ((MVMArray *)result)->body.slots.any = mapping->block;
+        ((MVMArray *)result)->body.start     = 0;
+        ((MVMArray *)result)->body.ssize     = mapping->size;
+        ((MVMArray *)result)->body.elems     = mapping->size;
+        ((MVMArray *)result)->body.mapping   = mapping;
+    }
+}
+
 void MVM_io_write_bytes(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *buffer) {
     MVMOSHandle *handle = verify_is_handle(tc, oshandle, "write bytes");
     char *output;
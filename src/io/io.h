@@ -13,6 +13,7 @@ struct MVMIOOps {
     MVMObject * (*get_async_task_handle) (MVMThreadContext *tc, MVMOSHandle *h);
     const MVMIOLockable        *lockable;
     const MVMIOIntrospection   *introspection;
+    const MVMIOMappable        *mappable;
     void (*set_buffer_size) (MVMThreadContext *tc, MVMOSHandle *h, MVMint64 size);
 
     /* How to mark the handle's data, if needed. */
@@ -85,12 +86,25 @@ struct MVMIOIntrospection {
     MVMint64 (*native_descriptor) (MVMThreadContext *tc, MVMOSHandle *h);
 };
 
+/* I/O operations on handles whose contents can be mapped into memory. */
+struct MVMIOMappable {
+    MVMArrayMapping * (*map) (MVMThreadContext *tc, MVMOSHandle *h, MVMint64 mode);
+};
+
+/* The ways map_fhb can bring a file into memory. A private copy is read into
+ * memory of our own and then made read-only, so unlike a mapping it never
+ * changes, whatever happens to the file. */
+#define MVM_IO_MAP_READ     0
+#define MVM_IO_MAP_WRITE    1
+#define MVM_IO_MAP_PRIVATE  2
+
 MVMint64 MVM_io_close(MVMThreadContext *tc, MVMObject *oshandle);
 MVMint64 MVM_io_is_tty(MVMThreadContext *tc, MVMObject *oshandle);
 MVMint64 MVM_io_fileno(MVMThreadContext *tc, MVMObject *oshandle);
 void MVM_io_seek(MVMThreadContext *tc, MVMObject *oshandle, MVMint64 offset, MVMint64 flag);
 MVMint64 MVM_io_tell(MVMThreadContext *tc, MVMObject *oshandle);
 void MVM_io_read_bytes(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *result, MVMint64 length);
+void MVM_io_map_bytes(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *result, MVMint64 mode);
 void MVM_io_write_bytes(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *buffer);
 void MVM_io_write_bytes_c(MVMThreadContext *tc, MVMObject *oshandle, char *output,
     MVMuint64 output_size);
@@ -1,5 +1,6 @@
 #include "moar.h"
 #include "platform/io.h"
+#include "platform/mmap.h"
 
 #ifndef _WIN32
 #include <sys/types.h>
@@ -369,6 +370,85 @@ static void unlock(MVMThreadContext *tc, MVMOSHandle *h) {
 #endif
 }
 
+/* Reads the whole file, without moving the file position, into pages of
+ * memory that are then made read-only. */
+static void copy_file(MVMThreadContext *tc, MVMIOFileData *data, char *block, size_t size) {
+    size_t copied = 0;
+    int save_errno = 0;
+    MVMint64 pos = MVM_platform_lseek(data->fd, 0, SEEK_CUR);
+    if (pos == -1 || MVM_platform_lseek(data->fd, 0, SEEK_SET) == -1)
+        save_errno = errno;
+    MVM_gc_mark_thread_blocked(tc);
+    while (!save_errno && copied < size) {
+        /* Read in chunks, as Windows can't read more than fits in an int. */
+        size_t chunk = size - copied > 0x40000000 ? 0x40000000 : size - copied;
+        int r;
+        do {
+            r = read(data->fd, block + copied, chunk);
+        } while (r == -1 && errno == EINTR);
+        if (r == -1)
+            save_errno = errno;
+        else if (r == 0)
+            break;
+        else
+            copied += r;
+    }
+    MVM_gc_mark_thread_unblocked(tc);
+    if (pos != -1)
+        MVM_platform_lseek(data->fd, pos, SEEK_SET);
+    if (save_errno) {
+        MVM_platform_free_pages(block, size);
+        MVM_exception_throw_adhoc(tc, "Failed to read file into memory: %s",
+            strerror(save_errno));
+    }
+    if (copied < size) {
+        MVM_platform_free_pages(block, size);
+        MVM_exception_throw_adhoc(tc, "File shrank while being read into memory");
+    }
+    MVM_platform_set_page_mode(block, size, MVM_PAGE_READ);
+}
+
+/* Maps the whole file into memory, or reads a private copy of it. Returns
+ * NULL if it is empty, as there is then nothing to map. */
+static MVMArrayMapping * map_file(MVMThreadContext *tc, MVMOSHandle *h, MVMint64 mode) {
+    MVMIOFileData *data = (MVMIOFileData *)h->body.data;
+    MVMArrayMapping *mapping;
+    STAT_t statbuf;
+    void *block;
+    void *handle = NULL;
+    size_t size;
+    if (data->fd == -1)
+        MVM_exception_throw_adhoc(tc, "Cannot map a closed filehandle into memory");
+    if (!data->seekable)
+        MVM_exception_throw_adhoc(tc, "It is not possible to map this kind of handle into memory");
+    flush_output_buffer(tc, data);
+    if (fstat(data->fd, &statbuf) == -1)
+        MVM_exception_throw_adhoc(tc, "Failed to stat file descriptor: %s",
+            strerror(errno));
+    if (statbuf.st_size == 0)
+        return NULL;
+    if ((MVMuint64)statbuf.st_size > SIZE_MAX)
+        MVM_exception_throw_adhoc(tc, "File is too large to map into memory");
+    size = (size_t)statbuf.st_size;
+    if (mode == MVM_IO_MAP_PRIVATE) {
+        block = MVM_platform_alloc_pages(size, MVM_PAGE_READ | MVM_PAGE_WRITE);
+        copy_file(tc, data, (char *)block, size);
+    }
+    else {
+        block = MVM_platform_map_file(data->fd, &handle, size, mode == MVM_IO_MAP_WRITE);
+        if (!block)
+            MVM_exception_throw_adhoc(tc, "Failed to map file into memory: %s",
+                strerror(errno));
+    }
+    mapping               = MVM_malloc(sizeof(MVMArrayMapping));
+    mapping->block        = block;
+    mapping->size         = size;
+    mapping->handle       = handle;
+    mapping->writable     = mode == MVM_IO_MAP_WRITE;
+    mapping->private_copy = mode == MVM_IO_MAP_PRIVATE;
+    return mapping;
+}
+
 /* Frees data associated with the handle. */
 static void gc_free(MVMThreadContext *tc, MVMObject *h, void *d) {
     MVMIOFileData *data = (MVMIOFileData *)d;
@@ -385,6 +465,7 @@ static const MVMIOSyncWritable  sync_writable = { write_bytes, flush, truncatefh
 static const MVMIOSeekable      seekable      = { seek, mvm_tell };
 static const MVMIOLockable      lockable      = { lock, unlock };
 static const MVMIOIntrospection introspection = { is_tty, mvm_fileno };
+static const MVMIOMappable      mappable      = { map_file };
 
 static const MVMIOOps op_table = {
     &closable,
@@ -398,6 +479,7 @@ static const MVMIOOps op_table = {
     NULL,
     &lockable,
     &introspection,
+    &mappable,
     &set_buffer_size,
     NULL,
     gc_free
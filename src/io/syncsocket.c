@@ -545,6 +545,7 @@ static const MVMIOOps op_table = {
     &introspection,
     NULL,
     NULL,
+    NULL,
     gc_free
 };
 
@@ -1,4 +1,5 @@
 #include "moar.h"
+#include <math.h>
 
 
 struct OpInfo {
@@ -658,6 +659,64 @@ static MVMint32 tree_is_empty(MVMThreadContext *tc, MVMJitExprTree *tree) {
     return MVM_VECTOR_ELEMS(tree->nodes) == 0;
 }
 
+/* Checks if a tree can continue from the end of a basic block into the next
+ * one. That is so if the next block can only be reached by falling through
+ * from this one, since then all values the tree has computed so far are still
+ * valid there, and can stay in registers rather than being loaded from the
+ * frame again. This is not register allocation across the whole frame: values
+ * still only get stored to the frame by active_values_flush (at guards,
+ * throwish ops, entry points and the end of the tree), a definition that is
+ * superseded within the tree is never stored at all, and any value live
+ * around a loop is stored and reloaded at the back edge as before. */
+static MVMint32 can_extend_into_next_bb(MVMThreadContext *tc, MVMJitGraph *jg, MVMSpeshBB *bb) {
+    MVMSpeshBB *next = bb->linear_next;
+    MVMSpeshIns *ins;
+    MVMSpeshAnn *ann;
+    MVMuint16 i;
+
+    if (next == NULL || next->num_pred != 1 || next->pred[0] != bb)
+        return 0;
+
+    /* Don't get in the way of bisecting the expression JIT by block or of
+     * block breakpoints. */
+    if (tc->instance->jit_expr_last_frame >= 0 || tc->instance->jit_breakpoints_num > 0)
+        return 0;
+
+    /* Don't extend past a branch. Values computed since the last flush are
+     * not yet stored to the frame, so the branch target would read stale
+     * work registers; and an explicit jump to the next block needs a real
+     * label, which would make it a second way into the tree. */
+    ins = bb->last_ins;
+    if (ins != NULL) {
+        for (i = 0; i < ins->info->num_operands; i++) {
+            if ((ins->info->operands[i] & MVM_operand_type_mask) == MVM_operand_ins)
+                return 0;
+        }
+    }
+
+    /* Handlers and OSR enter the block from elsewhere. */
+    ins = next->first_ins;
+    for (ann = ins != NULL ? ins->annotations : NULL; ann != NULL; ann = ann->next) {
+        if (ann->type == MVM_SPESH_ANN_FH_GOTO || ann->type == MVM_SPESH_ANN_DEOPT_OSR)
+            return 0;
+    }
+    return 1;
+}
+
+/* Gets the next instruction to add to the tree, continuing into the following
+ * basic blocks while that is possible. */
+static MVMSpeshIns * next_ins_in_tree(MVMThreadContext *tc, MVMJitGraph *jg,
+                                      MVMJitExprTree *tree, MVMSpeshIterator *iter) {
+    MVMSpeshIns *ins = MVM_spesh_iterator_next_ins(tc, iter);
+    while (ins == NULL && !tree_is_empty(tc, tree) && can_extend_into_next_bb(tc, jg, iter->bb)) {
+        MVM_spesh_iterator_next_bb(tc, iter);
+        MVM_VECTOR_PUSH(tree->roots, MVM_jit_expr_add_label(tc, tree,
+            MVM_jit_label_before_bb(tc, jg, iter->bb)));
+        ins = iter->ins;
+    }
+    return ins;
+}
+
 MVMJitExprTree * MVM_jit_expr_tree_build(MVMThreadContext *tc, MVMJitGraph *jg, MVMSpeshIterator *iter) {
     MVMSpeshGraph *sg = jg->sg;
     MVMSpeshIns *ins;
@@ -694,7 +753,7 @@ MVMJitExprTree * MVM_jit_expr_tree_build(MVMThreadContext *tc, MVMJitGraph *jg,
        internally linked together (relative to absolute indexes).
        Afterwards stores are inserted for computed values. */
 
-    for (ins = iter->ins; ins != NULL; ins = MVM_spesh_iterator_next_ins(tc, iter)) {
+    for (ins = iter->ins; ins != NULL; ins = next_ins_in_tree(tc, jg, tree, iter)) {
         /* NB - we probably will want to involve the spesh info in selecting a
            template. And for optimisation, I'd like to copy spesh facts (if any)
            to the tree info */
@@ -153,6 +153,7 @@ static void * op_to_func(MVMThreadContext *tc, MVMint16 opcode) {
     case MVM_OP_gethow: return MVM_6model_get_how_obj;
     case MVM_OP_box_i: return MVM_box_int;
     case MVM_OP_box_s: return MVM_box_str;
+    case MVM_OP_box_u: return MVM_box_uint;
     case MVM_OP_box_n: return MVM_box_num;
     case MVM_OP_unbox_i: return MVM_repr_get_int;
     case MVM_OP_unbox_u: return MVM_repr_get_uint;
@@ -244,6 +245,9 @@ static void * op_to_func(MVMThreadContext *tc, MVMint16 opcode) {
     case MVM_OP_gt_s: case MVM_OP_ge_s: case MVM_OP_lt_s: case MVM_OP_le_s: case MVM_OP_cmp_s: return MVM_string_compare;
 
     case MVM_OP_queuepoll: return MVM_concblockingqueue_jit_poll;
+    case MVM_OP_wsdequepush: return MVM_workstealingdeque_push;
+    case MVM_OP_wsdequepop: return MVM_workstealingdeque_pop;
+    case MVM_OP_wsdequesteal: return MVM_workstealingdeque_steal;
 
     case MVM_OP_open_dir: return MVM_dir_open;
     case MVM_OP_read_dir: return MVM_dir_read;
@@ -255,6 +259,7 @@ static void * op_to_func(MVMThreadContext *tc, MVMint16 opcode) {
     case MVM_OP_fileno_fh: return MVM_io_fileno;
     case MVM_OP_write_fhb: return MVM_io_write_bytes;
     case MVM_OP_read_fhb: return MVM_io_read_bytes;
+    case MVM_OP_map_fhb: return MVM_io_map_bytes;
 
     case MVM_OP_encode: return MVM_string_encode_to_buf;
     case MVM_OP_decoderaddbytes: return MVM_decoder_add_bytes;
@@ -283,6 +288,18 @@ static void * op_to_func(MVMThreadContext *tc, MVMint16 opcode) {
     case MVM_OP_codes_s: return MVM_string_codes;
     case MVM_OP_getcp_s: return MVM_string_get_grapheme_at;
     case MVM_OP_index_s: return MVM_string_index;
+    case MVM_OP_indexic_s: return MVM_string_index_ignore_case;
+    case MVM_OP_indexim_s: return MVM_string_index_ignore_mark;
+    case MVM_OP_indexicim_s: return MVM_string_index_ignore_case_ignore_mark;
+    case MVM_OP_rindexfrom: return MVM_string_index_from_end;
+    case MVM_OP_indexcp_s: return MVM_string_index_of_grapheme;
+    case MVM_OP_haveat_s: return MVM_string_have_at;
+    case MVM_OP_unicmp_s: return MVM_unicode_string_compare;
+    case MVM_OP_bitand_s: return MVM_string_bitand;
+    case MVM_OP_bitor_s: return MVM_string_bitor;
+    case MVM_OP_bitxor_s: return MVM_string_bitxor;
+    case MVM_OP_istrue_s: return MVM_coerce_istrue_s;
+    case MVM_OP_getuniname: return MVM_unicode_get_name;
     case MVM_OP_substr_s: return MVM_string_substring;
     case MVM_OP_join: return MVM_string_join;
     case MVM_OP_replace: return MVM_string_replace;
@@ -294,6 +311,7 @@ static void * op_to_func(MVMThreadContext *tc, MVMint16 opcode) {
     case MVM_OP_nfafromstatelist: return MVM_nfa_from_statelist;
     case MVM_OP_hllize: return MVM_hll_map;
     case MVM_OP_gethllsym: return MVM_hll_sym_get;
+    case MVM_OP_getcurhllsym: return MVM_hll_sym_get_cur;
     case MVM_OP_clone: return MVM_repr_clone;
     case MVM_OP_create: return MVM_repr_alloc_init;
     case MVM_OP_getcodeobj: return MVM_frame_get_code_object;
@@ -329,6 +347,9 @@ static void * op_to_func(MVMThreadContext *tc, MVMint16 opcode) {
     case MVM_OP_asin_n: return asin;
     case MVM_OP_acos_n: return acos;
     case MVM_OP_atan_n: return atan;
+    case MVM_OP_sinh_n: return sinh;
+    case MVM_OP_cosh_n: return cosh;
+    case MVM_OP_tanh_n: return tanh;
     case MVM_OP_atan2_n: return atan2;
     case MVM_OP_ceil_n: return ceil;
     case MVM_OP_floor_n: return floor;
@@ -337,6 +358,13 @@ static void * op_to_func(MVMThreadContext *tc, MVMint16 opcode) {
     case MVM_OP_abs_n: return fabs;
     case MVM_OP_pow_n: return pow;
     case MVM_OP_time_n: return MVM_proc_time_n;
+    case MVM_OP_time_i: return MVM_proc_time_i;
+    case MVM_OP_rand_i: return MVM_proc_rand_i;
+    case MVM_OP_rand_n: return MVM_proc_rand_n;
+    case MVM_OP_srand: return MVM_proc_seed;
+    case MVM_OP_getpid: return MVM_proc_getpid;
+    case MVM_OP_getppid: return MVM_proc_getppid;
+    case MVM_OP_threadid: return MVM_thread_id;
     case MVM_OP_randscale_n: return MVM_proc_randscale_n;
     case MVM_OP_isnanorinf: return MVM_num_isnanorinf;
     case MVM_OP_nativecallcast: return MVM_nativecall_cast;
@@ -377,6 +405,7 @@ static void * op_to_func(MVMThreadContext *tc, MVMint16 opcode) {
     case MVM_OP_atposref_s: return MVM_nativeref_pos_s;
     case MVM_OP_indexingoptimized: return MVM_string_indexing_optimized;
     case MVM_OP_sp_boolify_iter: return MVM_iter_istrue;
+    case MVM_OP_sp_boolify_iter_hash: return MVM_iter_istrue_hash;
     case MVM_OP_prof_allocated: return MVM_profile_log_allocated;
     case MVM_OP_prof_exit: return MVM_profile_log_exit;
     case MVM_OP_sp_resolvecode: return MVM_frame_resolve_invokee_spesh;
@@ -1854,6 +1883,7 @@ start:
     case MVM_OP_getwho:
     case MVM_OP_getwhere:
     case MVM_OP_sp_getspeshslot:
+    case MVM_OP_sp_issf:
     case MVM_OP_takedispatcher:
     case MVM_OP_takenextdispatcher:
     case MVM_OP_setdispatcher:
@@ -1882,7 +1912,6 @@ start:
     case MVM_OP_islist:
     case MVM_OP_ishash:
     case MVM_OP_sp_boolify_iter_arr:
-    case MVM_OP_sp_boolify_iter_hash:
     case MVM_OP_lexprimspec:
     case MVM_OP_objprimspec:
     case MVM_OP_objprimbits:
@@ -1910,11 +1939,12 @@ start:
     case MVM_OP_getcodename:
     case MVM_OP_setcodeobj:
     case MVM_OP_hllbool:
-    case MVM_OP_sp_gethashentryvalue:
         /* Profiling */
     case MVM_OP_prof_enterspesh:
     case MVM_OP_prof_enterinline:
     case MVM_OP_prof_replaced:
+        /* OSR points only survive in baseline graphs */
+    case MVM_OP_osrpoint:
     case MVM_OP_invokewithcapture:
     case MVM_OP_captureposelems:
     case MVM_OP_capturehasnameds:
@@ -2080,6 +2110,14 @@ start:
         jg_append_call_c(tc, jg, op_to_func(tc, op), 3, args, MVM_JIT_RV_PTR, dst);
         break;
     }
+    case MVM_OP_getcurhllsym: {
+        MVMint16 dst = ins->operands[0].reg.orig;
+        MVMint16 sym = ins->operands[1].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { sym } } };
+        jg_append_call_c(tc, jg, op_to_func(tc, op), 2, args, MVM_JIT_RV_PTR, dst);
+        break;
+    }
     case MVM_OP_checkarity: {
         MVMuint16 min = ins->operands[0].lit_i16;
         MVMuint16 max = ins->operands[1].lit_i16;
@@ -2662,7 +2700,8 @@ start:
         jg_append_call_c(tc, jg, op_to_func(tc, op), 4, args, MVM_JIT_RV_VOID, -1);
         break;
     }
-    case MVM_OP_sp_boolify_iter: {
+    case MVM_OP_sp_boolify_iter:
+    case MVM_OP_sp_boolify_iter_hash: {
         MVMint16 dst = ins->operands[0].reg.orig;
         MVMint16 obj = ins->operands[1].reg.orig;
         MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
@@ -2804,7 +2843,9 @@ start:
                           MVM_JIT_RV_VOID, -1);
         break;
     }
-    case MVM_OP_queuepoll: {
+    case MVM_OP_queuepoll:
+    case MVM_OP_wsdequepop:
+    case MVM_OP_wsdequesteal: {
         MVMint16 dst = ins->operands[0].reg.orig;
         MVMint16 obj = ins->operands[1].reg.orig;
         MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
@@ -2812,6 +2853,15 @@ start:
         jg_append_call_c(tc, jg, op_to_func(tc, op), 2, args, MVM_JIT_RV_PTR, dst);
         break;
     }
+    case MVM_OP_wsdequepush: {
+        MVMint16 deque = ins->operands[0].reg.orig;
+        MVMint16 value = ins->operands[1].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { deque } },
+                                 { MVM_JIT_REG_VAL, { value } } };
+        jg_append_call_c(tc, jg, op_to_func(tc, op), 3, args, MVM_JIT_RV_VOID, -1);
+        break;
+    }
     case MVM_OP_getuniprop_int:
     case MVM_OP_getuniprop_bool: {
         MVMint16 dst       = ins->operands[0].reg.orig;
@@ -2918,7 +2968,8 @@ start:
         jg_append_call_c(tc, jg, op_to_func(tc, op), 3, args, MVM_JIT_RV_VOID, -1);
         break;
     }
-    case MVM_OP_read_fhb: {
+    case MVM_OP_read_fhb:
+    case MVM_OP_map_fhb: {
         MVMint16 fho = ins->operands[0].reg.orig;
         MVMint16 res = ins->operands[1].reg.orig;
         MVMint16 len = ins->operands[2].reg.orig;
@@ -2941,6 +2992,7 @@ start:
         break;
     }
     case MVM_OP_box_s:
+    case MVM_OP_box_u:
     case MVM_OP_box_i: {
         MVMint16 dst = ins->operands[0].reg.orig;
         MVMint16 val = ins->operands[1].reg.orig;
@@ -2987,6 +3039,9 @@ start:
         /* string ops */
     case MVM_OP_repeat_s:
     case MVM_OP_split:
+    case MVM_OP_bitand_s:
+    case MVM_OP_bitor_s:
+    case MVM_OP_bitxor_s:
     case MVM_OP_concat_s: {
         MVMint16 src_a = ins->operands[1].reg.orig;
         MVMint16 src_b = ins->operands[2].reg.orig;
@@ -3162,6 +3217,60 @@ start:
         jg_append_call_c(tc, jg, op_to_func(tc, op), 4, args, MVM_JIT_RV_PTR, dst);
         break;
     }
+    case MVM_OP_indexic_s:
+    case MVM_OP_indexim_s:
+    case MVM_OP_indexicim_s:
+    case MVM_OP_rindexfrom: {
+        MVMint16 dst = ins->operands[0].reg.orig;
+        MVMint16 haystack = ins->operands[1].reg.orig;
+        MVMint16 needle = ins->operands[2].reg.orig;
+        MVMint16 start = ins->operands[3].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { haystack } },
+                                 { MVM_JIT_REG_VAL, { needle } },
+                                 { MVM_JIT_REG_VAL, { start } } };
+        jg_append_call_c(tc, jg, op_to_func(tc, op), 4, args, MVM_JIT_RV_INT, dst);
+        break;
+    }
+    case MVM_OP_indexcp_s: {
+        MVMint16 dst = ins->operands[0].reg.orig;
+        MVMint16 str = ins->operands[1].reg.orig;
+        MVMint16 cp  = ins->operands[2].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { str } },
+                                 { MVM_JIT_REG_VAL, { cp } } };
+        jg_append_call_c(tc, jg, op_to_func(tc, op), 3, args, MVM_JIT_RV_INT, dst);
+        break;
+    }
+    case MVM_OP_haveat_s:
+    case MVM_OP_unicmp_s: {
+        MVMint16 dst = ins->operands[0].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { ins->operands[1].reg.orig } },
+                                 { MVM_JIT_REG_VAL, { ins->operands[2].reg.orig } },
+                                 { MVM_JIT_REG_VAL, { ins->operands[3].reg.orig } },
+                                 { MVM_JIT_REG_VAL, { ins->operands[4].reg.orig } },
+                                 { MVM_JIT_REG_VAL, { ins->operands[5].reg.orig } } };
+        jg_append_call_c(tc, jg, op_to_func(tc, op), 6, args, MVM_JIT_RV_INT, dst);
+        break;
+    }
+    case MVM_OP_istrue_s:
+    case MVM_OP_threadid: {
+        MVMint16 dst = ins->operands[0].reg.orig;
+        MVMint16 src = ins->operands[1].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { src } } };
+        jg_append_call_c(tc, jg, op_to_func(tc, op), 2, args, MVM_JIT_RV_INT, dst);
+        break;
+    }
+    case MVM_OP_getuniname: {
+        MVMint16 dst = ins->operands[0].reg.orig;
+        MVMint16 cp  = ins->operands[1].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { cp } } };
+        jg_append_call_c(tc, jg, op_to_func(tc, op), 2, args, MVM_JIT_RV_PTR, dst);
+        break;
+    }
     case MVM_OP_iscclass: {
         MVMint16 dst    = ins->operands[0].reg.orig;
         MVMint16 cclass = ins->operands[1].reg.orig;
@@ -3505,7 +3614,10 @@ start:
     case MVM_OP_tan_n:
     case MVM_OP_asin_n:
     case MVM_OP_acos_n:
-    case MVM_OP_atan_n: {
+    case MVM_OP_atan_n:
+    case MVM_OP_sinh_n:
+    case MVM_OP_cosh_n:
+    case MVM_OP_tanh_n: {
         MVMint16 dst   = ins->operands[0].reg.orig;
         MVMint16 src   = ins->operands[1].reg.orig;
         MVMJitCallArg args[] = { { MVM_JIT_REG_VAL_F, { src } } };
@@ -3524,6 +3636,7 @@ start:
                           MVM_JIT_RV_NUM, dst);
         break;
     }
+    case MVM_OP_rand_n:
     case MVM_OP_time_n: {
         MVMint16 dst   = ins->operands[0].reg.orig;
         MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } } };
@@ -3531,6 +3644,24 @@ start:
                           MVM_JIT_RV_NUM, dst);
         break;
     }
+    case MVM_OP_rand_i:
+    case MVM_OP_time_i:
+    case MVM_OP_getpid:
+    case MVM_OP_getppid: {
+        MVMint16 dst   = ins->operands[0].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } } };
+        jg_append_call_c(tc, jg, op_to_func(tc, op), 1, args,
+                          MVM_JIT_RV_INT, dst);
+        break;
+    }
+    case MVM_OP_srand: {
+        MVMint16 seed  = ins->operands[0].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { seed } } };
+        jg_append_call_c(tc, jg, op_to_func(tc, op), 2, args,
+                          MVM_JIT_RV_VOID, -1);
+        break;
+    }
     case MVM_OP_randscale_n: {
         MVMint16 dst   = ins->operands[0].reg.orig;
         MVMint16 scale = ins->operands[1].reg.orig;
@@ -3936,6 +4067,23 @@ start:
     return 1;
 }
 
+/* Records that we're giving up on compiling a frame because of an op, in the
+ * bail log and the profile, if either is active. */
+static void log_bail(MVMThreadContext *tc, MVMJitGraph *jg, MVMSpeshIns *ins) {
+    FILE *fh = tc->instance->jit_bail_log_fh;
+    if (fh) {
+        MVMStaticFrame *sf = jg->sg->sf;
+        char *name_cstr  = MVM_string_utf8_encode_C_string(tc, sf->body.name);
+        char *cuuid_cstr = MVM_string_utf8_encode_C_string(tc, sf->body.cuuid);
+        fprintf(fh, "BAIL: op <%s> in frame '%s' (%s)\n", ins->info->name,
+            name_cstr, cuuid_cstr);
+        MVM_free(name_cstr);
+        MVM_free(cuuid_cstr);
+    }
+    if (tc->instance->main_thread->prof_data)
+        MVM_profiler_log_jit_bail(tc, ins->info->opcode);
+}
+
 static MVMint32 consume_bb(MVMThreadContext *tc, MVMJitGraph *jg,
                            MVMSpeshIterator *iter, MVMSpeshBB *bb) {
     MVMJitExprTree *tree = NULL;
@@ -3945,18 +4093,19 @@ static MVMint32 consume_bb(MVMThreadContext *tc, MVMJitGraph *jg,
 
     /* add a jit breakpoint if required */
     for (i = 0; i < tc->instance->jit_breakpoints_num; i++) {
-        if (tc->instance->jit_breakpoints[i].frame_nr == tc->instance->spesh_produced &&
+        if (tc->instance->jit_breakpoints[i].frame_nr == tc->spesh_produced &&
             tc->instance->jit_breakpoints[i].block_nr == iter->bb->idx) {
             jg_append_control(tc, jg, bb->first_ins, MVM_JIT_CONTROL_BREAKPOINT);
             break; /* one is enough though */
         }
     }
 
-    /* Try to create an expression tree */
-    if (tc->instance->jit_expr_enabled &&
+    /* Try to create an expression tree, unless this is a baseline candidate,
+     * which just stitches together the templates for each op. */
+    if (tc->instance->jit_expr_enabled && !jg->sg->is_baseline &&
         (tc->instance->jit_expr_last_frame < 0 ||
-         tc->instance->spesh_produced < tc->instance->jit_expr_last_frame ||
-         (tc->instance->spesh_produced == tc->instance->jit_expr_last_frame &&
+         tc->spesh_produced < tc->instance->jit_expr_last_frame ||
+         (tc->spesh_produced == tc->instance->jit_expr_last_frame &&
           (tc->instance->jit_expr_last_bb < 0 ||
            iter->bb->idx <= tc->instance->jit_expr_last_bb)))) {
 
@@ -3980,8 +4129,10 @@ static MVMint32 consume_bb(MVMThreadContext *tc, MVMJitGraph *jg,
     /* Try to consume the (rest of the) basic block per instruction */
     while (iter->ins) {
         before_ins(tc, jg, iter, iter->ins);
-        if(!consume_ins(tc, jg, iter, iter->ins))
+        if(!consume_ins(tc, jg, iter, iter->ins)) {
+            log_bail(tc, jg, iter->ins);
             return 0;
+        }
         after_ins(tc, jg, iter, iter->ins);
         MVM_spesh_iterator_next_ins(tc, iter);
     }
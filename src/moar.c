@@ -72,15 +72,35 @@ static FILE *fopen_perhaps_with_pid(char *env_var, char *path, const char *mode)
     exit(1);
 }
 
+/* Gets the value of an environment variable that should be a whole number
+ * from min to max. If it's not set, returns the default; if it's set to
+ * anything else, warns and returns the default. */
+static MVMint64 env_number(const char *env_var, MVMint64 min, MVMint64 max, MVMint64 def) {
+    char *value = getenv(env_var);
+    char *end;
+    long result;
+    if (!value || !value[0])
+        return def;
+    errno  = 0;
+    result = strtol(value, &end, 10);
+    if (errno || *end || result < min || result > max) {
+        fprintf(stderr, "MoarVM: Ignoring `%s` as it is not a number from %"PRId64" to %"PRId64": %s\n",
+            env_var, min, max, value);
+        return def;
+    }
+    return result;
+}
+
 /* Create a new instance of the VM. */
 MVMInstance * MVM_vm_create_instance(void) {
     MVMInstance *instance;
 
     char *spesh_log, *spesh_nodelay, *spesh_disable, *spesh_inline_disable,
          *spesh_osr_disable, *spesh_limit, *spesh_blocking, *spesh_inline_log,
-         *spesh_pea_disable;
-    char *jit_expr_disable, *jit_disable, *jit_last_frame, *jit_last_bb;
-    char *dynvar_log;
+         *spesh_pea_disable, *spesh_licm_disable, *spesh_cache_dir,
+         *spesh_stats_dump, *spesh_stats_preload;
+    char *jit_expr_disable, *jit_disable, *jit_baseline_disable, *jit_last_frame, *jit_last_bb;
+    char *dynvar_log, *gc_incremental_disable, *gc_gen2_stats_log;
     int init_stat;
 
     /* Set up instance data structure. */
@@ -121,6 +141,19 @@ MVMInstance * MVM_vm_create_instance(void) {
     init_cond(instance->cond_gc_completed, "GC completed");
     init_cond(instance->cond_gc_intrays_clearing, "GC intrays clearing");
     init_cond(instance->cond_blocked_can_continue, "GC thread unblock");
+    gc_incremental_disable = getenv("MVM_GC_INCREMENTAL_DISABLE");
+    if (!gc_incremental_disable || !gc_incremental_disable[0])
+        instance->gc_incremental_enabled = 1;
+    instance->gc_nursery_max_size = (MVMuint32)env_number(
+        "MVM_GC_NURSERY_MAX_SIZE", 0, 0x7FFFFFFF, MVM_NURSERY_MAX_SIZE);
+    if (instance->gc_nursery_max_size < MVM_NURSERY_SIZE)
+        instance->gc_nursery_max_size = MVM_NURSERY_SIZE;
+    instance->gc_gen2_release_percent = (MVMuint32)env_number(
+        "MVM_GC_GEN2_RELEASE_PERCENT", 0, 100, MVM_GEN2_RELEASE_PERCENT);
+    gc_gen2_stats_log = getenv("MVM_GC_GEN2_STATS_LOG");
+    if (gc_gen2_stats_log && gc_gen2_stats_log[0])
+        instance->gc_gen2_stats_log_fh = fopen_perhaps_with_pid(
+            "MVM_GC_GEN2_STATS_LOG", gc_gen2_stats_log, "w");
 
     /* Safe point free list. */
     init_mutex(instance->mutex_free_at_safepoint, "safepoint free list");
@@ -234,6 +267,9 @@ MVMInstance * MVM_vm_create_instance(void) {
         spesh_pea_disable = getenv("MVM_SPESH_PEA_DISABLE");
         if (!spesh_pea_disable || !spesh_pea_disable[0])
             instance->spesh_pea_enabled = 1;
+        spesh_licm_disable = getenv("MVM_SPESH_LICM_DISABLE");
+        if (!spesh_licm_disable || !spesh_licm_disable[0])
+            instance->spesh_licm_enabled = 1;
     }
 
     init_mutex(instance->mutex_parameterization_add, "parameterization");
@@ -263,6 +299,38 @@ MVMInstance * MVM_vm_create_instance(void) {
     if (spesh_inline_log && spesh_inline_log[0])
         instance->spesh_inline_log = 1;
 
+    /* How many specialization worker threads should we run? The log and
+     * the limit are only useful if specializations are produced in a
+     * predictable order, so they force a single worker. */
+    instance->spesh_workers = (MVMuint32)env_number("MVM_SPESH_WORKERS", 1,
+        MVM_SPESH_WORKERS_MAX, MVM_SPESH_WORKERS_DEFAULT);
+    if (instance->spesh_log_fh || instance->spesh_limit)
+        instance->spesh_workers = 1;
+    init_mutex(instance->mutex_spesh_intake, "spesh intake");
+    init_mutex(instance->mutex_spesh_stats, "spesh statistics");
+    init_cond(instance->cond_spesh_stats, "spesh statistics");
+
+    /* Should we remember hot frames between runs? */
+    spesh_cache_dir = getenv("MVM_SPESH_CACHE_DIR");
+    if (spesh_cache_dir && spesh_cache_dir[0]) {
+        size_t len = strlen(spesh_cache_dir) + 1;
+        uv_fs_t req;
+        instance->spesh_cache_dir = MVM_malloc(len);
+        memcpy(instance->spesh_cache_dir, spesh_cache_dir, len);
+        uv_fs_mkdir(NULL, &req, spesh_cache_dir, 0755, NULL);
+        uv_fs_req_cleanup(&req);
+    }
+
+    /* Should we dump statistics for a later run, or preload those dumped by
+     * an earlier one? */
+    spesh_stats_dump = getenv("MVM_SPESH_STATS_DUMP");
+    if (spesh_stats_dump && spesh_stats_dump[0])
+        instance->spesh_stats_dump_fh
+            = fopen_perhaps_with_pid("MVM_SPESH_STATS_DUMP", spesh_stats_dump, "w");
+    spesh_stats_preload = getenv("MVM_SPESH_STATS_PRELOAD");
+    if (spesh_stats_preload && spesh_stats_preload[0])
+        MVM_spesh_preload_read(instance, spesh_stats_preload);
+
     /* JIT environment/logging setup. */
     jit_disable = getenv("MVM_JIT_DISABLE");
     if (!jit_disable || !jit_disable[0])
@@ -272,6 +340,11 @@ MVMInstance * MVM_vm_create_instance(void) {
     if (!jit_expr_disable || strlen(jit_expr_disable) == 0)
         instance->jit_expr_enabled = 1;
 
+    /* Baseline compilation is only worth it if we can JIT compile. */
+    jit_baseline_disable = getenv("MVM_JIT_BASELINE_DISABLE");
+    if (instance->jit_enabled && instance->spesh_enabled
+            && (!jit_baseline_disable || !jit_baseline_disable[0]))
+        instance->spesh_baseline_enabled = 1;
 
     {
         char *jit_debug = getenv("MVM_JIT_DEBUG");
@@ -310,6 +383,13 @@ MVMInstance * MVM_vm_create_instance(void) {
         }
     }
 
+    {
+        char *jit_bail_log = getenv("MVM_JIT_BAIL_LOG");
+        if (jit_bail_log && jit_bail_log[0])
+            instance->jit_bail_log_fh
+                = fopen_perhaps_with_pid("MVM_JIT_BAIL_LOG", jit_bail_log, "w");
+    }
+
     jit_last_frame = getenv("MVM_JIT_EXPR_LAST_FRAME");
     jit_last_bb    = getenv("MVM_JIT_EXPR_LAST_BB");
 
@@ -508,9 +588,18 @@ void MVM_vm_exit(MVMInstance *instance) {
     MVM_thread_join_foreground(instance->main_thread);
     MVM_io_flush_standard_handles(instance->main_thread);
 
+    /* Remember which frames were hot for next time. */
+    MVM_spesh_cache_save(instance);
+
     /* Close any spesh or jit log. */
     if (instance->spesh_log_fh)
         fclose(instance->spesh_log_fh);
+    if (instance->spesh_stats_dump_fh)
+        fflush(instance->spesh_stats_dump_fh);
+    if (instance->jit_bail_log_fh)
+        fflush(instance->jit_bail_log_fh);
+    if (instance->gc_gen2_stats_log_fh)
+        fclose(instance->gc_gen2_stats_log_fh);
     if (instance->dynvar_log_fh) {
         fprintf(instance->dynvar_log_fh, "- x 0 0 0 0 %"PRId64" %"PRIu64" %"PRIu64"\n", instance->dynvar_log_lasttime, uv_hrtime(), uv_hrtime());
         fclose(instance->dynvar_log_fh);
@@ -558,6 +647,9 @@ void MVM_vm_destroy_instance(MVMInstance *instance) {
     /* Stop system threads */
     MVM_spesh_worker_stop(instance->main_thread);
     MVM_spesh_worker_join(instance->main_thread);
+
+    /* Remember which frames were hot for next time. */
+    MVM_spesh_cache_save(instance);
     MVM_io_eventloop_destroy(instance->main_thread);
 
     /* Run the normal GC one more time to actually collect the spesh thread */
@@ -576,6 +668,7 @@ void MVM_vm_destroy_instance(MVMInstance *instance) {
     uv_mutex_destroy(&instance->mutex_permroots);
     MVM_free(instance->permroots);
     MVM_free(instance->permroot_descriptions);
+    MVM_free(instance->gc_stolen);
     uv_cond_destroy(&instance->cond_gc_start);
     uv_cond_destroy(&instance->cond_gc_finish);
     uv_cond_destroy(&instance->cond_gc_intrays_clearing);
@@ -637,12 +730,23 @@ void MVM_vm_destroy_instance(MVMInstance *instance) {
 
     /* Clean up spesh mutexes and close any log. */
     uv_mutex_destroy(&instance->mutex_spesh_install);
+    uv_mutex_destroy(&instance->mutex_spesh_intake);
+    uv_mutex_destroy(&instance->mutex_spesh_stats);
+    uv_cond_destroy(&instance->cond_spesh_stats);
     uv_cond_destroy(&instance->cond_spesh_sync);
     uv_mutex_destroy(&instance->mutex_spesh_sync);
+    MVM_free(instance->spesh_threads);
+    MVM_free(instance->speshworker_thread_ids);
+    MVM_spesh_cache_destroy(instance);
+    MVM_spesh_preload_destroy(instance);
     if (instance->spesh_log_fh)
         fclose(instance->spesh_log_fh);
+    if (instance->gc_gen2_stats_log_fh)
+        fclose(instance->gc_gen2_stats_log_fh);
     if (instance->jit_perf_map)
         fclose(instance->jit_perf_map);
+    if (instance->jit_bail_log_fh)
+        fclose(instance->jit_bail_log_fh);
     if (instance->dynvar_log_fh)
         fclose(instance->dynvar_log_fh);
     if (instance->jit_bytecode_dir)
@@ -100,6 +100,8 @@ MVM_PUBLIC MVMint32 MVM_jit_support(void);
 #include "core/threadcontext.h"
 #include "core/instance.h"
 #include "strings/uthash.h"
+#include "core/str_hash_table.h"
+#include "core/index_hash_table.h"
 #include "core/interp.h"
 #include "core/callsite.h"
 #include "core/args.h"
@@ -142,10 +144,12 @@ MVM_PUBLIC MVMint32 MVM_jit_support(void);
 #include "gc/roots.h"
 #include "gc/objectid.h"
 #include "gc/finalize.h"
+#include "gc/incremental.h"
 #include "core/regionalloc.h"
 #include "spesh/dump.h"
 #include "spesh/debug.h"
 #include "spesh/pea.h"
+#include "spesh/licm.h"
 #include "spesh/graph.h"
 #include "spesh/codegen.h"
 #include "spesh/candidate.h"
@@ -159,6 +163,8 @@ MVM_PUBLIC MVMint32 MVM_jit_support(void);
 #include "spesh/deopt.h"
 #include "spesh/log.h"
 #include "spesh/threshold.h"
+#include "spesh/cache.h"
+#include "spesh/preload.h"
 #include "spesh/inline.h"
 #include "spesh/osr.h"
 #include "spesh/iterator.h"
@@ -179,6 +185,8 @@ MVM_PUBLIC MVMint32 MVM_jit_support(void);
 #include "strings/utf16.h"
 #include "strings/iter.h"
 #include "strings/ops.h"
+#include "core/str_hash_table_funcs.h"
+#include "core/index_hash_table_funcs.h"
 #include "strings/unicode_gen.h"
 #include "strings/unicode.h"
 #include "strings/latin1.h"
@@ -427,6 +427,7 @@ typedef struct {
     MVMString *deopt_one;
     MVMString *deopt_all;
     MVMString *spesh_time;
+    MVMString *jit_bails;
     MVMString *thread;
     MVMString *native_lib;
     MVMString *managed_size;
@@ -768,6 +769,23 @@ static MVMObject * dump_thread_data(MVMThreadContext *tc, ProfDumpStrs *pds,
     MVM_repr_bind_key_o(tc, thread_hash, pds->spesh_time,
         box_i(tc, ptd->spesh_time / 1000));
 
+    /* Add the ops that the JIT bailed on, if any. */
+    {
+        MVMObject *jit_bails = NULL;
+        MVMuint32 i;
+        for (i = 0; i <= MVM_OP_EXT_BASE; i++) {
+            MVMuint64 count = MVM_load(&(ptd->jit_bails[i]));
+            if (count) {
+                const char *name = i < MVM_OP_EXT_BASE ? MVM_op_get_op(i)->name : "extop";
+                if (!jit_bails)
+                    jit_bails = new_hash(tc);
+                MVM_repr_bind_key_o(tc, jit_bails, str(tc, name), box_i(tc, count));
+            }
+        }
+        if (jit_bails)
+            MVM_repr_bind_key_o(tc, thread_hash, pds->jit_bails, jit_bails);
+    }
+
     /* Add thread id. */
     MVM_repr_bind_key_o(tc, thread_hash, pds->thread,
         box_i(tc, othertc->thread_id));
@@ -828,6 +846,7 @@ void MVM_profile_dump_instrumented_data(MVMThreadContext *tc) {
         pds.deopt_one       = str(tc, "deopt_one");
         pds.deopt_all       = str(tc, "deopt_all");
         pds.spesh_time      = str(tc, "spesh_time");
+        pds.jit_bails       = str(tc, "jit_bails");
         pds.thread          = str(tc, "thread");
         pds.native_lib      = str(tc, "native library");
         pds.managed_size    = str(tc, "managed_size");
@@ -593,6 +593,13 @@ void MVM_profiler_log_spesh_end(MVMThreadContext *tc) {
     ptd->spesh_time += spesh_time;
 }
 
+/* Log that the JIT gave up on a frame because of an op with the given
+ * opcode. */
+void MVM_profiler_log_jit_bail(MVMThreadContext *tc, MVMuint16 opcode) {
+    MVMProfileThreadData *ptd = get_thread_data(tc->instance->main_thread);
+    MVM_incr(&(ptd->jit_bails[opcode < MVM_OP_EXT_BASE ? opcode : MVM_OP_EXT_BASE]));
+}
+
 /* Log that an on stack replacement took place. */
 void MVM_profiler_log_osr(MVMThreadContext *tc, MVMuint64 jitted) {
     MVMProfileThreadData *ptd = get_thread_data(tc);
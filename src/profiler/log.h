@@ -49,6 +49,11 @@ struct MVMProfileThreadData {
     /* Current spesh work start time, if any. */
     MVMuint64 cur_spesh_start_time;
 
+    /* Number of frames the JIT gave up on, by the opcode that made it do
+     * so; extension ops are all counted in the last slot. Updated by the
+     * spesh workers. */
+    AO_t jit_bails[MVM_OP_EXT_BASE + 1];
+
     /* Current GC start time, if any. */
     MVMuint64 cur_gc_start_time;
 
@@ -239,6 +244,7 @@ void MVM_profiler_log_gc_deallocate(MVMThreadContext *tc, MVMObject *object);
 void MVM_profiler_log_unmanaged_data_promoted(MVMThreadContext *tc, MVMuint64 amount);
 void MVM_profiler_log_spesh_start(MVMThreadContext *tc);
 void MVM_profiler_log_spesh_end(MVMThreadContext *tc);
+void MVM_profiler_log_jit_bail(MVMThreadContext *tc, MVMuint16 opcode);
 void MVM_profiler_log_osr(MVMThreadContext *tc, MVMuint64 jitted);
 void MVM_profiler_log_deopt_one(MVMThreadContext *tc);
 void MVM_profiler_log_deopt_all(MVMThreadContext *tc);
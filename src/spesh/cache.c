@@ -0,0 +1,202 @@
+#include "moar.h"
+#include "platform/io.h"
+
+/* The specialization cache only remembers which frames were hot, keyed by
+ * compilation unit bytecode hash and frame index (with the cuuid checked on
+ * load), so they cross a much lower threshold in the next run. The statistics
+ * those frames were planned from are persisted by spesh/preload.c, when
+ * MVM_SPESH_STATS_DUMP and MVM_SPESH_STATS_PRELOAD are used. Plans and
+ * candidates are never persisted: they are made again from the statistics of
+ * the new run, so their guards always hold for the types that exist now. */
+
+/* The key used to hash bytecode. It must be the same in every process, so we
+ * can't use the instance's hash secrets. */
+static const MVMuint64 cache_hash_key[2] = { 0x4d6f6172564d2d73ULL, 0x706573682d636163ULL };
+
+/* Forms the path of the cache file for compilation units with the specified
+ * hash. */
+static char * cache_file_path(MVMInstance *instance, MVMuint64 cu_hash) {
+    size_t len = strlen(instance->spesh_cache_dir) + 32;
+    char *path = MVM_malloc(len);
+    snprintf(path, len, "%s/%016"PRIx64".spesh", instance->spesh_cache_dir, cu_hash);
+    return path;
+}
+
+/* Gets the hash of a compilation unit's bytecode, computing it if needed. */
+MVMuint64 MVM_spesh_cache_hash(MVMThreadContext *tc, MVMCompUnit *cu) {
+    if (!cu->body.spesh_cache_hash)
+        cu->body.spesh_cache_hash = siphash24(cu->body.data_start, cu->body.data_size,
+            cache_hash_key);
+    return cu->body.spesh_cache_hash;
+}
+
+/* Looks up the index of a static frame in its compilation unit. Returns -1
+ * if it isn't one of the frames that was loaded from bytecode (for example,
+ * if it was added by the inliner). */
+MVMint64 MVM_spesh_cache_frame_index(MVMThreadContext *tc, MVMStaticFrame *sf) {
+    MVMCompUnit *cu = sf->body.cu;
+    MVMuint32 idx = sf->body.cu_frame_idx;
+    if (idx < cu->body.orig_frames && ((MVMCode *)cu->body.coderefs[idx])->body.sf == sf)
+        return idx;
+    return -1;
+}
+
+/* Adds an entry to the list of hot frames to write out. Must be called with
+ * mutex_spesh_install held. */
+static void add_entry(MVMInstance *instance, MVMuint64 cu_hash, MVMuint32 frame_idx, char *cuuid) {
+    MVMSpeshCacheEntry entry;
+    entry.cu_hash   = cu_hash;
+    entry.frame_idx = frame_idx;
+    entry.cuuid     = cuuid;
+    MVM_VECTOR_PUSH(instance->spesh_cache_entries, entry);
+}
+
+/* Called when a compilation unit has been loaded. Hashes its bytecode and,
+ * if a cache file exists for it, marks the frames listed in it as hot. */
+void MVM_spesh_cache_load(MVMThreadContext *tc, MVMCompUnit *cu) {
+    MVMInstance *instance = tc->instance;
+    char line[1024];
+    char *path;
+    FILE *fh;
+
+    if (!instance->spesh_cache_dir || !instance->spesh_enabled)
+        return;
+    path = cache_file_path(instance, MVM_spesh_cache_hash(tc, cu));
+    fh = MVM_platform_fopen(path, "r");
+    MVM_free(path);
+    if (!fh)
+        return;
+
+    /* Make sure it's a cache file in the format we understand. */
+    if (!fgets(line, sizeof(line), fh) || strncmp(line, MVM_SPESH_CACHE_HEADER,
+            strlen(MVM_SPESH_CACHE_HEADER)) != 0) {
+        fclose(fh);
+        return;
+    }
+
+    /* Each further line is a frame index and its cuuid. */
+    uv_mutex_lock(&(instance->mutex_spesh_install));
+    while (fgets(line, sizeof(line), fh)) {
+        size_t len = strlen(line);
+        char *cuuid_start;
+        char *cuuid;
+        unsigned long idx;
+        MVMStaticFrame *sf;
+
+        /* Skip anything truncated or malformed. */
+        if (len == 0 || line[len - 1] != '\n')
+            continue;
+        line[len - 1] = '\0';
+        idx = strtoul(line, &cuuid_start, 10);
+        if (cuuid_start == line || *cuuid_start != ' ' || idx >= cu->body.orig_frames)
+            continue;
+        cuuid_start++;
+
+        /* Make sure it's the frame we think it is. */
+        sf = ((MVMCode *)cu->body.coderefs[idx])->body.sf;
+        if (sf->body.spesh_cache_hot)
+            continue;
+        cuuid = MVM_string_utf8_encode_C_string(tc, sf->body.cuuid);
+        if (strcmp(cuuid, cuuid_start) != 0) {
+            MVM_free(cuuid);
+            continue;
+        }
+
+        /* It is; lower its threshold, and keep it in the cache. */
+        sf->body.spesh_cache_hot = 1;
+        add_entry(instance, cu->body.spesh_cache_hash, (MVMuint32)idx, cuuid);
+    }
+    uv_mutex_unlock(&(instance->mutex_spesh_install));
+
+    fclose(fh);
+}
+
+/* Called when a specialization of a static frame is installed, to note that
+ * the frame should be in the cache. Must be called with mutex_spesh_install
+ * held. */
+void MVM_spesh_cache_note_hot(MVMThreadContext *tc, MVMStaticFrame *sf) {
+    MVMCompUnit *cu = sf->body.cu;
+    MVMint64 idx;
+    if (!tc->instance->spesh_cache_dir || sf->body.spesh_cache_hot || !cu->body.spesh_cache_hash)
+        return;
+    idx = MVM_spesh_cache_frame_index(tc, sf);
+    if (idx < 0)
+        return;
+    sf->body.spesh_cache_hot = 1;
+    add_entry(tc->instance, cu->body.spesh_cache_hash, (MVMuint32)idx,
+        MVM_string_utf8_encode_C_string(tc, sf->body.cuuid));
+}
+
+/* Orders cache entries by compilation unit, then by frame. */
+static int compare_entries(const void *a, const void *b) {
+    const MVMSpeshCacheEntry *ea = (const MVMSpeshCacheEntry *)a;
+    const MVMSpeshCacheEntry *eb = (const MVMSpeshCacheEntry *)b;
+    if (ea->cu_hash != eb->cu_hash)
+        return ea->cu_hash < eb->cu_hash ? -1 : 1;
+    if (ea->frame_idx != eb->frame_idx)
+        return ea->frame_idx < eb->frame_idx ? -1 : 1;
+    return 0;
+}
+
+/* Writes out a cache file for each compilation unit that has hot frames.
+ * Each is written to a temporary file first and then renamed into place, so
+ * that another process loading it never sees a partially written file. */
+void MVM_spesh_cache_save(MVMInstance *instance) {
+    MVMSpeshCacheEntry *entries;
+    size_t num, i;
+    if (!instance->spesh_cache_dir)
+        return;
+
+    uv_mutex_lock(&(instance->mutex_spesh_install));
+    entries = instance->spesh_cache_entries;
+    num     = MVM_VECTOR_ELEMS(instance->spesh_cache_entries);
+    qsort(entries, num, sizeof(MVMSpeshCacheEntry), compare_entries);
+    i = 0;
+    while (i < num) {
+        MVMuint64 cu_hash = entries[i].cu_hash;
+        char *path = cache_file_path(instance, cu_hash);
+        size_t tmp_len = strlen(path) + 32;
+        char *tmp_path = MVM_malloc(tmp_len);
+        FILE *fh;
+        snprintf(tmp_path, tmp_len, "%s.%"PRIi64, path, MVM_proc_getpid(NULL));
+
+        fh = MVM_platform_fopen(tmp_path, "w");
+        if (fh) {
+            uv_fs_t req;
+            int failed;
+            fprintf(fh, "%s\n", MVM_SPESH_CACHE_HEADER);
+            for (; i < num && entries[i].cu_hash == cu_hash; i++)
+                fprintf(fh, "%"PRIu32" %s\n", entries[i].frame_idx, entries[i].cuuid);
+            failed = ferror(fh);
+            if (fclose(fh) != 0)
+                failed = 1;
+            if (!failed) {
+                failed = uv_fs_rename(NULL, &req, tmp_path, path, NULL) < 0;
+                uv_fs_req_cleanup(&req);
+            }
+            if (failed) {
+                uv_fs_unlink(NULL, &req, tmp_path, NULL);
+                uv_fs_req_cleanup(&req);
+            }
+        }
+        else {
+            /* Can't write this one; skip its entries. */
+            while (i < num && entries[i].cu_hash == cu_hash)
+                i++;
+        }
+
+        MVM_free(tmp_path);
+        MVM_free(path);
+    }
+    uv_mutex_unlock(&(instance->mutex_spesh_install));
+}
+
+/* Frees the memory associated with the cache. */
+void MVM_spesh_cache_destroy(MVMInstance *instance) {
+    size_t i;
+    for (i = 0; i < MVM_VECTOR_ELEMS(instance->spesh_cache_entries); i++)
+        MVM_free(instance->spesh_cache_entries[i].cuuid);
+    MVM_VECTOR_DESTROY(instance->spesh_cache_entries);
+    MVM_free(instance->spesh_cache_dir);
+    instance->spesh_cache_dir = NULL;
+}
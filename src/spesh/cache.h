@@ -0,0 +1,38 @@
+/* The specialization cache lets a program skip most of its warm-up when it
+ * is run again. When a cache directory is configured, we note which static
+ * frames were hot enough to be specialized, and write that out when the VM
+ * exits, in a file per compilation unit, named after a hash of its bytecode.
+ * When a compilation unit with the same bytecode is loaded in a later run,
+ * the frames that were hot last time get a much lower specialization
+ * threshold. The specializations themselves are still produced from the
+ * statistics gathered in this process, so their guards are always based on
+ * the types actually showing up now. */
+
+/* The specialization threshold for frames that were hot in an earlier run.
+ * It is not 1 so that we have a few calls' worth of type information to
+ * specialize on. */
+#define MVM_SPESH_CACHE_THRESHOLD 10
+
+/* The first line of a cache file; bump the version if the format changes. */
+#define MVM_SPESH_CACHE_HEADER "MoarVM spesh cache 1"
+
+/* A frame that was found to be hot, either in this run or in an earlier one
+ * according to the cache. */
+struct MVMSpeshCacheEntry {
+    /* The hash of the bytecode of the frame's compilation unit. */
+    MVMuint64 cu_hash;
+
+    /* The index of the frame in the compilation unit. */
+    MVMuint32 frame_idx;
+
+    /* The frame's compilation unit unique ID, which is checked on loading
+     * in case of a hash collision. */
+    char *cuuid;
+};
+
+MVMuint64 MVM_spesh_cache_hash(MVMThreadContext *tc, MVMCompUnit *cu);
+MVMint64 MVM_spesh_cache_frame_index(MVMThreadContext *tc, MVMStaticFrame *sf);
+void MVM_spesh_cache_load(MVMThreadContext *tc, MVMCompUnit *cu);
+void MVM_spesh_cache_note_hot(MVMThreadContext *tc, MVMStaticFrame *sf);
+void MVM_spesh_cache_save(MVMInstance *instance);
+void MVM_spesh_cache_destroy(MVMInstance *instance);
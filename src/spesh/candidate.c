@@ -41,7 +41,8 @@ void MVM_spesh_candidate_add(MVMThreadContext *tc, MVMSpeshPlanned *p) {
     MVMuint64 start_time = 0, spesh_time = 0, jit_time = 0, end_time;
 
     /* If we've reached our specialization limit, don't continue. */
-    MVMint32 spesh_produced = ++tc->instance->spesh_produced;
+    MVMint32 spesh_produced = (MVMint32)MVM_incr(&tc->instance->spesh_produced) + 1;
+    tc->spesh_produced = spesh_produced;
     if (tc->instance->spesh_limit)
         if (spesh_produced > tc->instance->spesh_limit)
             return;
@@ -76,13 +77,19 @@ void MVM_spesh_candidate_add(MVMThreadContext *tc, MVMSpeshPlanned *p) {
     tc->spesh_active_graph = sg;
     spesh_gc_point(tc);
 
-    /* Perform the optimization and, if we're logging, dump out the result. */
+    /* Perform the optimization and, if we're logging, dump out the result.
+     * For a baseline candidate, we only do the argument processing, and
+     * tidy up the blocks that leaves unreachable. */
+    sg->is_baseline = p->kind == MVM_SPESH_PLANNED_BASELINE;
     if (p->cs_stats->cs)
         MVM_spesh_args(tc, sg, p->cs_stats->cs, p->type_tuple);
     spesh_gc_point(tc);
     MVM_spesh_facts_discover(tc, sg, p, 0);
     spesh_gc_point(tc);
-    MVM_spesh_optimize(tc, sg, p);
+    if (sg->is_baseline)
+        MVM_spesh_eliminate_dead_bbs(tc, sg, 1);
+    else
+        MVM_spesh_optimize(tc, sg, p);
     spesh_gc_point(tc);
 
     /* Clear active graph; beyond this point, no more GC syncs. */
@@ -95,6 +102,7 @@ void MVM_spesh_candidate_add(MVMThreadContext *tc, MVMSpeshPlanned *p) {
     sc = MVM_spesh_codegen(tc, sg);
     candidate = MVM_calloc(1, sizeof(MVMSpeshCandidate));
     candidate->cs            = p->cs_stats->cs;
+    candidate->is_baseline   = sg->is_baseline;
     candidate->type_tuple    = p->type_tuple
         ? MVM_spesh_plan_copy_type_tuple(tc, candidate->cs, p->type_tuple)
         : NULL;
@@ -164,9 +172,33 @@ void MVM_spesh_candidate_add(MVMThreadContext *tc, MVMSpeshPlanned *p) {
     sg->cand = candidate;
     MVM_spesh_graph_destroy(tc, sg);
 
+    /* Other workers may be installing specializations of this frame too, and
+     * may even have produced this very one, if they got it from a different
+     * log; in that case, just throw ours away. */
+    spesh = p->sf->body.spesh;
+    uv_mutex_lock(&tc->instance->mutex_spesh_install);
+    if (MVM_spesh_plan_have_existing_specialization(tc, p->sf, candidate->cs,
+            candidate->type_tuple, candidate->is_baseline)) {
+        uv_mutex_unlock(&tc->instance->mutex_spesh_install);
+        MVM_spesh_candidate_destroy(tc, candidate);
+#if MVM_GC_DEBUG
+        tc->in_spesh = 0;
+#endif
+        return;
+    }
+
+    /* A certain specialization replaces any baseline one for its callsite. */
+    if (!candidate->type_tuple && !candidate->is_baseline) {
+        MVMuint32 i;
+        for (i = 0; i < spesh->body.num_spesh_candidates; i++) {
+            MVMSpeshCandidate *existing = spesh->body.spesh_candidates[i];
+            if (existing->is_baseline && existing->cs == candidate->cs)
+                existing->discarded = 1;
+        }
+    }
+
     /* Create a new candidate list and copy any existing ones. Free memory
      * using the FSA safepoint mechanism. */
-    spesh = p->sf->body.spesh;
     new_candidate_list = MVM_fixed_size_alloc(tc, tc->instance->fsa,
         (spesh->body.num_spesh_candidates + 1) * sizeof(MVMSpeshCandidate *));
     if (spesh->body.num_spesh_candidates) {
@@ -195,6 +227,9 @@ void MVM_spesh_candidate_add(MVMThreadContext *tc, MVMSpeshPlanned *p) {
         spesh->body.spesh_candidates, spesh->body.num_spesh_candidates + 1);
     MVM_barrier();
     spesh->body.num_spesh_candidates++;
+    if (!candidate->is_baseline)
+        MVM_spesh_cache_note_hot(tc, p->sf);
+    uv_mutex_unlock(&tc->instance->mutex_spesh_install);
 
     /* If we're logging, dump the upadated arg guards also. */
     if (MVM_spesh_debug_enabled(tc)) {
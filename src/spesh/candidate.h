@@ -10,6 +10,11 @@ struct MVMSpeshCandidate {
     /* Has the candidated been discarded? */
     MVMuint8 discarded;
 
+    /* Is this a baseline candidate, produced without optimization so that
+     * warm code gets JIT-compiled early? It is replaced by a fully optimized
+     * certain specialization once the frame gets hot. */
+    MVMuint8 is_baseline;
+
     /* Length of the specialized bytecode in bytes. */
     MVMuint32 bytecode_size;
 
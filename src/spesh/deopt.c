@@ -166,6 +166,63 @@ static void deopt_named_args_used(MVMThreadContext *tc, MVMFrame *f) {
         f->params.named_used.bit_field = f->spesh_cand->deopt_named_used_bit_field;
 }
 
+/* Materialize the attributes of a replaced P6opaque object. */
+static void materialize_p6opaque_attrs(MVMThreadContext *tc, MVMFrame *f, MVMObject *obj,
+                                       MVMSpeshPEAMaterializeInfo *mi) {
+    MVMP6opaqueREPRData *repr_data = (MVMP6opaqueREPRData *)STABLE(obj)->REPR_data;
+    char *data = (char *)OBJECT_BODY(obj);
+    MVMuint32 num_attrs = repr_data->num_attributes;
+    MVMuint32 i;
+    for (i = 0; i < num_attrs; i++) {
+        MVMRegister value = f->work[mi->attr_regs[i]];
+        MVMuint16 offset = repr_data->attribute_offsets[i];
+        MVMSTable *flattened = repr_data->flattened_stables[i];
+        if (flattened) {
+            const MVMStorageSpec *ss = flattened->REPR->get_storage_spec(tc, flattened);
+            switch (ss->boxed_primitive) {
+                case MVM_STORAGE_SPEC_BP_INT:
+                    flattened->REPR->box_funcs.set_int(tc, flattened, obj,
+                        (char *)data + offset, value.i64);
+                    break;
+                case MVM_STORAGE_SPEC_BP_NUM:
+                    flattened->REPR->box_funcs.set_num(tc, flattened, obj,
+                        (char *)data + offset, value.n64);
+                    break;
+                case MVM_STORAGE_SPEC_BP_STR:
+                    flattened->REPR->box_funcs.set_str(tc, flattened, obj,
+                        (char *)data + offset, value.s);
+                    break;
+                default:
+                    MVM_panic(1, "Unimplemented case of native attribute deopt materialization");
+            }
+        }
+        else {
+            *((MVMObject **)(data + offset)) = value.o;
+        }
+    }
+}
+
+/* Materialize the value of a replaced box (P6int, P6num or P6str). */
+static void materialize_box_value(MVMThreadContext *tc, MVMFrame *f, MVMObject *obj,
+                                  MVMSpeshPEAMaterializeInfo *mi) {
+    MVMSTable *st = STABLE(obj);
+    MVMRegister value = f->work[mi->attr_regs[0]];
+    const MVMStorageSpec *ss = st->REPR->get_storage_spec(tc, st);
+    switch (ss->boxed_primitive) {
+        case MVM_STORAGE_SPEC_BP_INT:
+            st->REPR->box_funcs.set_int(tc, st, obj, OBJECT_BODY(obj), value.i64);
+            break;
+        case MVM_STORAGE_SPEC_BP_NUM:
+            st->REPR->box_funcs.set_num(tc, st, obj, OBJECT_BODY(obj), value.n64);
+            break;
+        case MVM_STORAGE_SPEC_BP_STR:
+            st->REPR->box_funcs.set_str(tc, st, obj, OBJECT_BODY(obj), value.s);
+            break;
+        default:
+            MVM_panic(1, "Unimplemented case of box deopt materialization");
+    }
+}
+
 /* Materialize an individual replaced object. */
 static void materialize_object(MVMThreadContext *tc, MVMFrame *f, MVMObject ***materialized,
                                MVMuint16 info_idx, MVMuint16 target_reg) {
@@ -175,39 +232,12 @@ static void materialize_object(MVMThreadContext *tc, MVMFrame *f, MVMObject ***m
     if (!(*materialized)[info_idx]) {
         MVMSpeshPEAMaterializeInfo *mi = &(cand->deopt_pea.materialize_info[info_idx]);
         MVMSTable *st = (MVMSTable *)cand->spesh_slots[mi->stable_sslot];
-        MVMP6opaqueREPRData *repr_data = (MVMP6opaqueREPRData *)st->REPR_data;
         MVMROOT(tc, f, {
             MVMObject *obj = MVM_gc_allocate_object(tc, st);
-            char *data = (char *)OBJECT_BODY(obj);
-            MVMuint32 num_attrs = repr_data->num_attributes;
-            MVMuint32 i;
-            for (i = 0; i < num_attrs; i++) {
-                MVMRegister value = f->work[mi->attr_regs[i]];
-                MVMuint16 offset = repr_data->attribute_offsets[i];
-                MVMSTable *flattened = repr_data->flattened_stables[i];
-                if (flattened) {
-                    const MVMStorageSpec *ss = flattened->REPR->get_storage_spec(tc, flattened);
-                    switch (ss->boxed_primitive) {
-                        case MVM_STORAGE_SPEC_BP_INT:
-                            flattened->REPR->box_funcs.set_int(tc, flattened, obj,
-                                (char *)data + offset, value.i64);
-                            break;
-                        case MVM_STORAGE_SPEC_BP_NUM:
-                            flattened->REPR->box_funcs.set_num(tc, flattened, obj,
-                                (char *)data + offset, value.n64);
-                            break;
-                        case MVM_STORAGE_SPEC_BP_STR:
-                            flattened->REPR->box_funcs.set_str(tc, flattened, obj,
-                                (char *)data + offset, value.s);
-                            break;
-                        default:
-                            MVM_panic(1, "Unimplemented case of native attribute deopt materialization");
-                    }
-                }
-                else {
-                    *((MVMObject **)(data + offset)) = value.o;
-                }
-            }
+            if (st->REPR->ID == MVM_REPR_ID_P6opaque)
+                materialize_p6opaque_attrs(tc, f, obj, mi);
+            else
+                materialize_box_value(tc, f, obj, mi);
             (*materialized)[info_idx] = obj;
         });
 #if MVM_LOG_DEOPTS
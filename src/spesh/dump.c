@@ -260,7 +260,7 @@ static void dump_bb(MVMThreadContext *tc, DumpStr *ds, MVMSpeshGraph *g, MVMSpes
                                 ascension++, cursor = &cursor->outer->body) { };
                         if (cursor->fully_deserialized) {
                             if (cur_ins->operands[i].lex.idx < cursor->num_lexicals) {
-                                char *cstr = MVM_string_utf8_encode_C_string(tc, cursor->lexical_names_list[cur_ins->operands[i].lex.idx]->key);
+                                char *cstr = MVM_string_utf8_encode_C_string(tc, cursor->lexical_names_list[cur_ins->operands[i].lex.idx]);
                                 appendf(ds, ",%s)", cstr);
                                 MVM_free(cstr);
                             } else {
@@ -850,6 +850,9 @@ char * MVM_spesh_dump_planned(MVMThreadContext *tc, MVMSpeshPlanned *p) {
         case MVM_SPESH_PLANNED_DERIVED_TYPES:
             append(&ds, "Derived type");
             break;
+        case MVM_SPESH_PLANNED_BASELINE:
+            append(&ds, "Baseline");
+            break;
     }
     append(&ds, " specialization of '");
     append_str(tc, &ds, p->sf->body.name);
@@ -910,6 +913,11 @@ char * MVM_spesh_dump_planned(MVMThreadContext *tc, MVMSpeshPlanned *p) {
             dump_stats_type_tuple(tc, &ds, cs, p->type_tuple, "    ");
             break;
         }
+        case MVM_SPESH_PLANNED_BASELINE:
+            appendf(&ds,
+                "It was planned due to the callsite receiving %u hits, which is not yet enough to specialize.\n",
+                p->cs_stats->hits);
+            break;
     }
 
     appendf(&ds, "\nThe maximum stack depth is %d.\n\n", p->max_depth);
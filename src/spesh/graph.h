@@ -118,6 +118,10 @@ struct MVMSpeshGraph {
     MVMuint8 sets_dispatcher;
     MVMuint8 sets_nextdispatcher;
 
+    /* Is this graph for a baseline candidate? If so, we skip optimization
+     * and the expression JIT, so it is cheap to compile. */
+    MVMuint8 is_baseline;
+
     /* Stored in comment annotations to give an ordering of comments */
     MVMuint32 next_annotation_idx;
 };
@@ -244,13 +244,36 @@ MVMuint32 MVM_spesh_inline_get_max_size(MVMThreadContext *tc, MVMStaticFrame *sf
     return sf->body.cu->body.hll_config->max_inline_size;
 }
 
+/* Gets the maximum inline size for a call to the specified static frame, given
+ * how hot the call is, as the number of times it was made per 100 entries into
+ * the caller (or -1 if that isn't known). A call made more than once per entry
+ * gets a larger budget, since each byte inlined there saves more; a cold one
+ * gets a smaller budget, since inlining it mostly costs code size and time
+ * spent optimizing. */
+MVMuint32 MVM_spesh_inline_get_max_size_for_call(MVMThreadContext *tc, MVMStaticFrame *sf,
+                                                 MVMint32 hotness) {
+    MVMuint32 max_size = MVM_spesh_inline_get_max_size(tc, sf);
+    if (hotness < 0)
+        return max_size;
+    if (hotness < MVM_SPESH_INLINE_COLD_PERCENT)
+        return max_size / MVM_SPESH_INLINE_COLD_DIVISOR;
+    if (hotness > 100) {
+        MVMuint64 scaled = (MVMuint64)max_size * hotness / 100;
+        MVMuint64 limit  = (MVMuint64)max_size * MVM_SPESH_INLINE_MAX_HOT_FACTOR;
+        return (MVMuint32)(scaled < limit ? scaled : limit);
+    }
+    return max_size;
+}
+
 /* Sees if it will be possible to inline the target code ref, given we could
- * already identify a spesh candidate. Returns NULL if no inlining is possible
- * or a graph ready to be merged if it will be possible. */
+ * already identify a spesh candidate, and that its size must be within
+ * max_size. Returns NULL if no inlining is possible or a graph ready to be
+ * merged if it will be possible. */
 MVMSpeshGraph * MVM_spesh_inline_try_get_graph(MVMThreadContext *tc, MVMSpeshGraph *inliner,
                                                MVMStaticFrame *target_sf,
                                                MVMSpeshCandidate *cand,
                                                MVMSpeshIns *invoke_ins,
+                                               MVMuint32 max_size,
                                                char **no_inline_reason,
                                                MVMuint32 *effective_size,
                                                MVMOpInfo const **no_inline_info) {
@@ -259,7 +282,7 @@ MVMSpeshGraph * MVM_spesh_inline_try_get_graph(MVMThreadContext *tc, MVMSpeshGra
 
     /* Check bytecode size is within the inline limit. */
     *effective_size = get_effective_size(tc, cand);
-    if (*effective_size > MVM_spesh_inline_get_max_size(tc, target_sf)) {
+    if (*effective_size > max_size) {
         *no_inline_reason = "bytecode is too large to inline";
         return NULL;
     }
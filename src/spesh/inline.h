@@ -1,6 +1,17 @@
 /* Default maximum size of bytecode we'll inline. */
 #define MVM_SPESH_DEFAULT_MAX_INLINE_SIZE 192
 
+/* The maximum inline size is adjusted for each call by how hot it is, going
+ * by how many times it was made per 100 entries into the caller. A call made
+ * more than once per entry gets a proportionally larger size limit, up to
+ * this many times the maximum inline size. */
+#define MVM_SPESH_INLINE_MAX_HOT_FACTOR 4
+
+/* A call made fewer than this many times per 100 entries into the caller is
+ * cold, and only gets the maximum inline size divided by the cold divisor. */
+#define MVM_SPESH_INLINE_COLD_PERCENT   10
+#define MVM_SPESH_INLINE_COLD_DIVISOR   2
+
 /* The maximum number of locals an inliner can reach, and maximum number of
  * inlines we can reach, before we stop inlining; this is to prevent us
  * reaching sizes where the analysis becomes hugely costly. */
@@ -57,7 +68,8 @@ struct MVMSpeshInline {
 
 MVMSpeshGraph * MVM_spesh_inline_try_get_graph(MVMThreadContext *tc,
     MVMSpeshGraph *inliner, MVMStaticFrame *target_sf, MVMSpeshCandidate *cand,
-    MVMSpeshIns *invoke_ins, char **no_inline_reason, MVMuint32 *effective_size, MVMOpInfo const **no_inline_info);
+    MVMSpeshIns *invoke_ins, MVMuint32 max_size, char **no_inline_reason,
+    MVMuint32 *effective_size, MVMOpInfo const **no_inline_info);
 MVMSpeshGraph * MVM_spesh_inline_try_get_graph_from_unspecialized(MVMThreadContext *tc,
     MVMSpeshGraph *inliner, MVMStaticFrame *target_sf, MVMSpeshIns *invoke_ins,
     MVMSpeshCallInfo *call_info, MVMSpeshStatsType *type_tuple, char **no_inline_reason, MVMOpInfo const **no_inline_info);
@@ -66,3 +78,5 @@ void MVM_spesh_inline(MVMThreadContext *tc, MVMSpeshGraph *inliner,
     MVMSpeshIns *invoke, MVMSpeshGraph *inlinee, MVMStaticFrame *inlinee_sf,
     MVMSpeshOperand code_ref_reg, MVMuint32 proxy_deopt_idx, MVMuint16 bytecode_size);
 MVMuint32 MVM_spesh_inline_get_max_size(MVMThreadContext *tc, MVMStaticFrame *sf);
+MVMuint32 MVM_spesh_inline_get_max_size_for_call(MVMThreadContext *tc, MVMStaticFrame *sf,
+    MVMint32 hotness);
@@ -0,0 +1,900 @@
+#include "moar.h"
+
+/* Loop invariant code motion. We find natural loops in the graph by looking
+ * for back edges (an edge from a block to a block that dominates it), and
+ * then look for instructions in the loop whose inputs are all computed
+ * outside of it. Those are moved into a preheader: a block that is the only
+ * way into the loop header from outside the loop.
+ *
+ * Only instructions that can never throw or have side effects are moved,
+ * since a moved instruction is run even if the loop body would not have
+ * reached it. Loads from objects are only moved out of loops that contain
+ * nothing that could write to an object, call anything or deoptimize in a
+ * way that could let other code run.
+ *
+ * A guard on an invariant value is moved too, provided it is the first thing
+ * the loop header does once everything before it has been moved. If it would
+ * fail, it would do so on the first iteration, right after entering the loop;
+ * so it keeps its deopt index, and deoptimizing from the preheader resumes
+ * the unoptimized code at the very place it would have before. Guards on the
+ * type of an object also need the loop to do no writes, since a rebless could
+ * change the type.
+ *
+ * We also strength-reduce multiplications of a basic induction variable (one
+ * that is stepped by an invariant amount each iteration) by an invariant
+ * factor. The product gets a register of its own, which is set up in the
+ * preheader and stepped along with the induction variable, so that the
+ * multiplication becomes a copy.
+ *
+ * Since we are in SSA form, the value being moved is only ever written by the
+ * moved instruction, and the graph is converted out of SSA form by simply
+ * dropping the versions. Therefore we must also make sure that no other
+ * version of the target register is live anywhere, or else the hoisted write
+ * could clobber it. */
+
+/* Debug logging of LICM. */
+#define LICM_LOG 0
+static void licm_log(char *fmt, ...) {
+#if LICM_LOG
+    va_list args;
+    fprintf(stderr, "LICM: ");
+    va_start(args, fmt);
+    vfprintf(stderr, fmt, args);
+    va_end(args);
+    fprintf(stderr, "\n");
+#endif
+}
+
+/* State for processing a single loop. */
+typedef struct {
+    /* Pre-order and post-order numbers of each block (by idx) in a walk of
+     * the dominator tree, used to answer dominance queries. */
+    MVMuint32 *dom_pre;
+    MVMuint32 *dom_post;
+
+    /* Whether each block (by idx) is in the loop. */
+    MVMuint8 *in_loop;
+
+    /* Offsets into defined_in_loop for each register; the flag for version
+     * i of register r is at defined_in_loop[def_offsets[r] + i]. Registers
+     * added after the scan, from num_scanned_locals on, have no flags. */
+    MVMuint32 *def_offsets;
+    MVMuint8 *defined_in_loop;
+    MVMuint16 num_scanned_locals;
+
+    /* The loop header. */
+    MVMSpeshBB *header;
+
+    /* The one block outside of the loop that leads into its header. */
+    MVMSpeshBB *outside_pred;
+
+    /* Whether the graph entry leads into the header too, which it does when
+     * the header is an OSR entry point. */
+    MVMuint8 osr_entry;
+
+    /* Whether the loop only contains instructions that can not write to
+     * memory or run other code, making it safe to hoist loads. */
+    MVMuint8 no_writes;
+
+    /* The instructions to place in the preheader, in order. */
+    MVM_VECTOR_DECL(MVMSpeshIns *, hoisted);
+} LoopState;
+
+/* Numbers the blocks in the dominator tree. */
+static void number_dominator_tree(MVMThreadContext *tc, MVMSpeshGraph *g, LoopState *ls) {
+    MVMSpeshBB **stack = MVM_malloc(g->num_bbs * sizeof(MVMSpeshBB *));
+    MVMuint16 *next_child = MVM_calloc(g->num_bbs, sizeof(MVMuint16));
+    MVMint32 sp = 0;
+    MVMuint32 counter = 0;
+    stack[sp++] = g->entry;
+    ls->dom_pre[g->entry->idx] = counter++;
+    while (sp > 0) {
+        MVMSpeshBB *bb = stack[sp - 1];
+        if (next_child[bb->idx] < bb->num_children) {
+            MVMSpeshBB *child = bb->children[next_child[bb->idx]++];
+            ls->dom_pre[child->idx] = counter++;
+            stack[sp++] = child;
+        }
+        else {
+            ls->dom_post[bb->idx] = counter++;
+            sp--;
+        }
+    }
+    MVM_free(next_child);
+    MVM_free(stack);
+}
+
+/* Checks if block a dominates block b. */
+static MVMint32 dominates(LoopState *ls, MVMSpeshBB *a, MVMSpeshBB *b) {
+    return ls->dom_pre[a->idx] <= ls->dom_pre[b->idx] &&
+        ls->dom_post[b->idx] <= ls->dom_post[a->idx];
+}
+
+/* Checks if the block is a loop header, by looking for a back edge into it. */
+static MVMint32 is_loop_header(LoopState *ls, MVMSpeshBB *bb) {
+    MVMuint16 i;
+    for (i = 0; i < bb->num_pred; i++)
+        if (dominates(ls, bb, bb->pred[i]))
+            return 1;
+    return 0;
+}
+
+/* Finds the blocks in the loop with the specified header: those that can
+ * reach a back edge into the header without going through the header. */
+static void find_loop_blocks(MVMThreadContext *tc, MVMSpeshGraph *g, LoopState *ls) {
+    MVMSpeshBB *header = ls->header;
+    MVMSpeshBB **worklist = MVM_malloc(g->num_bbs * sizeof(MVMSpeshBB *));
+    MVMint32 num_work = 0;
+    MVMuint16 i;
+    ls->in_loop[header->idx] = 1;
+    for (i = 0; i < header->num_pred; i++) {
+        MVMSpeshBB *pred = header->pred[i];
+        if (dominates(ls, header, pred) && !ls->in_loop[pred->idx]) {
+            ls->in_loop[pred->idx] = 1;
+            worklist[num_work++] = pred;
+        }
+    }
+    while (num_work > 0) {
+        MVMSpeshBB *bb = worklist[--num_work];
+        for (i = 0; i < bb->num_pred; i++) {
+            MVMSpeshBB *pred = bb->pred[i];
+            if (!ls->in_loop[pred->idx]) {
+                ls->in_loop[pred->idx] = 1;
+                worklist[num_work++] = pred;
+            }
+        }
+    }
+    MVM_free(worklist);
+}
+
+/* Checks if an instruction ends its block with a branch, as opposed to
+ * falling through into the next block. */
+static MVMint32 is_branch(MVMSpeshIns *ins) {
+    MVMuint16 i;
+    if (ins->info->opcode == MVM_OP_goto)
+        return 1;
+    for (i = 0; i < ins->info->num_operands; i++)
+        if ((ins->info->operands[i] & MVM_operand_type_mask) == MVM_operand_ins)
+            return 1;
+    return 0;
+}
+
+/* Finds the annotation marking the header as an OSR entry point, which is on
+ * the first instruction after the PHIs. */
+static MVMSpeshAnn * find_osr_annotation(MVMSpeshBB *bb) {
+    MVMSpeshIns *ins = bb->first_ins;
+    while (ins && ins->info->opcode == MVM_SSA_PHI)
+        ins = ins->next;
+    if (ins) {
+        MVMSpeshAnn *ann = ins->annotations;
+        while (ann) {
+            if (ann->type == MVM_SPESH_ANN_DEOPT_OSR)
+                return ann;
+            ann = ann->next;
+        }
+    }
+    return NULL;
+}
+
+/* Checks that the loop has a single way in from outside that we can place a
+ * preheader on. That is the case if the header has just one predecessor
+ * outside of the loop (other than the OSR edge from the graph entry), which
+ * falls through into it. */
+static MVMint32 find_loop_entry(MVMThreadContext *tc, MVMSpeshGraph *g, LoopState *ls) {
+    MVMSpeshBB *header = ls->header;
+    MVMuint16 i;
+    if (header->jumplist)
+        return 0;
+    if (header->first_ins) {
+        MVMSpeshAnn *ann = header->first_ins->annotations;
+        while (ann) {
+            if (ann->type == MVM_SPESH_ANN_FH_GOTO)
+                return 0;
+            ann = ann->next;
+        }
+    }
+    for (i = 0; i < header->num_pred; i++) {
+        MVMSpeshBB *pred = header->pred[i];
+        if (ls->in_loop[pred->idx])
+            continue;
+        if (pred == g->entry) {
+            if (!find_osr_annotation(header))
+                return 0;
+            ls->osr_entry = 1;
+        }
+        else if (ls->outside_pred) {
+            return 0;
+        }
+        else {
+            ls->outside_pred = pred;
+        }
+    }
+    if (!ls->outside_pred)
+        return 0;
+    return ls->outside_pred->num_succ == 1 &&
+        ls->outside_pred->linear_next == header &&
+        !ls->outside_pred->jumplist &&
+        !(ls->outside_pred->last_ins && is_branch(ls->outside_pred->last_ins));
+}
+
+/* Instructions that can be hoisted whenever their inputs are invariant. They
+ * can not throw, deoptimize, or have any other side-effects. */
+static MVMint32 is_pure_op(MVMuint16 opcode) {
+    switch (opcode) {
+        case MVM_OP_const_i64:
+        case MVM_OP_const_i64_16:
+        case MVM_OP_const_i64_32:
+        case MVM_OP_const_n64:
+        case MVM_OP_const_s:
+        case MVM_OP_sp_getspeshslot:
+        case MVM_OP_add_i:
+        case MVM_OP_sub_i:
+        case MVM_OP_mul_i:
+        case MVM_OP_neg_i:
+        case MVM_OP_band_i:
+        case MVM_OP_bor_i:
+        case MVM_OP_bxor_i:
+        case MVM_OP_bnot_i:
+        case MVM_OP_blshift_i:
+        case MVM_OP_brshift_i:
+        case MVM_OP_add_n:
+        case MVM_OP_sub_n:
+        case MVM_OP_mul_n:
+        case MVM_OP_div_n:
+        case MVM_OP_neg_n:
+        case MVM_OP_coerce_in:
+        case MVM_OP_eq_i:
+        case MVM_OP_ne_i:
+        case MVM_OP_lt_i:
+        case MVM_OP_le_i:
+        case MVM_OP_gt_i:
+        case MVM_OP_ge_i:
+        case MVM_OP_cmp_i:
+        case MVM_OP_eq_n:
+        case MVM_OP_ne_n:
+        case MVM_OP_lt_n:
+        case MVM_OP_le_n:
+        case MVM_OP_gt_n:
+        case MVM_OP_ge_n:
+        case MVM_OP_cmp_n:
+        case MVM_OP_not_i:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/* Loads from objects whose type and concreteness are already established by
+ * facts. They can be hoisted if nothing in the loop can write to the object
+ * being loaded from. */
+static MVMint32 is_load_op(MVMuint16 opcode) {
+    switch (opcode) {
+        case MVM_OP_sp_p6oget_o:
+        case MVM_OP_sp_p6oget_i:
+        case MVM_OP_sp_p6oget_n:
+        case MVM_OP_sp_p6oget_s:
+        case MVM_OP_sp_get_o:
+        case MVM_OP_sp_get_i64:
+        case MVM_OP_sp_get_n:
+        case MVM_OP_sp_get_s:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/* Instructions that may appear in a loop that we hoist loads out of. Guards
+ * may deoptimize, but that only leaves the loop, so any load we hoisted past
+ * them would just not be used. */
+static MVMint32 is_non_writing_op(MVMuint16 opcode) {
+    if (is_pure_op(opcode) || is_load_op(opcode))
+        return 1;
+    switch (opcode) {
+        case MVM_SSA_PHI:
+        case MVM_OP_no_op:
+        case MVM_OP_set:
+        case MVM_OP_goto:
+        case MVM_OP_if_i:
+        case MVM_OP_unless_i:
+        case MVM_OP_if_n:
+        case MVM_OP_unless_n:
+        case MVM_OP_inc_i:
+        case MVM_OP_dec_i:
+        case MVM_OP_sp_guard:
+        case MVM_OP_sp_guardconc:
+        case MVM_OP_sp_guardtype:
+        case MVM_OP_sp_guardobj:
+        case MVM_OP_sp_guardnotobj:
+        case MVM_OP_sp_guardjustconc:
+        case MVM_OP_sp_guardjusttype:
+        case MVM_OP_sp_guardsf:
+        case MVM_OP_sp_guardsfouter:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/* Records which register versions are written inside the loop, and whether
+ * the loop contains anything that may write to memory. */
+static void scan_loop(MVMThreadContext *tc, MVMSpeshGraph *g, LoopState *ls) {
+    MVMSpeshBB *bb = g->entry;
+    MVMuint32 total = 0;
+    MVMuint16 i;
+    for (i = 0; i < g->num_locals; i++) {
+        ls->def_offsets[i] = total;
+        total += g->fact_counts[i];
+    }
+    ls->num_scanned_locals = g->num_locals;
+    ls->defined_in_loop = MVM_calloc(total ? total : 1, sizeof(MVMuint8));
+    ls->no_writes = 1;
+    while (bb) {
+        if (ls->in_loop[bb->idx]) {
+            MVMSpeshIns *ins = bb->first_ins;
+            while (ins) {
+                MVMuint16 opcode = ins->info->opcode;
+                if (!is_non_writing_op(opcode))
+                    ls->no_writes = 0;
+                for (i = 0; i < ins->info->num_operands; i++) {
+                    if ((ins->info->operands[i] & MVM_operand_rw_mask) == MVM_operand_write_reg) {
+                        MVMSpeshOperand o = ins->operands[i];
+                        ls->defined_in_loop[ls->def_offsets[o.reg.orig] + o.reg.i] = 1;
+                    }
+                }
+                ins = ins->next;
+            }
+        }
+        bb = bb->linear_next;
+    }
+}
+
+/* Checks if a register version is defined in the loop. */
+static MVMint32 is_defined_in_loop(LoopState *ls, MVMSpeshOperand o) {
+    if (o.reg.orig >= ls->num_scanned_locals)
+        return 1;
+    return ls->defined_in_loop[ls->def_offsets[o.reg.orig] + o.reg.i];
+}
+
+/* Checks if the register version read by an instruction has the same value
+ * throughout the loop. */
+static MVMint32 is_invariant(MVMThreadContext *tc, MVMSpeshGraph *g, LoopState *ls,
+        MVMSpeshOperand o) {
+    MVMSpeshIns *writer;
+
+    /* On entry through OSR, the preheader is run with the registers the
+     * interpreter left, so anything that spesh introduced won't be set. */
+    if (ls->osr_entry && o.reg.orig >= g->sf->body.num_locals)
+        return 0;
+
+    /* Anything not written in the loop is fine. */
+    if (!is_defined_in_loop(ls, o))
+        return 1;
+
+    /* A PHI in the header that merges one value from outside the loop with
+     * itself is also invariant; the register it reads holds the value on
+     * entering the loop, and nothing in the loop changes it. */
+    writer = MVM_spesh_get_facts(tc, g, o)->writer;
+    if (writer && writer->info->opcode == MVM_SSA_PHI) {
+        MVMSpeshIns *ins = ls->header->first_ins;
+        while (ins && ins->info->opcode == MVM_SSA_PHI) {
+            if (ins == writer) {
+                MVMuint16 i;
+                for (i = 1; i < writer->info->num_operands; i++) {
+                    MVMSpeshOperand in = writer->operands[i];
+                    if (in.reg.i != o.reg.i && is_defined_in_loop(ls, in))
+                        return 0;
+                }
+                return 1;
+            }
+            ins = ins->next;
+        }
+    }
+    return 0;
+}
+
+/* Checks if the value written by a hoisted instruction could clobber any
+ * other version of the same register. That can't happen if no other version
+ * is written or read anywhere. */
+static MVMint32 is_sole_version(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshOperand o) {
+    MVMuint16 i;
+    for (i = 0; i < g->fact_counts[o.reg.orig]; i++) {
+        MVMSpeshFacts *facts;
+        if (i == o.reg.i)
+            continue;
+        facts = &(g->facts[o.reg.orig][i]);
+        if (facts->writer || facts->usage.users || facts->usage.deopt_users ||
+                facts->usage.handler_required)
+            return 0;
+    }
+    return !MVM_spesh_usages_is_used_by_handler(tc, g, o);
+}
+
+/* Guards that can be hoisted when the value they check is invariant. Those
+ * that check the type of an object can only be hoisted out of loops that do
+ * no writes. (sp_guardsfouter is left alone, since the outer of a code object
+ * can be changed by capturelex.) */
+static MVMint32 is_hoistable_guard_op(MVMuint16 opcode, MVMuint8 no_writes) {
+    switch (opcode) {
+        case MVM_OP_sp_guard:
+        case MVM_OP_sp_guardconc:
+        case MVM_OP_sp_guardtype:
+            return no_writes;
+        case MVM_OP_sp_guardobj:
+        case MVM_OP_sp_guardnotobj:
+        case MVM_OP_sp_guardjustconc:
+        case MVM_OP_sp_guardjusttype:
+        case MVM_OP_sp_guardsf:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/* Checks if a guard can be hoisted out of the loop. It must be the first
+ * instruction in the header, so that it is reached on every entry to the
+ * loop with nothing but hoisted instructions run before it. */
+static MVMint32 can_hoist_guard(MVMThreadContext *tc, MVMSpeshGraph *g, LoopState *ls,
+        MVMSpeshIns *ins) {
+    MVMSpeshIns *first = ls->header->first_ins;
+    MVMSpeshAnn *ann;
+    MVMuint16 i;
+    while (first && first->info->opcode == MVM_SSA_PHI)
+        first = first->next;
+    if (ins != first || !ins->next)
+        return 0;
+
+    /* Its deopt point goes with it, and an OSR entry point or line number
+     * is fine; anything else would change meaning if moved. */
+    ann = ins->annotations;
+    while (ann) {
+        switch (ann->type) {
+            case MVM_SPESH_ANN_DEOPT_ONE_INS:
+            case MVM_SPESH_ANN_DEOPT_OSR:
+            case MVM_SPESH_ANN_LINENO:
+            case MVM_SPESH_ANN_COMMENT:
+                break;
+            default:
+                return 0;
+        }
+        ann = ann->next;
+    }
+
+    /* A guard usually writes a new version of the register it checks, which
+     * holds the same value, so can't clobber anything. */
+    for (i = 0; i < ins->info->num_operands; i++) {
+        switch (ins->info->operands[i] & MVM_operand_rw_mask) {
+            case MVM_operand_literal:
+                break;
+            case MVM_operand_read_reg:
+                if (!is_invariant(tc, g, ls, ins->operands[i]))
+                    return 0;
+                break;
+            case MVM_operand_write_reg:
+                if (ins->operands[i].reg.orig != ins->operands[i + 1].reg.orig &&
+                        !is_sole_version(tc, g, ins->operands[i]))
+                    return 0;
+                break;
+            default:
+                return 0;
+        }
+    }
+    return 1;
+}
+
+/* Checks if an instruction can be hoisted out of the loop. */
+static MVMint32 can_hoist(MVMThreadContext *tc, MVMSpeshGraph *g, LoopState *ls,
+        MVMSpeshIns *ins) {
+    MVMuint16 opcode = ins->info->opcode;
+    MVMSpeshAnn *ann;
+    MVMuint16 i;
+
+    if (is_hoistable_guard_op(opcode, ls->no_writes))
+        return can_hoist_guard(tc, g, ls, ins);
+    if (!is_pure_op(opcode) && !(is_load_op(opcode) && ls->no_writes))
+        return 0;
+
+    /* Moving annotations would change what they mean (for example, the line
+     * number of the instructions after this one). */
+    ann = ins->annotations;
+    while (ann) {
+        if (ann->type != MVM_SPESH_ANN_COMMENT)
+            return 0;
+        ann = ann->next;
+    }
+
+    /* All of the ops we hoist write their first operand and read the rest. */
+    if ((ins->info->operands[0] & MVM_operand_rw_mask) != MVM_operand_write_reg)
+        return 0;
+    if (!is_sole_version(tc, g, ins->operands[0]))
+        return 0;
+    for (i = 1; i < ins->info->num_operands; i++) {
+        switch (ins->info->operands[i] & MVM_operand_rw_mask) {
+            case MVM_operand_literal:
+                break;
+            case MVM_operand_read_reg:
+                if (!is_invariant(tc, g, ls, ins->operands[i]))
+                    return 0;
+                break;
+            default:
+                return 0;
+        }
+    }
+    return 1;
+}
+
+/* An OSR entry point on a hoisted guard stays in the loop header, on the
+ * instruction after it; create_preheader moves it on from there. */
+static void move_osr_annotation(MVMSpeshIns *ins) {
+    MVMSpeshAnn *prev = NULL;
+    MVMSpeshAnn *ann = ins->annotations;
+    while (ann) {
+        if (ann->type == MVM_SPESH_ANN_DEOPT_OSR) {
+            if (prev)
+                prev->next = ann->next;
+            else
+                ins->annotations = ann->next;
+            ann->next = ins->next->annotations;
+            ins->next->annotations = ann;
+            return;
+        }
+        prev = ann;
+        ann = ann->next;
+    }
+}
+
+/* Finds instructions to hoist, repeating until we find no more, since
+ * hoisting one instruction can make those using its result invariant. */
+static void find_hoistable(MVMThreadContext *tc, MVMSpeshGraph *g, LoopState *ls) {
+    MVMint32 changed;
+    do {
+        MVMSpeshBB *bb = g->entry;
+        changed = 0;
+        while (bb) {
+            if (ls->in_loop[bb->idx]) {
+                MVMSpeshIns *ins = bb->first_ins;
+                while (ins) {
+                    MVMSpeshIns *next = ins->next;
+                    if (can_hoist(tc, g, ls, ins)) {
+                        MVMSpeshOperand target = ins->operands[0];
+                        licm_log("hoisting %s out of loop with header BB %d",
+                            ins->info->name, ls->header->idx);
+                        MVM_VECTOR_PUSH(ls->hoisted, ins);
+                        if ((ins->info->operands[0] & MVM_operand_rw_mask) == MVM_operand_write_reg)
+                            ls->defined_in_loop[ls->def_offsets[target.reg.orig] + target.reg.i] = 0;
+                        move_osr_annotation(ins);
+
+                        /* Unlink it from the block; it is placed in the
+                         * preheader once we have them all. */
+                        if (ins->prev)
+                            ins->prev->next = ins->next;
+                        else
+                            bb->first_ins = ins->next;
+                        if (ins->next)
+                            ins->next->prev = ins->prev;
+                        else
+                            bb->last_ins = ins->prev;
+                        ins->prev = ins->next = NULL;
+                        changed = 1;
+                    }
+                    ins = next;
+                }
+            }
+            bb = bb->linear_next;
+        }
+    } while (changed);
+}
+
+/* Checks if two operands are the same version of the same register. */
+static MVMint32 same_version(MVMSpeshOperand a, MVMSpeshOperand b) {
+    return a.reg.orig == b.reg.orig && a.reg.i == b.reg.i;
+}
+
+/* Checks if the register version is a basic induction variable of the loop:
+ * a PHI in the header that merges values from outside the loop with one
+ * that is computed in the loop by stepping the PHI by an invariant amount.
+ * If so, returns the instruction that steps it, and a version holding its
+ * initial value. (If there are several versions from outside the loop, due
+ * to an OSR entry, they are all the same register, so any will do.) */
+static MVMSpeshIns * find_basic_iv(MVMThreadContext *tc, MVMSpeshGraph *g, LoopState *ls,
+        MVMSpeshOperand iv, MVMSpeshOperand *init) {
+    MVMSpeshIns *writer = MVM_spesh_get_facts(tc, g, iv)->writer;
+    MVMSpeshIns *step = NULL;
+    MVMSpeshIns *ins = ls->header->first_ins;
+    MVMint32 have_init = 0;
+    MVMuint16 i;
+
+    /* The preheader sets up the product using the register, which on entry
+     * through OSR holds what the interpreter left in it. */
+    if (ls->osr_entry && iv.reg.orig >= g->sf->body.num_locals)
+        return NULL;
+
+    while (ins && ins->info->opcode == MVM_SSA_PHI && ins != writer)
+        ins = ins->next;
+    if (!ins || ins != writer)
+        return NULL;
+
+    for (i = 1; i < writer->info->num_operands; i++) {
+        MVMSpeshOperand in = writer->operands[i];
+        if (same_version(in, iv)) {
+            return NULL;
+        }
+        else if (!is_defined_in_loop(ls, in)) {
+            *init = in;
+            have_init = 1;
+        }
+        else {
+            MVMSpeshIns *in_writer = MVM_spesh_get_facts(tc, g, in)->writer;
+            if (!in_writer || (step && in_writer != step))
+                return NULL;
+            if (in_writer->info->opcode != MVM_OP_add_i &&
+                    in_writer->info->opcode != MVM_OP_sub_i)
+                return NULL;
+            if (!same_version(in_writer->operands[1], iv) ||
+                    !is_invariant(tc, g, ls, in_writer->operands[2]))
+                return NULL;
+            step = in_writer;
+        }
+    }
+    return have_init ? step : NULL;
+}
+
+/* Finds the block in the loop that holds an instruction. */
+static MVMSpeshBB * find_ins_bb(MVMSpeshGraph *g, LoopState *ls, MVMSpeshIns *ins) {
+    MVMSpeshBB *bb = g->entry;
+    while (bb) {
+        if (ls->in_loop[bb->idx]) {
+            MVMSpeshIns *cur = bb->first_ins;
+            while (cur) {
+                if (cur == ins)
+                    return bb;
+                cur = cur->next;
+            }
+        }
+        bb = bb->linear_next;
+    }
+    return NULL;
+}
+
+/* Makes an instruction with the specified operands, and adds the usages of
+ * the ones it reads. */
+static MVMSpeshIns * make_ins(MVMThreadContext *tc, MVMSpeshGraph *g, const MVMOpInfo *info,
+        MVMSpeshOperand *operands) {
+    MVMSpeshIns *ins = MVM_spesh_alloc(tc, g, sizeof(MVMSpeshIns));
+    MVMuint16 i;
+    ins->info = info;
+    ins->operands = MVM_spesh_alloc(tc, g, info->num_operands * sizeof(MVMSpeshOperand));
+    memcpy(ins->operands, operands, info->num_operands * sizeof(MVMSpeshOperand));
+    MVM_spesh_get_facts(tc, g, operands[0])->writer = ins;
+    for (i = 1; i < info->num_operands; i++)
+        MVM_spesh_usages_add_by_reg(tc, g, operands[i], ins);
+    return ins;
+}
+
+/* Strength-reduces a multiplication of a basic induction variable by an
+ * invariant factor, if the instruction is one. Returns non-zero if it was. */
+static MVMint32 reduce_mul(MVMThreadContext *tc, MVMSpeshGraph *g, LoopState *ls,
+        MVMSpeshIns *mul) {
+    MVMSpeshOperand iv, factor, init, step_by, product, prod_init, prod_phi, prod_next;
+    MVMSpeshOperand ops[3];
+    MVMSpeshIns *step, *phi;
+    MVMSpeshBB *step_bb;
+    MVMuint16 step_op;
+    MVMuint16 which;
+
+    for (which = 1; which <= 2; which++) {
+        iv = mul->operands[which];
+        factor = mul->operands[3 - which];
+        if (is_invariant(tc, g, ls, factor) && (step = find_basic_iv(tc, g, ls, iv, &init)))
+            break;
+    }
+    if (which > 2)
+        return 0;
+    step_bb = find_ins_bb(g, ls, step);
+    if (!step_bb)
+        return 0;
+    licm_log("strength-reducing %s in loop with header BB %d",
+        mul->info->name, ls->header->idx);
+
+    /* The product gets a register of its own, with a version for its initial
+     * value, its value in the loop, and its stepped value. */
+    product.reg.orig = MVM_spesh_manipulate_get_unique_reg(tc, g, MVM_reg_int64);
+    product.reg.i = 0;
+    prod_init = product;
+    prod_phi = MVM_spesh_manipulate_new_version(tc, g, product.reg.orig);
+    prod_next = MVM_spesh_manipulate_new_version(tc, g, product.reg.orig);
+
+    /* In the preheader, work out how much to step the product by, and its
+     * initial value. */
+    step_by.reg.orig = MVM_spesh_manipulate_get_unique_reg(tc, g, MVM_reg_int64);
+    step_by.reg.i = 0;
+    ops[0] = step_by;
+    ops[1] = step->operands[2];
+    ops[2] = factor;
+    MVM_VECTOR_PUSH(ls->hoisted, make_ins(tc, g, MVM_op_get_op(MVM_OP_mul_i), ops));
+    ops[0] = prod_init;
+    ops[1] = init;
+    ops[2] = factor;
+    MVM_VECTOR_PUSH(ls->hoisted, make_ins(tc, g, MVM_op_get_op(MVM_OP_mul_i), ops));
+
+    /* Merge the initial and stepped values in the header. */
+    ops[0] = prod_phi;
+    ops[1] = prod_init;
+    ops[2] = prod_next;
+    phi = make_ins(tc, g, get_phi(tc, g, 3), ops);
+    MVM_spesh_manipulate_insert_ins(tc, ls->header, NULL, phi);
+
+    /* Step the product right after the induction variable. */
+    step_op = step->info->opcode;
+    ops[0] = prod_next;
+    ops[1] = prod_phi;
+    ops[2] = step_by;
+    MVM_spesh_manipulate_insert_ins(tc, step_bb, step,
+        make_ins(tc, g, MVM_op_get_op(step_op), ops));
+
+    /* And turn the multiplication into a copy. */
+    MVM_spesh_usages_delete_by_reg(tc, g, mul->operands[1], mul);
+    MVM_spesh_usages_delete_by_reg(tc, g, mul->operands[2], mul);
+    mul->info = MVM_op_get_op(MVM_OP_set);
+    mul->operands[1] = prod_phi;
+    MVM_spesh_usages_add_by_reg(tc, g, prod_phi, mul);
+    return 1;
+}
+
+/* Strength-reduces multiplications of induction variables in the loop.
+ * Returns non-zero if any were. */
+static MVMint32 reduce_induction_vars(MVMThreadContext *tc, MVMSpeshGraph *g, LoopState *ls) {
+    MVMSpeshBB *bb = g->entry;
+    MVMint32 reduced = 0;
+    while (bb) {
+        if (ls->in_loop[bb->idx]) {
+            MVMSpeshIns *ins = bb->first_ins;
+            while (ins) {
+                if (ins->info->opcode == MVM_OP_mul_i && reduce_mul(tc, g, ls, ins))
+                    reduced = 1;
+                ins = ins->next;
+            }
+        }
+        bb = bb->linear_next;
+    }
+    return reduced;
+}
+
+/* Replaces one successor of a block with another. */
+static void replace_succ(MVMSpeshBB *bb, MVMSpeshBB *from, MVMSpeshBB *to) {
+    MVMuint16 i;
+    for (i = 0; i < bb->num_succ; i++)
+        if (bb->succ[i] == from)
+            bb->succ[i] = to;
+}
+
+/* Creates the preheader, placed just before the loop header in the linear
+ * order, and puts the hoisted instructions into it. */
+static void create_preheader(MVMThreadContext *tc, MVMSpeshGraph *g, LoopState *ls) {
+    MVMSpeshBB *header = ls->header;
+    MVMSpeshBB *outside_pred = ls->outside_pred;
+    MVMSpeshBB *preheader = MVM_spesh_alloc(tc, g, sizeof(MVMSpeshBB));
+    MVMSpeshBB *bb;
+    size_t i;
+
+    /* Insert it into the linear order, and renumber the blocks after it. */
+    outside_pred->linear_next = preheader;
+    preheader->linear_next = header;
+    preheader->idx = header->idx;
+    bb = header;
+    while (bb) {
+        bb->idx++;
+        bb = bb->linear_next;
+    }
+    g->num_bbs++;
+    preheader->initial_pc = header->initial_pc;
+    preheader->inlined = header->inlined;
+
+    /* Wire it into the control flow; the preds and dominator tree are
+     * recomputed afterwards. */
+    preheader->succ = MVM_spesh_alloc(tc, g, sizeof(MVMSpeshBB *));
+    preheader->succ[0] = header;
+    preheader->num_succ = 1;
+    replace_succ(outside_pred, header, preheader);
+
+    /* Add the hoisted instructions. */
+    for (i = 0; i < MVM_VECTOR_ELEMS(ls->hoisted); i++) {
+        MVMSpeshIns *ins = ls->hoisted[i];
+        ins->prev = preheader->last_ins;
+        if (preheader->last_ins)
+            preheader->last_ins->next = ins;
+        else
+            preheader->first_ins = ins;
+        preheader->last_ins = ins;
+    }
+
+    /* If the header was an OSR entry point, then the preheader now is, so
+     * that the hoisted instructions are run on entry through OSR too. */
+    if (ls->osr_entry) {
+        MVMSpeshIns *ins = header->first_ins;
+        MVMSpeshAnn *osr_ann = find_osr_annotation(header);
+        while (ins->info->opcode == MVM_SSA_PHI)
+            ins = ins->next;
+        if (ins->annotations == osr_ann) {
+            ins->annotations = osr_ann->next;
+        }
+        else {
+            MVMSpeshAnn *ann = ins->annotations;
+            while (ann->next != osr_ann)
+                ann = ann->next;
+            ann->next = osr_ann->next;
+        }
+        osr_ann->next = preheader->first_ins->annotations;
+        preheader->first_ins->annotations = osr_ann;
+        replace_succ(g->entry, header, preheader);
+    }
+}
+
+/* Hoists invariant instructions out of the loop with the specified header,
+ * if it is one, and strength-reduces its induction variables. Returns
+ * non-zero if the graph was changed. */
+static MVMint32 hoist_from_loop(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshBB *header) {
+    LoopState ls;
+    MVMint32 changed = 0;
+    memset(&ls, 0, sizeof(LoopState));
+    ls.header = header;
+    ls.dom_pre = MVM_calloc(g->num_bbs, sizeof(MVMuint32));
+    ls.dom_post = MVM_calloc(g->num_bbs, sizeof(MVMuint32));
+    ls.in_loop = MVM_calloc(g->num_bbs, sizeof(MVMuint8));
+    ls.def_offsets = MVM_calloc(g->num_locals ? g->num_locals : 1, sizeof(MVMuint32));
+    MVM_VECTOR_INIT(ls.hoisted, 0);
+
+    number_dominator_tree(tc, g, &ls);
+    if (is_loop_header(&ls, header)) {
+        find_loop_blocks(tc, g, &ls);
+        if (find_loop_entry(tc, g, &ls)) {
+            scan_loop(tc, g, &ls);
+            find_hoistable(tc, g, &ls);
+            reduce_induction_vars(tc, g, &ls);
+            if (MVM_VECTOR_ELEMS(ls.hoisted)) {
+                create_preheader(tc, g, &ls);
+                changed = 1;
+            }
+        }
+    }
+
+    MVM_VECTOR_DESTROY(ls.hoisted);
+    MVM_free(ls.defined_in_loop);
+    MVM_free(ls.def_offsets);
+    MVM_free(ls.in_loop);
+    MVM_free(ls.dom_post);
+    MVM_free(ls.dom_pre);
+    return changed;
+}
+
+/* Hoists loop invariant instructions into loop preheaders. Loops are visited
+ * innermost first (inner loop headers come later in the linear order), so an
+ * instruction hoisted out of an inner loop may be hoisted out of the outer
+ * loop too. */
+void MVM_spesh_licm(MVMThreadContext *tc, MVMSpeshGraph *g) {
+    MVM_VECTOR_DECL(MVMSpeshBB *, candidates);
+    MVMSpeshBB *bb;
+    size_t i;
+
+    /* Every block with a predecessor later in the linear order may be a
+     * loop header; whether it is depends on dominance, which we check as we
+     * go, since creating preheaders changes the graph. */
+    MVM_spesh_graph_recompute_dominance(tc, g);
+    MVM_VECTOR_INIT(candidates, 0);
+    bb = g->entry;
+    while (bb) {
+        MVMuint16 j;
+        for (j = 0; j < bb->num_pred; j++) {
+            if (bb->pred[j]->idx >= bb->idx) {
+                MVM_VECTOR_PUSH(candidates, bb);
+                break;
+            }
+        }
+        bb = bb->linear_next;
+    }
+
+    for (i = MVM_VECTOR_ELEMS(candidates); i > 0; i--)
+        if (hoist_from_loop(tc, g, candidates[i - 1]))
+            MVM_spesh_graph_recompute_dominance(tc, g);
+
+    MVM_VECTOR_DESTROY(candidates);
+}
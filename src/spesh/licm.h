@@ -0,0 +1,4 @@
+/* Loop invariant code motion: computations inside a loop that produce the
+ * same value on every iteration are moved into a preheader block, so they
+ * are done once per entry to the loop rather than once per iteration. */
+void MVM_spesh_licm(MVMThreadContext *tc, MVMSpeshGraph *g);
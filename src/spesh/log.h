@@ -24,11 +24,24 @@ struct MVMSpeshLogGuard {
  * thresholds.c, but we set it higher to allow more data collection. */
 #define MVM_SPESH_LOG_LOGGED_ENOUGH 1000
 
+/* While a frame with a baseline candidate is still being logged, one in this
+ * many of its invocations runs the unspecialized code, which logs types and
+ * invocation targets, rather than the baseline candidate. */
+#define MVM_SPESH_LOG_BASELINE_INTERVAL 4
+
 /* Quick inline checks if we are logging, to save function call overhead. */
 MVM_STATIC_INLINE MVMint32 MVM_spesh_log_is_logging(MVMThreadContext *tc) {
     MVMFrame *cur_frame = tc->cur_frame;
     return cur_frame->spesh_cand == NULL && cur_frame->spesh_correlation_id && tc->spesh_log;
 }
+/* Frames running a baseline candidate only log their entry and OSR points,
+ * so that they still get hot enough to be properly specialized; the rest of
+ * their logging comes from the invocations that run unspecialized. */
+MVM_STATIC_INLINE MVMint32 MVM_spesh_log_is_logging_osr(MVMThreadContext *tc) {
+    MVMFrame *cur_frame = tc->cur_frame;
+    return (cur_frame->spesh_cand == NULL || cur_frame->spesh_cand->is_baseline) &&
+        cur_frame->spesh_correlation_id && tc->spesh_log;
+}
 MVM_STATIC_INLINE MVMint32 MVM_spesh_log_is_caller_logging(MVMThreadContext *tc) {
     MVMFrame *caller_frame = tc->cur_frame->caller;
     return caller_frame && caller_frame->spesh_cand == NULL &&
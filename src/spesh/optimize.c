@@ -7,17 +7,20 @@ static void optimize_bb(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshBB *bb,
 /* This is where the main optimization work on a spesh graph takes place,
  * using facts discovered during analysis. */
 
-/* Logging of whether we can or can't inline. */
+/* Logging of whether we can or can't inline. Along with the reason we can't,
+ * we note the size budget for the call and how hot the call is, which the
+ * budget is based on. */
 static void log_inline(MVMThreadContext *tc, MVMSpeshGraph *g, MVMStaticFrame *target_sf,
                        MVMSpeshGraph *inline_graph, MVMuint32 bytecode_size,
-                       char *no_inline_reason, MVMint32 unspecialized, const MVMOpInfo *no_inline_info) {
+                       char *no_inline_reason, MVMint32 unspecialized, const MVMOpInfo *no_inline_info,
+                       MVMuint32 max_size, MVMint32 hotness) {
     if (tc->instance->spesh_inline_log) {
         char *c_name_i = MVM_string_utf8_encode_C_string(tc, target_sf->body.name);
         char *c_cuid_i = MVM_string_utf8_encode_C_string(tc, target_sf->body.cuuid);
         char *c_name_t = MVM_string_utf8_encode_C_string(tc, g->sf->body.name);
         char *c_cuid_t = MVM_string_utf8_encode_C_string(tc, g->sf->body.cuuid);
         if (inline_graph) {
-            fprintf(stderr, "Can inline %s%s (%s) with bytecode size %u into %s (%s)\n",
+            fprintf(stderr, "Can inline %s%s (%s) with bytecode size %u into %s (%s)",
                 unspecialized ? "unspecialized " : "",
                 c_name_i, c_cuid_i,
                 bytecode_size, c_name_t, c_cuid_t);
@@ -28,8 +31,11 @@ static void log_inline(MVMThreadContext *tc, MVMSpeshGraph *g, MVMStaticFrame *t
             if (no_inline_info) {
                 fprintf(stderr, " - ins: %s", no_inline_info->name);
             }
-            fprintf(stderr, "\n");
         }
+        if (hotness >= 0)
+            fprintf(stderr, " [size budget %u, %d calls per 100 entries]\n", max_size, hotness);
+        else
+            fprintf(stderr, " [size budget %u, no call statistics]\n", max_size);
         MVM_free(c_name_i);
         MVM_free(c_cuid_i);
         MVM_free(c_name_t);
@@ -1305,53 +1311,6 @@ static void optimize_hllbool(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshIns
     }
 }
 
-/* Turns a get(cur)?hllsym instruction into an sp_gethashentryvalue of the hash
- * entry literal for the sym. Because an sp_gethashentryvalue can be jitted, this
- * means that getcurhllsym can effectively be jitted (it couldn't before because one
- * of the argument to MVM_get_hll_sym wasn't passed as an operand, but could have
- * been moved by GC). Manually implement parts of MVM_get_hll_sym and manually inline
- * some of its high-level hash lookups, because we need the actual hash entry, not its
- * value. */
-static void optimize_getcurhllsym(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshIns *ins) {
-    MVMuint32 is_gethllsym = ins->info->opcode == MVM_OP_gethllsym ? 1 : 0;
-    MVMSpeshFacts *sym_facts = MVM_spesh_get_facts(tc, g, ins->operands[is_gethllsym + 1]);
-    if (sym_facts->flags & MVM_SPESH_FACT_KNOWN_VALUE) {
-        MVMObject *syms = tc->instance->hll_syms, *hash;
-        MVMString *hll_name;
-        if (is_gethllsym) {
-            MVMSpeshFacts *hll_facts = MVM_spesh_get_facts(tc, g, ins->operands[1]);
-            hll_name = hll_facts->value.s;
-        }
-        else {
-            hll_name = g->sf->body.cu->body.hll_name;
-        }
-        uv_mutex_lock(&tc->instance->mutex_hll_syms);
-        hash = MVM_repr_at_key_o(tc, syms, hll_name);
-        /* `result = MVM_repr_at_key_o(tc, hash, sym)` from MVM_hll_sym_get,
-         * but getting the hash entry instead of its value. */
-        if (hash && REPR(hash)->ID == MVM_REPR_ID_MVMHash) {
-            MVMHashEntry *entry = NULL;
-            MVM_HASH_GET(tc, ((MVMHashBody *)OBJECT_BODY(hash))->hash_head, sym_facts->value.s, entry);
-            uv_mutex_unlock(&tc->instance->mutex_hll_syms);
-            if (entry) {
-                MVM_spesh_usages_delete_by_reg(tc, g, ins->operands[1], ins);
-                MVM_spesh_graph_add_comment(tc, g, ins, "specialized from %s", ins->info->name);
-                ins->info = MVM_op_get_op(MVM_OP_sp_gethashentryvalue);
-                if (is_gethllsym) {
-                    /* getcurhllsym only has two operands, but gethllsym has
-                     * three, so we need to delete the spesh usages of the third. */
-                    MVM_spesh_usages_delete_by_reg(tc, g, ins->operands[2], ins);
-                }
-                ins->operands[1].lit_i64 = (MVMint64)entry;
-                MVM_spesh_use_facts(tc, g, sym_facts);
-            }
-        }
-        else {
-            uv_mutex_unlock(&tc->instance->mutex_hll_syms);
-        }
-    }
-}
-
 /* Optimize an object conditional (if_o, unless_o) to simpler operations.
  *
  * We always perform the split of the if_o to istrue + if_i, because a branch
@@ -1824,6 +1783,44 @@ MVMStaticFrame * find_invokee_static_frame(MVMThreadContext *tc, MVMSpeshPlanned
         : NULL;
 }
 
+/* Works out how hot a call to the specified static frame is, as the number of
+ * times the call was made per 100 entries into the frame being specialized,
+ * going by the statistics the specialization is being made from. OSR hits
+ * are not entries (they count loop iterations), so they are left out; calls
+ * made in a loop thus come out as more than 100. Returns -1 if there are no
+ * statistics to go on. */
+static MVMint32 get_call_hotness(MVMThreadContext *tc, MVMSpeshPlanned *p,
+                                 MVMSpeshIns *ins, MVMStaticFrame *target_sf) {
+    MVMuint64 entries = 0;
+    MVMuint64 calls = 0;
+    MVMuint64 hotness;
+    MVMuint32 i;
+    MVMuint32 invoke_offset;
+    if (!p)
+        return -1;
+    invoke_offset = find_invoke_offset(tc, ins);
+    if (!invoke_offset)
+        return -1;
+    for (i = 0; i < p->num_type_stats; i++) {
+        MVMSpeshStatsByType *ts = p->type_stats[i];
+        MVMuint32 j;
+        entries += ts->hits;
+        for (j = 0; j < ts->num_by_offset; j++) {
+            if (ts->by_offset[j].bytecode_offset == invoke_offset) {
+                MVMSpeshStatsByOffset *by_offset = &(ts->by_offset[j]);
+                MVMuint32 k;
+                for (k = 0; k < by_offset->num_invokes; k++)
+                    if (by_offset->invokes[k].sf == target_sf)
+                        calls += by_offset->invokes[k].count;
+            }
+        }
+    }
+    if (!entries)
+        return -1;
+    hotness = 100 * calls / entries;
+    return hotness > INT32_MAX ? INT32_MAX : (MVMint32)hotness;
+}
+
 /* Inserts resolution of the invokee to an MVMCode and the guard on the
  * invocation, and then tweaks the invoke instruction to use the resolved
  * code object (for the case it is further optimized into a fast invoke). */
@@ -1873,12 +1870,426 @@ static void tweak_for_target_sf(MVMThreadContext *tc, MVMSpeshGraph *g,
     MVM_spesh_usages_add_by_reg(tc, g, temp, ins);
 }
 
-/* Drives optimization of a call. */
+/* Finds the deopt index of the prepargs of a call. */
 static MVMuint32 get_prepargs_deopt_idx(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshCallInfo *info) {
     MVMuint32 deopt_target, deopt_index;
     find_deopt_target_and_index(tc, g, info->prepargs_ins, &deopt_target, &deopt_index);
     return deopt_index;
 }
+
+/* Finds the static frames logged as invokees at a callsite that each account
+ * for enough of its calls to be worth a polymorphic inline, most frequently
+ * invoked first. As in find_invokee_static_frame, a static frame chosen by
+ * multi dispatch is never picked. Returns the number of frames found. */
+static MVMuint32 find_polymorphic_invokees(MVMThreadContext *tc, MVMSpeshPlanned *p,
+                                           MVMSpeshIns *ins, MVMStaticFrame **result) {
+    MVMStaticFrame *seen[MVM_SPESH_POLY_INLINE_MAX_SEEN];
+    MVMuint32 seen_hits[MVM_SPESH_POLY_INLINE_MAX_SEEN];
+    MVMuint32 seen_was_multi_hits[MVM_SPESH_POLY_INLINE_MAX_SEEN];
+    MVMuint32 num_seen = 0;
+    MVMuint32 num_result = 0;
+    MVMuint32 total_hits = 0;
+    MVMuint32 i, l;
+
+    /* First try to find logging bytecode offset. */
+    MVMuint32 invoke_offset = find_invoke_offset(tc, ins);
+    if (!invoke_offset)
+        return 0;
+
+    /* Sum up the hits of each invokee. */
+    for (i = 0; i < p->num_type_stats; i++) {
+        MVMSpeshStatsByType *ts = p->type_stats[i];
+        MVMuint32 j;
+        for (j = 0; j < ts->num_by_offset; j++) {
+            if (ts->by_offset[j].bytecode_offset == invoke_offset) {
+                MVMSpeshStatsByOffset *by_offset = &(ts->by_offset[j]);
+                MVMuint32 k;
+                for (k = 0; k < by_offset->num_invokes; k++) {
+                    MVMSpeshStatsInvokeCount *ic = &(by_offset->invokes[k]);
+                    total_hits += ic->count;
+                    for (l = 0; l < num_seen; l++)
+                        if (seen[l] == ic->sf)
+                            break;
+                    if (l == num_seen) {
+                        if (num_seen == MVM_SPESH_POLY_INLINE_MAX_SEEN)
+                            continue;
+                        seen[l] = ic->sf;
+                        seen_hits[l] = 0;
+                        seen_was_multi_hits[l] = 0;
+                        num_seen++;
+                    }
+                    seen_hits[l] += ic->count;
+                    seen_was_multi_hits[l] += ic->was_multi_count;
+                }
+            }
+        }
+    }
+    if (!total_hits)
+        return 0;
+
+    /* Pick out the most frequent ones that are used often enough. */
+    while (num_result < MVM_SPESH_POLY_INLINE_MAX_TARGETS) {
+        MVMuint32 best = num_seen;
+        for (l = 0; l < num_seen; l++) {
+            if (seen[l] && !seen_was_multi_hits[l]
+                    && (100 * seen_hits[l]) / total_hits >= MVM_SPESH_POLY_INLINE_MIN_PERCENT
+                    && (best == num_seen || seen_hits[l] > seen_hits[best]))
+                best = l;
+        }
+        if (best == num_seen)
+            break;
+        result[num_result++] = seen[best];
+        seen[best] = NULL;
+    }
+    return num_result;
+}
+
+/* Allocates a new, empty, basic block for the code produced by a polymorphic
+ * inline. It is not linked into the graph yet. */
+static MVMSpeshBB * new_poly_inline_bb(MVMThreadContext *tc, MVMSpeshGraph *g,
+                                       MVMSpeshBB *call_bb) {
+    MVMSpeshBB *new_bb = MVM_spesh_alloc(tc, g, sizeof(MVMSpeshBB));
+    new_bb->idx = g->num_bbs++;
+    new_bb->initial_pc = call_bb->initial_pc;
+    new_bb->inlined = call_bb->inlined;
+    return new_bb;
+}
+
+/* Makes a copy of an instruction of the argument passing and invoke sequence
+ * of a call, for a polymorphic inline. The deopt all point of the invoke gets
+ * a deopt index of its own, with the same deopt usages as the original one;
+ * other deopt annotations are left out, as nothing will be inserted in front
+ * of the copy that could use them. */
+static MVMSpeshIns * clone_call_ins(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshIns *ins) {
+    MVMSpeshIns *clone = MVM_spesh_alloc(tc, g, sizeof(MVMSpeshIns));
+    MVMSpeshAnn *ann;
+    MVMuint32 i;
+    clone->info = ins->info;
+    clone->operands = MVM_spesh_alloc(tc, g, ins->info->num_operands * sizeof(MVMSpeshOperand));
+    memcpy(clone->operands, ins->operands, ins->info->num_operands * sizeof(MVMSpeshOperand));
+    for (i = 0; i < ins->info->num_operands; i++)
+        if ((ins->info->operands[i] & MVM_operand_rw_mask) == MVM_operand_read_reg)
+            MVM_spesh_usages_add_by_reg(tc, g, clone->operands[i], clone);
+    for (ann = ins->annotations; ann; ann = ann->next) {
+        switch (ann->type) {
+            case MVM_SPESH_ANN_DEOPT_ALL_INS: {
+                MVMint32 new_idx = MVM_spesh_graph_add_deopt_annotation(tc, g, clone,
+                    g->deopt_addrs[2 * ann->data.deopt_idx], MVM_SPESH_ANN_DEOPT_ALL_INS);
+                MVMuint32 j;
+                for (i = 0; i < g->num_locals; i++) {
+                    for (j = 0; j < g->fact_counts[i]; j++) {
+                        MVMSpeshDeoptUseEntry *due = g->facts[i][j].usage.deopt_users;
+                        while (due) {
+                            if (due->deopt_idx == ann->data.deopt_idx) {
+                                MVM_spesh_usages_add_deopt_usage(tc, g, &(g->facts[i][j]), new_idx);
+                                break;
+                            }
+                            due = due->next;
+                        }
+                    }
+                }
+                break;
+            }
+            case MVM_SPESH_ANN_LINENO:
+            case MVM_SPESH_ANN_LOGGED: {
+                MVMSpeshAnn *copy = MVM_spesh_alloc(tc, g, sizeof(MVMSpeshAnn));
+                *copy = *ann;
+                copy->next = clone->annotations;
+                clone->annotations = copy;
+                break;
+            }
+        }
+    }
+    return clone;
+}
+
+/* After polymorphic inlining, the block the call returns to has a PHI for the
+ * result of each of the inlines. Merges them into a single PHI, which also
+ * takes the result of the fallback invoke. */
+static void merge_poly_inline_result_phis(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshBB *bb,
+                                          MVMSpeshOperand result, MVMSpeshOperand fallback_result) {
+    MVMSpeshIns *merged = MVM_spesh_alloc(tc, g, sizeof(MVMSpeshIns));
+    MVMSpeshIns *cur = bb->first_ins;
+    MVMuint32 num_operands = 2;
+    MVMuint32 i, n;
+    while (cur && cur->info->opcode == MVM_SSA_PHI) {
+        if (cur->operands[0].reg.orig == result.reg.orig && cur->operands[0].reg.i == result.reg.i)
+            num_operands += cur->info->num_operands - 1;
+        cur = cur->next;
+    }
+    merged->info = get_phi(tc, g, num_operands);
+    merged->operands = MVM_spesh_alloc(tc, g, num_operands * sizeof(MVMSpeshOperand));
+    merged->operands[0] = result;
+    n = 1;
+    cur = bb->first_ins;
+    while (cur && cur->info->opcode == MVM_SSA_PHI) {
+        MVMSpeshIns *next = cur->next;
+        if (cur->operands[0].reg.orig == result.reg.orig && cur->operands[0].reg.i == result.reg.i) {
+            for (i = 1; i < cur->info->num_operands; i++)
+                merged->operands[n++] = cur->operands[i];
+            MVM_spesh_manipulate_delete_ins(tc, g, bb, cur);
+        }
+        cur = next;
+    }
+    merged->operands[n] = fallback_result;
+    for (i = 1; i < num_operands; i++)
+        MVM_spesh_usages_add_by_reg(tc, g, merged->operands[i], merged);
+    MVM_spesh_manipulate_insert_ins(tc, bb, NULL, merged);
+    MVM_spesh_get_facts(tc, g, result)->writer = merged;
+    MVM_spesh_get_facts(tc, g, result)->dead_writer = 0;
+}
+
+/* When a callsite has no stable invokee, but a few invokees account for most
+ * of the calls made there, we inline each of them. The call becomes a series
+ * of checks of the static frame of the resolved invokee, each branching to
+ * one of the inlines, followed by the original invoke for anything else. This
+ * is laid out as:
+ *
+ *     call bb:   sp_resolvecode, sp_issf, if_i -> inline 1
+ *     (checks):  sp_issf, if_i -> inline n
+ *     fallback:  prepargs, arg*, invoke
+ *                goto return point
+ *     inline 1:  inlined code
+ *     ...
+ *     inline n:  inlined code
+ *     return point
+ *
+ * The inliner puts the inlined code directly after the invoke being inlined
+ * and expects the block after it to be the one that is returned to, so each
+ * inline is placed at the end, just before the return point, before doing
+ * it. */
+static void optimize_polymorphic_call(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshBB *bb,
+                                      MVMSpeshIns *ins, MVMSpeshPlanned *p, MVMint32 callee_idx,
+                                      MVMSpeshCallInfo *arg_info) {
+    MVMStaticFrame *target_sfs[MVM_SPESH_POLY_INLINE_MAX_TARGETS];
+    MVMStaticFrame *inline_sfs[MVM_SPESH_POLY_INLINE_MAX_TARGETS];
+    MVMSpeshGraph *inline_graphs[MVM_SPESH_POLY_INLINE_MAX_TARGETS];
+    MVMuint16 inline_sizes[MVM_SPESH_POLY_INLINE_MAX_TARGETS];
+    MVMSpeshBB *inline_bbs[MVM_SPESH_POLY_INLINE_MAX_TARGETS];
+    MVMuint32 num_targets, num_inlines, i;
+    MVMSpeshBB *return_bb = bb->linear_next;
+    MVMSpeshBB *check_bb, *fallback_bb, *goto_bb, *prev_bb;
+    MVMSpeshIns *prepargs = arg_info->prepargs_ins;
+    MVMSpeshIns *cur, *resolve;
+    MVMSpeshOperand code_temp, result;
+    MVMuint32 has_result = ins->info->opcode != MVM_OP_invoke_v;
+
+    /* We only handle the usual shape of a call, where the block ends with the
+     * prepargs, arg* and invoke instructions, and falls through to the block
+     * that is returned to. We also give up if anything in the sequence has an
+     * annotation we can't duplicate, such as a handler boundary. */
+    if (!tc->instance->spesh_inline_enabled)
+        return;
+    if (arg_info->prepargs_bb != bb || bb->last_ins != ins || !return_bb
+            || bb->num_succ != 1 || bb->succ[0] != return_bb)
+        return;
+    for (cur = prepargs; cur; cur = cur->next) {
+        MVMSpeshAnn *ann;
+        switch (cur->info->opcode) {
+            case MVM_OP_prepargs:
+            case MVM_OP_arg_i:
+            case MVM_OP_arg_n:
+            case MVM_OP_arg_s:
+            case MVM_OP_arg_o:
+            case MVM_OP_argconst_i:
+            case MVM_OP_argconst_n:
+            case MVM_OP_argconst_s:
+            case MVM_OP_invoke_v:
+            case MVM_OP_invoke_i:
+            case MVM_OP_invoke_n:
+            case MVM_OP_invoke_s:
+            case MVM_OP_invoke_o:
+                break;
+            default:
+                return;
+        }
+        for (ann = cur->annotations; ann; ann = ann->next) {
+            switch (ann->type) {
+                case MVM_SPESH_ANN_DEOPT_ONE_INS:
+                case MVM_SPESH_ANN_DEOPT_ALL_INS:
+                case MVM_SPESH_ANN_LINENO:
+                case MVM_SPESH_ANN_LOGGED:
+                case MVM_SPESH_ANN_COMMENT:
+                    break;
+                default:
+                    return;
+            }
+        }
+    }
+
+    /* Obtain inline graphs for the frequent invokees. */
+    num_targets = find_polymorphic_invokees(tc, p, ins, target_sfs);
+    num_inlines = 0;
+    for (i = 0; i < num_targets; i++) {
+        MVMStaticFrame *target_sf = target_sfs[i];
+        MVMSpeshGraph *inline_graph = NULL;
+        MVMuint16 bytecode_size = 0;
+        MVMint32 hotness, spesh_cand;
+        MVMuint32 max_size;
+        if (target_sf->body.instrumentation_level != tc->instance->instrumentation_level)
+            continue;
+        hotness = get_call_hotness(tc, p, ins, target_sf);
+        max_size = MVM_spesh_inline_get_max_size_for_call(tc, target_sf, hotness);
+        spesh_cand = try_find_spesh_candidate(tc, target_sf, arg_info, NULL);
+        if (spesh_cand >= 0) {
+            MVMSpeshCandidate *cand = target_sf->body.spesh->body.spesh_candidates[spesh_cand];
+            char *no_inline_reason = NULL;
+            const MVMOpInfo *no_inline_info = NULL;
+            MVMuint32 effective_size;
+            inline_graph = MVM_spesh_inline_try_get_graph(tc, g, target_sf, cand, ins,
+                max_size, &no_inline_reason, &effective_size, &no_inline_info);
+            log_inline(tc, g, target_sf, inline_graph, effective_size, no_inline_reason, 0,
+                no_inline_info, max_size, hotness);
+            bytecode_size = (MVMuint16)cand->bytecode_size;
+        }
+        else if (target_sf->body.bytecode_size < max_size) {
+            char *no_inline_reason = NULL;
+            const MVMOpInfo *no_inline_info = NULL;
+            inline_graph = MVM_spesh_inline_try_get_graph_from_unspecialized(tc, g, target_sf,
+                ins, arg_info, NULL, &no_inline_reason, &no_inline_info);
+            log_inline(tc, g, target_sf, inline_graph, target_sf->body.bytecode_size,
+                no_inline_reason, 1, no_inline_info, max_size, hotness);
+        }
+        else {
+            log_inline(tc, g, target_sf, NULL, target_sf->body.bytecode_size,
+                "no spesh candidate available and bytecode too large to produce an inline",
+                0, NULL, max_size, hotness);
+        }
+        if (inline_graph) {
+            inline_sfs[num_inlines] = target_sf;
+            inline_graphs[num_inlines] = inline_graph;
+            inline_sizes[num_inlines] = bytecode_size;
+            inline_bbs[num_inlines] = new_poly_inline_bb(tc, g, bb);
+            num_inlines++;
+        }
+    }
+    if (!num_inlines)
+        return;
+
+    /* Resolve the invokee into a code object before the prepargs. As with a
+     * monomorphic inline, the temporary must be kept alive throughout, as the
+     * inlines use it during deopt to find the code ref. */
+    code_temp = MVM_spesh_manipulate_get_temp_reg(tc, g, MVM_reg_obj);
+    resolve = MVM_spesh_alloc(tc, g, sizeof(MVMSpeshIns));
+    resolve->info = MVM_op_get_op(MVM_OP_sp_resolvecode);
+    resolve->operands = MVM_spesh_alloc(tc, g, 2 * sizeof(MVMSpeshOperand));
+    resolve->operands[0] = code_temp;
+    resolve->operands[1] = ins->operands[callee_idx];
+    MVM_spesh_manipulate_insert_ins(tc, bb, prepargs->prev, resolve);
+    MVM_spesh_get_facts(tc, g, code_temp)->writer = resolve;
+    MVM_spesh_usages_add_by_reg(tc, g, resolve->operands[1], resolve);
+    MVM_spesh_usages_add_unconditional_deopt_usage_by_reg(tc, g, code_temp);
+
+    /* Move the call itself into a fallback block, followed by a block that
+     * goes to the return point. The fallback invoke writes a new version of
+     * the result register, which we merge with those of the inlines at the
+     * end. */
+    fallback_bb = new_poly_inline_bb(tc, g, bb);
+    goto_bb = new_poly_inline_bb(tc, g, bb);
+    bb->last_ins = prepargs->prev;
+    bb->last_ins->next = NULL;
+    prepargs->prev = NULL;
+    fallback_bb->first_ins = prepargs;
+    fallback_bb->last_ins = ins;
+    MVM_spesh_manipulate_insert_goto(tc, g, goto_bb, NULL, return_bb);
+    if (has_result) {
+        result = ins->operands[0];
+        ins->operands[0] = MVM_spesh_manipulate_new_version(tc, g, result.reg.orig);
+        MVM_spesh_get_facts(tc, g, ins->operands[0])->writer = ins;
+    }
+    MVM_spesh_manipulate_remove_successor(tc, bb, return_bb);
+    MVM_spesh_manipulate_add_successor(tc, g, fallback_bb, goto_bb);
+    MVM_spesh_manipulate_add_successor(tc, g, goto_bb, return_bb);
+    fallback_bb->linear_next = goto_bb;
+    goto_bb->linear_next = return_bb;
+
+    /* Add the checks, each in its own block, with the last one falling
+     * through to the fallback. */
+    check_bb = bb;
+    for (i = 0; i < num_inlines; i++) {
+        MVMSpeshBB *next_bb = i + 1 < num_inlines ? new_poly_inline_bb(tc, g, bb) : fallback_bb;
+        MVMSpeshOperand flag = MVM_spesh_manipulate_get_temp_reg(tc, g, MVM_reg_int64);
+        MVMSpeshIns *check = MVM_spesh_alloc(tc, g, sizeof(MVMSpeshIns));
+        MVMSpeshIns *branch = MVM_spesh_alloc(tc, g, sizeof(MVMSpeshIns));
+        check->info = MVM_op_get_op(MVM_OP_sp_issf);
+        check->operands = MVM_spesh_alloc(tc, g, 3 * sizeof(MVMSpeshOperand));
+        check->operands[0] = flag;
+        check->operands[1] = code_temp;
+        check->operands[2].lit_i16 = MVM_spesh_add_spesh_slot_try_reuse(tc, g,
+            (MVMCollectable *)inline_sfs[i]);
+        MVM_spesh_manipulate_insert_ins(tc, check_bb, check_bb->last_ins, check);
+        MVM_spesh_get_facts(tc, g, flag)->writer = check;
+        MVM_spesh_usages_add_by_reg(tc, g, code_temp, check);
+        branch->info = MVM_op_get_op(MVM_OP_if_i);
+        branch->operands = MVM_spesh_alloc(tc, g, 2 * sizeof(MVMSpeshOperand));
+        branch->operands[0] = flag;
+        branch->operands[1].ins_bb = inline_bbs[i];
+        MVM_spesh_manipulate_insert_ins(tc, check_bb, check, branch);
+        MVM_spesh_usages_add_by_reg(tc, g, flag, branch);
+        MVM_spesh_manipulate_release_temp_reg(tc, g, flag);
+        MVM_spesh_manipulate_add_successor(tc, g, check_bb, inline_bbs[i]);
+        MVM_spesh_manipulate_add_successor(tc, g, check_bb, next_bb);
+        check_bb->linear_next = next_bb;
+        if (MVM_spesh_debug_enabled(tc)) {
+            char *cuuid_cstr = MVM_string_utf8_encode_C_string(tc, inline_sfs[i]->body.cuuid);
+            char *name_cstr  = MVM_string_utf8_encode_C_string(tc, inline_sfs[i]->body.name);
+            MVM_spesh_graph_add_comment(tc, g, check, "polymorphic inline of '%s' (%s)",
+                name_cstr, cuuid_cstr);
+            MVM_free(cuuid_cstr);
+            MVM_free(name_cstr);
+        }
+        check_bb = next_bb;
+    }
+
+    /* Now produce each of the inlines in turn. */
+    prev_bb = goto_bb;
+    for (i = 0; i < num_inlines; i++) {
+        MVMSpeshBB *inline_bb = inline_bbs[i];
+        MVMSpeshBB *optimize_from_bb = inline_graphs[i]->entry;
+        MVMSpeshCallInfo inline_info = *arg_info;
+        MVMSpeshIns *inline_invoke = NULL;
+        MVMuint32 j;
+
+        /* Copy the argument passing and the invoke, which calls the resolved
+         * code object and writes the original result register. */
+        for (cur = prepargs; cur; cur = cur->next) {
+            MVMSpeshIns *clone = clone_call_ins(tc, g, cur);
+            MVM_spesh_manipulate_insert_ins(tc, inline_bb, inline_bb->last_ins, clone);
+            for (j = 0; j < MAX_ARGS_FOR_OPT; j++)
+                if (arg_info->arg_ins[j] == cur)
+                    inline_info.arg_ins[j] = clone;
+            if (cur == prepargs)
+                inline_info.prepargs_ins = clone;
+            inline_invoke = clone;
+        }
+        inline_info.prepargs_bb = inline_bb;
+        MVM_spesh_usages_delete_by_reg(tc, g, inline_invoke->operands[callee_idx], inline_invoke);
+        inline_invoke->operands[callee_idx] = code_temp;
+        MVM_spesh_usages_add_by_reg(tc, g, code_temp, inline_invoke);
+        if (has_result)
+            inline_invoke->operands[0] = result;
+
+        /* Place it just before the return point, and inline it. */
+        prev_bb->linear_next = inline_bb;
+        inline_bb->linear_next = return_bb;
+        MVM_spesh_manipulate_add_successor(tc, g, inline_bb, return_bb);
+        MVM_spesh_inline(tc, g, &inline_info, inline_bb, inline_invoke, inline_graphs[i],
+            inline_sfs[i], code_temp, get_prepargs_deopt_idx(tc, g, arg_info), inline_sizes[i]);
+        optimize_bb(tc, g, optimize_from_bb, NULL);
+
+        /* Find the end of the inlined code, for the next one to follow. */
+        prev_bb = inline_bb;
+        while (prev_bb->linear_next != return_bb)
+            prev_bb = prev_bb->linear_next;
+    }
+
+    /* Merge the results, and release the code temporary. */
+    if (has_result)
+        merge_poly_inline_result_phis(tc, g, return_bb, result, ins->operands[0]);
+    MVM_spesh_manipulate_release_temp_reg(tc, g, code_temp);
+}
+
+/* Drives optimization of a call. */
 static void optimize_call(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshBB *bb,
                           MVMSpeshIns *ins, MVMSpeshPlanned *p, MVMint32 callee_idx,
                           MVMSpeshCallInfo *arg_info) {
@@ -1909,6 +2320,12 @@ static void optimize_call(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshBB *bb
             have_code_temp = 1;
             tweak_for_target_sf(tc, g, target_sf, ins, arg_info, code_temp);
         }
+        else {
+            /* No stable one, but there may be a few frequent ones that we
+             * can inline. */
+            optimize_polymorphic_call(tc, g, bb, ins, p, callee_idx, arg_info);
+            return;
+        }
     }
     if (!code && !target_sf)
         return;
@@ -2043,6 +2460,9 @@ static void optimize_call(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshBB *bb
 
     /* See if we can point the call at a particular specialization. */
     if (target_sf->body.instrumentation_level == tc->instance->instrumentation_level) {
+        /* The size we're willing to inline depends on how hot the call is. */
+        MVMint32 hotness = get_call_hotness(tc, p, ins, target_sf);
+        MVMuint32 max_size = MVM_spesh_inline_get_max_size_for_call(tc, target_sf, hotness);
         MVMint32 spesh_cand = try_find_spesh_candidate(tc, target_sf, arg_info,
             stable_type_tuple);
         if (spesh_cand >= 0) {
@@ -2052,8 +2472,9 @@ static void optimize_call(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshBB *bb
             MVMuint32 effective_size;
             MVMSpeshGraph *inline_graph = MVM_spesh_inline_try_get_graph(tc, g,
                 target_sf, target_sf->body.spesh->body.spesh_candidates[spesh_cand],
-                ins, &no_inline_reason, &effective_size, &no_inline_info);
-            log_inline(tc, g, target_sf, inline_graph, effective_size, no_inline_reason, 0, no_inline_info);
+                ins, max_size, &no_inline_reason, &effective_size, &no_inline_info);
+            log_inline(tc, g, target_sf, inline_graph, effective_size, no_inline_reason, 0,
+                no_inline_info, max_size, hotness);
             if (inline_graph) {
                 /* Yes, have inline graph, so go ahead and do it. Make sure we
                  * keep the code ref reg alive by giving it a usage count as
@@ -2133,13 +2554,13 @@ static void optimize_call(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshBB *bb
 
         /* We know what we're calling, but there's no specialization available
          * to us. If it's small, then we could produce one and inline it. */
-        else if (target_sf->body.bytecode_size < MVM_spesh_inline_get_max_size(tc, target_sf)) {
+        else if (target_sf->body.bytecode_size < max_size) {
             char *no_inline_reason = NULL;
             const MVMOpInfo *no_inline_info = NULL;
             MVMSpeshGraph *inline_graph = MVM_spesh_inline_try_get_graph_from_unspecialized(
                     tc, g, target_sf, ins, arg_info, stable_type_tuple, &no_inline_reason, &no_inline_info);
             log_inline(tc, g, target_sf, inline_graph, target_sf->body.bytecode_size,
-                    no_inline_reason, 1, no_inline_info);
+                    no_inline_reason, 1, no_inline_info, max_size, hotness);
             if (inline_graph) {
                 MVMSpeshOperand code_ref_reg = ins->info->opcode == MVM_OP_invoke_v
                         ? ins->operands[0]
@@ -2156,7 +2577,7 @@ static void optimize_call(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshBB *bb
         else {
             log_inline(tc, g, target_sf, NULL, target_sf->body.bytecode_size,
                 "no spesh candidate available and bytecode too large to produce an inline",
-                0, NULL);
+                0, NULL, max_size, hotness);
         }
     }
 
@@ -2699,10 +3120,6 @@ static void optimize_bb_switch(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshB
         case MVM_OP_hllboolfor:
             optimize_hllbool(tc, g, ins);
             break;
-        case MVM_OP_gethllsym:
-        case MVM_OP_getcurhllsym:
-            optimize_getcurhllsym(tc, g, ins);
-            break;
         case MVM_OP_if_i:
         case MVM_OP_unless_i:
         case MVM_OP_if_n:
@@ -3417,6 +3834,11 @@ void MVM_spesh_optimize(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshPlanned
     MVM_spesh_eliminate_dead_ins(tc, g);
     MVM_spesh_eliminate_dead_bbs(tc, g, 1);
 
+    /* Now that the graph is in its final shape, move computations that do
+     * not change between loop iterations out of loops. */
+    if (tc->instance->spesh_licm_enabled)
+        MVM_spesh_licm(tc, g);
+
 #if MVM_SPESH_CHECK_DU
     MVM_spesh_usages_check(tc, g);
 #endif
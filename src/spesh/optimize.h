@@ -7,6 +7,19 @@
  * So if this is 99, then we expect 1% of calls may deopt. */
 #define MVM_SPESH_CALLSITE_STABLE_PERCENT 99
 
+/* A callsite without a stable invokee may still have a few that account for
+ * most of its calls. Up to this many of them are inlined, each behind a check
+ * of the static frame being invoked, with a normal invoke for anything else. */
+#define MVM_SPESH_POLY_INLINE_MAX_TARGETS 3
+
+/* Percentage of the calls at a callsite that an invokee must account for to
+ * be considered for such a polymorphic inline. */
+#define MVM_SPESH_POLY_INLINE_MIN_PERCENT 20
+
+/* The number of distinct invokees at a callsite we keep count of when looking
+ * for polymorphic inline targets. */
+#define MVM_SPESH_POLY_INLINE_MAX_SEEN 16
+
 /* Information we've gathered about the current call we're optimizing, and the
  * arguments it will take. */
 struct MVMSpeshCallInfo {
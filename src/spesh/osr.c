@@ -3,13 +3,39 @@
 /* Writes to stderr about each OSR that we perform. */
 #define MVM_LOG_OSR 0
 
+/* Works out the offset in the original bytecode of the OSR point we are at.
+ * A negative baseline deopt index means we're in the interpreter, otherwise
+ * it is the OSR deopt index of the JIT-compiled baseline code we're in. */
+static MVMint32 get_osr_offset(MVMThreadContext *tc, MVMint32 baseline_deopt_idx) {
+    MVMSpeshCandidate *running = tc->cur_frame->spesh_cand;
+    MVMint32 offset;
+    MVMuint32 i;
+
+    /* The JIT knows the deopt index, which maps straight to the offset. */
+    if (baseline_deopt_idx >= 0)
+        return running->deopts[2 * baseline_deopt_idx];
+
+    /* Otherwise, calculate the offset in the interpreter. */
+    offset = (*(tc->interp_cur_op) - *(tc->interp_bytecode_start));
+
+    /* If we're running a baseline candidate, map the offset back to the one
+     * in the original bytecode. Its OSR deopt points are at the osrpoint
+     * instructions themselves, which we just read past. */
+    if (running) {
+        for (i = 0; i < running->num_deopts; i++)
+            if (running->deopts[2 * i + 1] == offset - 2)
+                return running->deopts[2 * i];
+        MVM_oops(tc, "Spesh: get_osr_offset failed to map baseline offset");
+    }
+    return offset;
+}
+
 /* Locates deopt index matching OSR point. */
-static MVMint32 get_osr_deopt_index(MVMThreadContext *tc, MVMSpeshCandidate *cand) {
-    /* Calculate offset. */
-    MVMint32 offset = (*(tc->interp_cur_op) - *(tc->interp_bytecode_start));
+static MVMint32 get_osr_deopt_index(MVMThreadContext *tc, MVMSpeshCandidate *cand,
+        MVMint32 offset) {
+    MVMuint32 i;
 
     /* Locate it in the deopt table. */
-    MVMuint32 i;
     for (i = 0; i < cand->num_deopts; i++)
         if (cand->deopts[2 * i] == offset)
             return i;
@@ -19,11 +45,13 @@ static MVMint32 get_osr_deopt_index(MVMThreadContext *tc, MVMSpeshCandidate *can
 }
 
 /* Does the jump into the optimized code. */
-void perform_osr(MVMThreadContext *tc, MVMSpeshCandidate *specialized) {
+void perform_osr(MVMThreadContext *tc, MVMSpeshCandidate *specialized,
+        MVMint32 baseline_deopt_idx) {
     MVMJitCode *jit_code;
     MVMint32 num_locals;
     /* Work out the OSR deopt index, to locate the entry point. */
-    MVMint32 osr_index = get_osr_deopt_index(tc, specialized);
+    MVMint32 osr_index = get_osr_deopt_index(tc, specialized,
+        get_osr_offset(tc, baseline_deopt_idx));
 #if MVM_LOG_OSR
     fprintf(stderr, "Performing OSR of frame '%s' (cuid: %s) at index %d\n",
         MVM_string_utf8_encode_C_string(tc, tc->cur_frame->static_info->body.name),
@@ -152,11 +180,13 @@ MVMCallsite * find_callsite_and_args(MVMThreadContext *tc, MVMRegister **args) {
     }
 }
 
-/* Polls for an optimization and, when one is produced, jumps into it. */
-void MVM_spesh_osr_poll_for_result(MVMThreadContext *tc) {
+/* Polls for an optimization and, when one is produced, jumps into it.
+ * Returns non-zero if we did so. */
+static MVMint32 poll_for_result(MVMThreadContext *tc, MVMint32 baseline_deopt_idx) {
     MVMStaticFrameSpesh *spesh = tc->cur_frame->static_info->body.spesh;
     MVMint32 num_cands = spesh->body.num_spesh_candidates;
     MVMint32 seq_nr = tc->cur_frame->sequence_nr;
+    MVMint32 performed = 0;
     if (seq_nr != tc->osr_hunt_frame_nr || num_cands != tc->osr_hunt_num_spesh_candidates) {
         /* Provided OSR is enabled... */
         if (tc->instance->spesh_osr_enabled) {
@@ -167,12 +197,35 @@ void MVM_spesh_osr_poll_for_result(MVMThreadContext *tc) {
                 spesh->body.spesh_arg_guard,
                 (cs && cs->is_interned ? cs : NULL),
                 args, NULL);
-            if (ag_result >= 0)
-                perform_osr(tc, spesh->body.spesh_candidates[ag_result]);
+            MVMSpeshCandidate *chosen = ag_result >= 0
+                ? spesh->body.spesh_candidates[ag_result]
+                : NULL;
+
+            /* Don't move a frame that is being logged into a baseline
+             * candidate, since it would then stop logging. */
+            if (chosen && chosen != tc->cur_frame->spesh_cand &&
+                    !(chosen->is_baseline && MVM_spesh_log_is_logging(tc))) {
+                perform_osr(tc, chosen, baseline_deopt_idx);
+                performed = 1;
+            }
         }
 
         /* Update state for avoiding checks in the common case. */
         tc->osr_hunt_frame_nr = seq_nr;
         tc->osr_hunt_num_spesh_candidates = num_cands;
     }
+    return performed;
+}
+void MVM_spesh_osr_poll_for_result(MVMThreadContext *tc) {
+    poll_for_result(tc, -1);
+}
+
+/* Called by JIT-compiled baseline code at an OSR point, identified by its
+ * deopt index. Logs the OSR point and polls for an optimization; if we moved
+ * into one, returns non-zero and the JIT-compiled code must then exit, so
+ * that the interpreter can run the new code. */
+MVMint32 MVM_spesh_osr_poll_for_result_jit(MVMThreadContext *tc, MVMint32 deopt_idx) {
+    if (MVM_spesh_log_is_logging_osr(tc))
+        MVM_spesh_log_osr(tc);
+    return poll_for_result(tc, deopt_idx);
 }
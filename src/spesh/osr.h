@@ -1 +1,2 @@
 void MVM_spesh_osr_poll_for_result(MVMThreadContext *tc);
+MVMint32 MVM_spesh_osr_poll_for_result_jit(MVMThreadContext *tc, MVMint32 deopt_idx);
@@ -22,6 +22,7 @@ static void pea_log(char *fmt, ...) {
 #define TRANSFORM_ADD_DEOPT_POINT   5
 #define TRANSFORM_ADD_DEOPT_USAGE   6
 #define TRANSFORM_PROF_ALLOCATED    7
+#define TRANSFORM_FASTBOX_TO_SET    8
 typedef struct {
     /* The allocation that this transform relates to eliminating. */
     MVMSpeshPEAAllocation *allocation;
@@ -106,6 +107,9 @@ typedef struct {
 
     /* Tracked registers. */
     MVM_VECTOR_DECL(TrackedRegister, tracked_registers);
+
+    /* Whether the graph has any loops. */
+    MVMuint8 has_loops;
 } GraphState;
 
 /* Turns a flattened-in STable into a register type to allocate, if possible.
@@ -133,6 +137,26 @@ MVMint32 flattened_type_to_register_kind(MVMThreadContext *tc, MVMSTable *st) {
     }
 }
 
+/* Gets the number of attributes of a tracked allocation. A box (P6int,
+ * P6num or P6str) is treated as having a single attribute, its value. */
+static MVMuint32 allocation_num_attrs(MVMSpeshPEAAllocation *alloc) {
+    MVMSTable *st = alloc->type->st;
+    return st->REPR->ID == MVM_REPR_ID_P6opaque
+        ? ((MVMP6opaqueREPRData *)st->REPR_data)->num_attributes
+        : 1;
+}
+
+/* Gets the kind of register needed to hold an attribute of a tracked
+ * allocation, or a negative value if it can't be held in a register. */
+static MVMint32 allocation_attr_kind(MVMThreadContext *tc, MVMSpeshPEAAllocation *alloc,
+        MVMuint32 idx) {
+    MVMSTable *st = alloc->type->st;
+    return st->REPR->ID == MVM_REPR_ID_P6opaque
+        ? flattened_type_to_register_kind(tc,
+            ((MVMP6opaqueREPRData *)st->REPR_data)->flattened_stables[idx])
+        : flattened_type_to_register_kind(tc, st);
+}
+
 /* Gets, allocating if needed, the deopt materialization info index of a
  * particular tracked object. */
 static MVMuint16 get_deopt_materialization_info(MVMThreadContext *tc, MVMSpeshGraph *g,
@@ -144,8 +168,7 @@ static MVMuint16 get_deopt_materialization_info(MVMThreadContext *tc, MVMSpeshGr
         MVMSpeshPEAMaterializeInfo mi;
 
         /* Build up information about registers containing attribute data. */
-        MVMP6opaqueREPRData *repr_data = (MVMP6opaqueREPRData *)alloc->type->st->REPR_data;
-        MVMuint32 num_attrs = repr_data->num_attributes;
+        MVMuint32 num_attrs = allocation_num_attrs(alloc);
         MVMuint16 *attr_regs;
         if (num_attrs > 0) {
             MVMuint32 i;
@@ -169,6 +192,19 @@ static MVMuint16 get_deopt_materialization_info(MVMThreadContext *tc, MVMSpeshGr
     }
 }
 
+/* Allocates the registers that hold the attributes of a scalar-replaced
+ * allocation. */
+static void allocate_attr_regs(MVMThreadContext *tc, MVMSpeshGraph *g, GraphState *gs,
+        MVMSpeshPEAAllocation *alloc) {
+    MVMuint32 num_attrs = allocation_num_attrs(alloc);
+    MVMuint32 i;
+    for (i = 0; i < num_attrs; i++) {
+        MVMuint32 idx = alloc->hypothetical_attr_reg_idxs[i];
+        gs->attr_regs[idx] = MVM_spesh_manipulate_get_unique_reg(tc, g,
+            allocation_attr_kind(tc, alloc, i));
+    }
+}
+
 /* Apply a transformation to the graph. */
 static void apply_transform(MVMThreadContext *tc, MVMSpeshGraph *g, GraphState *gs,
         MVMSpeshBB *bb, Transformation *t) {
@@ -181,20 +217,34 @@ static void apply_transform(MVMThreadContext *tc, MVMSpeshGraph *g, GraphState *
     switch (t->transform) {
         case TRANSFORM_DELETE_FASTCREATE: {
             MVMSTable *st = t->fastcreate.st;
-            MVMP6opaqueREPRData *repr_data = (MVMP6opaqueREPRData *)st->REPR_data;
-            MVMSpeshPEAAllocation *alloc = t->allocation;
-            MVMuint32 i;
-            for (i = 0; i < repr_data->num_attributes; i++) {
-                MVMuint32 idx = alloc->hypothetical_attr_reg_idxs[i];
-                gs->attr_regs[idx] = MVM_spesh_manipulate_get_unique_reg(tc, g,
-                    flattened_type_to_register_kind(tc, repr_data->flattened_stables[i]));
-            }
+            allocate_attr_regs(tc, g, gs, t->allocation);
             pea_log("OPT: eliminated an allocation of %s into r%d(%d)",
                     st->debug_name, t->fastcreate.ins->operands[0].reg.orig,
                     t->fastcreate.ins->operands[0].reg.i);
             MVM_spesh_manipulate_delete_ins(tc, g, bb, t->fastcreate.ins);
             break;
         }
+        case TRANSFORM_FASTBOX_TO_SET: {
+            /* The box is an allocation and a bind of its value in one; we
+             * replace it with a set of the value into the register that
+             * holds the scalar-replaced value. */
+            MVMSpeshIns *ins = t->fastcreate.ins;
+            MVMSpeshIns *set_ins = MVM_spesh_alloc(tc, g, sizeof(MVMSpeshIns));
+            allocate_attr_regs(tc, g, gs, t->allocation);
+            set_ins->info = MVM_op_get_op(MVM_OP_set);
+            set_ins->operands = MVM_spesh_alloc(tc, g, 2 * sizeof(MVMSpeshOperand));
+            set_ins->operands[0] = MVM_spesh_manipulate_new_version(tc, g,
+                gs->attr_regs[t->allocation->hypothetical_attr_reg_idxs[0]]);
+            set_ins->operands[1] = ins->operands[4];
+            MVM_spesh_get_facts(tc, g, set_ins->operands[0])->writer = set_ins;
+            MVM_spesh_usages_add_by_reg(tc, g, set_ins->operands[1], set_ins);
+            MVM_spesh_manipulate_insert_ins(tc, bb, ins->prev, set_ins);
+            MVM_spesh_graph_add_comment(tc, g, set_ins, "scalar-replaced box into a %s",
+                    t->fastcreate.st->debug_name);
+            pea_log("OPT: eliminated a box into a %s", t->fastcreate.st->debug_name);
+            MVM_spesh_manipulate_delete_ins(tc, g, bb, ins);
+            break;
+        }
         case TRANSFORM_GETATTR_TO_SET: {
             MVMSpeshIns *ins = t->attr.ins;
             MVM_spesh_usages_delete_by_reg(tc, g, ins->operands[1], ins);
@@ -273,26 +323,34 @@ static void add_tracked_register(MVMThreadContext *tc, GraphState *gs, MVMSpeshO
 /* Sees if this is something we can potentially avoid really allocating. If
  * it is, sets up the allocation tracking state that we need. */
 static MVMSpeshPEAAllocation * try_track_allocation(MVMThreadContext *tc, MVMSpeshGraph *g,
-        GraphState *gs, MVMSpeshIns *alloc_ins, MVMSTable *st) {
-    if (st->REPR->ID == MVM_REPR_ID_P6opaque) {
-        MVMP6opaqueREPRData *repr_data = (MVMP6opaqueREPRData *)st->REPR_data;
-        MVMSpeshPEAAllocation *alloc = MVM_spesh_alloc(tc, g, sizeof(MVMSpeshPEAAllocation));
-        MVMuint32 i;
-        alloc->allocator = alloc_ins;
-        alloc->type = st->WHAT;
-        alloc->hypothetical_attr_reg_idxs = MVM_spesh_alloc(tc, g,
-                repr_data->num_attributes * sizeof(MVMuint16));
-        for (i = 0; i < repr_data->num_attributes; i++) {
-            /* Make sure it's an attribute type we know how to handle. */
-            if (flattened_type_to_register_kind(tc, repr_data->flattened_stables[i]) < 0)
-                return NULL;
-
-            /* Pick an index that will later come to refer to an allocated
-             * register if we apply transforms. */
-            alloc->hypothetical_attr_reg_idxs[i] = gs->latest_hypothetical_reg_idx++;
+        GraphState *gs, MVMSpeshBB *bb, MVMSpeshIns *alloc_ins, MVMSTable *st) {
+    switch (st->REPR->ID) {
+        case MVM_REPR_ID_P6opaque:
+        case MVM_REPR_ID_P6int:
+        case MVM_REPR_ID_P6num:
+        case MVM_REPR_ID_P6str: {
+            MVMSpeshPEAAllocation *alloc = MVM_spesh_alloc(tc, g, sizeof(MVMSpeshPEAAllocation));
+            MVMuint32 num_attrs;
+            MVMuint32 i;
+            alloc->allocator = alloc_ins;
+            alloc->allocator_bb = bb;
+            alloc->type = st->WHAT;
+            num_attrs = allocation_num_attrs(alloc);
+            alloc->hypothetical_attr_reg_idxs = MVM_spesh_alloc(tc, g,
+                    num_attrs * sizeof(MVMuint16));
+            alloc->bound_attrs = MVM_spesh_alloc(tc, g, num_attrs);
+            for (i = 0; i < num_attrs; i++) {
+                /* Make sure it's an attribute type we know how to handle. */
+                if (allocation_attr_kind(tc, alloc, i) < 0)
+                    return NULL;
+
+                /* Pick an index that will later come to refer to an allocated
+                 * register if we apply transforms. */
+                alloc->hypothetical_attr_reg_idxs[i] = gs->latest_hypothetical_reg_idx++;
+            }
+            add_tracked_register(tc, gs, alloc_ins->operands[0], alloc);
+            return alloc;
         }
-        add_tracked_register(tc, gs, alloc_ins->operands[0], alloc);
-        return alloc;
     }
     return NULL;
 }
@@ -358,11 +416,55 @@ static MVMSpeshFacts * create_shadow_facts_c(MVMThreadContext *tc, GraphState *g
     return facts;
 }
 
-/* Map an object offset to the register with its scalar replacement. */
-static MVMuint16 attribute_offset_to_reg(MVMThreadContext *tc, MVMSpeshPEAAllocation *alloc,
-        MVMint16 offset) {
-    MVMuint32 idx = MVM_p6opaque_offset_to_attr_idx(tc, alloc->type, offset);
-    return alloc->hypothetical_attr_reg_idxs[idx];
+/* Map an offset from the start of an object (so including its header) to
+ * the index of the attribute stored there, or -1 if there is none. */
+static MVMint32 attribute_offset_to_idx(MVMThreadContext *tc, MVMSpeshPEAAllocation *alloc,
+        MVMint32 offset) {
+    MVMSTable *st = alloc->type->st;
+    switch (st->REPR->ID) {
+        case MVM_REPR_ID_P6opaque: {
+            MVMP6opaqueREPRData *repr_data = (MVMP6opaqueREPRData *)st->REPR_data;
+            MVMuint32 i;
+            for (i = 0; i < repr_data->num_attributes; i++)
+                if (repr_data->attribute_offsets[i] + (MVMint32)sizeof(MVMObject) == offset)
+                    return i;
+            return -1;
+        }
+        case MVM_REPR_ID_P6int:
+            return offset == offsetof(MVMP6int, body.value) ? 0 : -1;
+        case MVM_REPR_ID_P6num:
+            return offset == offsetof(MVMP6num, body.value) ? 0 : -1;
+        case MVM_REPR_ID_P6str:
+            return offset == offsetof(MVMP6str, body.value) ? 0 : -1;
+        default:
+            return -1;
+    }
+}
+
+/* Gets the kind of register that an attribute access instruction reads
+ * into or writes from. */
+static MVMint32 attribute_op_register_kind(MVMuint16 opcode) {
+    switch (opcode) {
+        case MVM_OP_sp_bind_i64:
+        case MVM_OP_sp_p6obind_i:
+        case MVM_OP_sp_get_i64:
+        case MVM_OP_sp_p6oget_i:
+        case MVM_OP_sp_p6oget_bi:
+            return MVM_reg_int64;
+        case MVM_OP_sp_bind_n:
+        case MVM_OP_sp_p6obind_n:
+        case MVM_OP_sp_get_n:
+        case MVM_OP_sp_p6oget_n:
+            return MVM_reg_num64;
+        case MVM_OP_sp_bind_s:
+        case MVM_OP_sp_bind_s_nowb:
+        case MVM_OP_sp_p6obind_s:
+        case MVM_OP_sp_get_s:
+        case MVM_OP_sp_p6oget_s:
+            return MVM_reg_str;
+        default:
+            return MVM_reg_obj;
+    }
 }
 
 /* Check if an allocation is being tracked. */
@@ -385,6 +487,46 @@ static void real_object_required(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpes
     }
 }
 
+/* Marks an allocation as irreplaceable. */
+static void mark_irreplaceable(MVMSpeshPEAAllocation *alloc, MVMSpeshIns *ins, char *why) {
+    if (!alloc->irreplaceable) {
+        alloc->irreplaceable = 1;
+        pea_log("replacement impossible due to %s (%s)", ins->info->name, why);
+    }
+}
+
+/* Looks up the attribute at the specified offset (from the start of the
+ * object) of a tracked allocation, which an instruction reads or writes,
+ * and returns the hypothetical register that will hold it. Should the
+ * access be one we can't replace, marks the allocation irreplaceable and
+ * returns -1. */
+static MVMint32 tracked_attribute_reg(MVMThreadContext *tc, GraphState *gs, MVMSpeshBB *bb,
+        MVMSpeshIns *ins, MVMSpeshPEAAllocation *alloc, MVMint32 offset, MVMint32 is_write) {
+    MVMint32 idx = attribute_offset_to_idx(tc, alloc, offset);
+    if (idx < 0 || allocation_attr_kind(tc, alloc, idx) !=
+            attribute_op_register_kind(ins->info->opcode)) {
+        mark_irreplaceable(alloc, ins, "unexpected attribute access");
+        return -1;
+    }
+    if (gs->has_loops) {
+        /* In a graph with loops, we only replace attributes when all of the
+         * binds are in the allocating block, so that every read of them sees
+         * the same register version whichever path was taken to it. */
+        if (is_write) {
+            if (bb != alloc->allocator_bb) {
+                mark_irreplaceable(alloc, ins, "bind outside of allocating block");
+                return -1;
+            }
+            alloc->bound_attrs[idx] = 1;
+        }
+        else if (!alloc->bound_attrs[idx]) {
+            mark_irreplaceable(alloc, ins, "read of unbound attribute");
+            return -1;
+        }
+    }
+    return alloc->hypothetical_attr_reg_idxs[idx];
+}
+
 /* Checks if any of the tracked objects are needed beyond this deopt point,
  * and adds a transform to set up that deopt info if needed. Also makes sure
  * that current versions of registers used in scalar replacement will have a
@@ -392,9 +534,9 @@ static void real_object_required(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpes
 static void add_scalar_replacement_deopt_usages(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshBB *bb,
                                                 GraphState *gs, MVMSpeshPEAAllocation *alloc,
                                                 MVMint32 deopt_idx) {
-    MVMP6opaqueREPRData *repr_data = (MVMP6opaqueREPRData *)alloc->type->st->REPR_data;
+    MVMuint32 num_attrs = allocation_num_attrs(alloc);
     MVMuint32 i;
-    for (i = 0; i < repr_data->num_attributes; i++) {
+    for (i = 0; i < num_attrs; i++) {
         Transformation *tran = MVM_spesh_alloc(tc, g, sizeof(Transformation));
         tran->allocation = alloc;
         tran->transform = TRANSFORM_ADD_DEOPT_USAGE;
@@ -461,27 +603,28 @@ static void add_deopt_materializations_ins(MVMThreadContext *tc, MVMSpeshGraph *
 /* Performs the analysis phase of partial escape anslysis, figuring out what
  * rewrites we can do on the graph to achieve scalar replacement of objects
  * and, perhaps, some guard eliminations. */
-static MVMuint32 analyze(MVMThreadContext *tc, MVMSpeshGraph *g, GraphState *gs) {
-    MVMSpeshBB **rpo = MVM_spesh_graph_reverse_postorder(tc, g);
-    MVMuint8 *seen = MVM_calloc(g->num_bbs, 1);
+static MVMuint32 analyze(MVMThreadContext *tc, MVMSpeshGraph *g, GraphState *gs,
+        MVMSpeshBB **rpo) {
     MVMuint32 found_replaceable = 0;
     MVMuint32 ins_count = 0;
     MVMuint32 i;
+
+    /* A block with a predecessor that comes no earlier than it in reverse
+     * postorder is a loop header. We walk the blocks in reverse postorder,
+     * so a value flowing around a loop back edge is only seen after the PHI
+     * that it flows into; we handle that by checking all PHIs once again at
+     * the end, and by being more conservative about attribute binds. */
     for (i = 0; i < g->num_bbs; i++) {
         MVMSpeshBB *bb = rpo[i];
-        MVMSpeshIns *ins = bb->first_ins;
-
-        /* For now, we don't handle loops; bail entirely if we see one. */
         MVMuint32 j;
-        for (j = 0; j < bb->num_pred; j++) {
-            if (!seen[bb->pred[j]->rpo_idx]) {
-                pea_log("partial escape analysis not implemented for loops");
-                MVM_free(seen);
-                MVM_free(rpo);
-                return 0;
-            }
-        }
+        for (j = 0; j < bb->num_pred; j++)
+            if (bb->pred[j]->rpo_idx >= bb->rpo_idx)
+                gs->has_loops = 1;
+    }
 
+    for (i = 0; i < g->num_bbs; i++) {
+        MVMSpeshBB *bb = rpo[i];
+        MVMSpeshIns *ins = bb->first_ins;
         while (ins) {
             MVMuint16 opcode = ins->info->opcode;
 
@@ -522,7 +665,7 @@ static MVMuint32 analyze(MVMThreadContext *tc, MVMSpeshGraph *g, GraphState *gs)
             switch (opcode) {
                 case MVM_OP_sp_fastcreate: {
                     MVMSTable *st = (MVMSTable *)g->spesh_slots[ins->operands[2].lit_i16];
-                    MVMSpeshPEAAllocation *alloc = try_track_allocation(tc, g, gs, ins, st);
+                    MVMSpeshPEAAllocation *alloc = try_track_allocation(tc, g, gs, bb, ins, st);
                     if (alloc) {
                         MVMSpeshFacts *target = MVM_spesh_get_facts(tc, g, ins->operands[0]);
                         Transformation *tran = MVM_spesh_alloc(tc, g, sizeof(Transformation));
@@ -536,6 +679,32 @@ static MVMuint32 analyze(MVMThreadContext *tc, MVMSpeshGraph *g, GraphState *gs)
                     }
                     break;
                 }
+                case MVM_OP_sp_fastbox_i:
+                case MVM_OP_sp_fastbox_i_ic:
+                case MVM_OP_sp_fastbox_bi:
+                case MVM_OP_sp_fastbox_bi_ic: {
+                    /* Boxing of a native integer, into either a P6int or
+                     * a P6opaque with a single big integer attribute. The
+                     * value always fits in a native integer register. */
+                    MVMSTable *st = (MVMSTable *)g->spesh_slots[ins->operands[2].lit_i16];
+                    MVMSpeshPEAAllocation *alloc = try_track_allocation(tc, g, gs, bb, ins, st);
+                    if (alloc) {
+                        MVMSpeshFacts *target = MVM_spesh_get_facts(tc, g, ins->operands[0]);
+                        Transformation *tran = MVM_spesh_alloc(tc, g, sizeof(Transformation));
+                        if (allocation_num_attrs(alloc) != 1 ||
+                                allocation_attr_kind(tc, alloc, 0) != MVM_reg_int64)
+                            mark_irreplaceable(alloc, ins, "unexpected box type");
+                        tran->allocation = alloc;
+                        tran->transform = TRANSFORM_FASTBOX_TO_SET;
+                        tran->fastcreate.ins = ins;
+                        tran->fastcreate.st = st;
+                        add_transform_for_bb(tc, gs, bb, tran);
+                        target->pea.allocation = alloc;
+                        alloc->bound_attrs[0] = 1;
+                        found_replaceable = 1;
+                    }
+                    break;
+                }
                 case MVM_OP_set: {
                     /* A set instruction just aliases the tracked object; we
                      * can potentially elimiante it. */
@@ -565,15 +734,18 @@ static MVMuint32 analyze(MVMThreadContext *tc, MVMSpeshGraph *g, GraphState *gs)
                      * tracked object into a set. */
                     MVMSpeshFacts *target = MVM_spesh_get_facts(tc, g, ins->operands[0]);
                     MVMSpeshPEAAllocation *alloc = target->pea.allocation;
-                    if (allocation_tracked(alloc)) {
-                        MVMint32 is_p6o_op = opcode == MVM_OP_sp_p6obind_i ||
-                            opcode == MVM_OP_sp_p6obind_n ||
-                            opcode == MVM_OP_sp_p6obind_s ||
-                            opcode == MVM_OP_sp_p6obind_o;
-                        MVMuint16 hypothetical_reg = attribute_offset_to_reg(tc, alloc,
+                    MVMint32 is_p6o_op = opcode == MVM_OP_sp_p6obind_i ||
+                        opcode == MVM_OP_sp_p6obind_n ||
+                        opcode == MVM_OP_sp_p6obind_s ||
+                        opcode == MVM_OP_sp_p6obind_o;
+                    MVMint32 hypothetical_reg = allocation_tracked(alloc)
+                        ? tracked_attribute_reg(tc, gs, bb, ins, alloc,
                                 is_p6o_op
-                                    ? ins->operands[1].lit_i16
-                                    : ins->operands[1].lit_i16 - (MVMint16)sizeof(MVMObject));
+                                    ? ins->operands[1].lit_i16 + (MVMint32)sizeof(MVMObject)
+                                    : ins->operands[1].lit_i16,
+                                1)
+                        : -1;
+                    if (hypothetical_reg >= 0) {
                         Transformation *tran = MVM_spesh_alloc(tc, g, sizeof(Transformation));
                         tran->allocation = alloc;
                         tran->transform = TRANSFORM_BINDATTR_TO_SET;
@@ -600,13 +772,27 @@ static MVMuint32 analyze(MVMThreadContext *tc, MVMSpeshGraph *g, GraphState *gs)
                 case MVM_OP_sp_p6oget_n:
                 case MVM_OP_sp_p6oget_s:
                 case MVM_OP_sp_p6oget_o:
+                case MVM_OP_sp_p6oget_bi:
                 case MVM_OP_sp_p6ogetvc_o:
-                case MVM_OP_sp_p6ogetvt_o: {
+                case MVM_OP_sp_p6ogetvt_o:
+                case MVM_OP_sp_get_i64:
+                case MVM_OP_sp_get_n:
+                case MVM_OP_sp_get_s:
+                case MVM_OP_sp_get_o: {
                     MVMSpeshFacts *target = MVM_spesh_get_facts(tc, g, ins->operands[1]);
                     MVMSpeshPEAAllocation *alloc = target->pea.allocation;
-                    if (allocation_tracked(alloc)) {
-                        MVMuint16 hypothetical_reg = attribute_offset_to_reg(tc, alloc,
-                                ins->operands[2].lit_i16);
+                    MVMint32 is_p6o_op = opcode != MVM_OP_sp_get_i64 &&
+                        opcode != MVM_OP_sp_get_n &&
+                        opcode != MVM_OP_sp_get_s &&
+                        opcode != MVM_OP_sp_get_o;
+                    MVMint32 hypothetical_reg = allocation_tracked(alloc)
+                        ? tracked_attribute_reg(tc, gs, bb, ins, alloc,
+                                is_p6o_op
+                                    ? ins->operands[2].lit_i16 + (MVMint32)sizeof(MVMObject)
+                                    : ins->operands[2].lit_i16,
+                                0)
+                        : -1;
+                    if (hypothetical_reg >= 0) {
                         Transformation *tran = MVM_spesh_alloc(tc, g, sizeof(Transformation));
                         tran->allocation = alloc;
                         tran->transform = TRANSFORM_GETATTR_TO_SET;
@@ -614,7 +800,7 @@ static MVMuint32 analyze(MVMThreadContext *tc, MVMSpeshGraph *g, GraphState *gs)
                         tran->attr.hypothetical_reg_idx = hypothetical_reg;
                         add_transform_for_bb(tc, gs, bb, tran);
                         if (opcode == MVM_OP_sp_p6oget_o || opcode == MVM_OP_sp_p6ogetvc_o ||
-                                opcode == MVM_OP_sp_p6ogetvt_o) {
+                                opcode == MVM_OP_sp_p6ogetvt_o || opcode == MVM_OP_sp_get_o) {
                             MVMSpeshFacts *tgt_facts = create_shadow_facts_c(tc, gs,
                                     ins->operands[0]);
                             MVMSpeshFacts *src_facts = get_shadow_facts_h(tc, gs,
@@ -671,15 +857,29 @@ static MVMuint32 analyze(MVMThreadContext *tc, MVMSpeshGraph *g, GraphState *gs)
             ins = ins->next;
             ins_count++;
         }
+    }
 
-        seen[bb->rpo_idx] = 1;
+    /* Tracked objects flowing into a loop header PHI through a back edge
+     * were not yet known to be tracked when we saw the PHI; go over such
+     * PHIs again to catch those. */
+    if (gs->has_loops) {
+        for (i = 0; i < g->num_bbs; i++) {
+            MVMSpeshIns *ins = rpo[i]->first_ins;
+            while (ins && ins->info->opcode == MVM_SSA_PHI) {
+                MVMuint16 j;
+                if (ins->info->num_operands != 2)
+                    for (j = 1; j < ins->info->num_operands; j++)
+                        real_object_required(tc, g, ins, ins->operands[j]);
+                ins = ins->next;
+            }
+        }
     }
-    MVM_free(rpo);
-    MVM_free(seen);
+
     return found_replaceable;
 }
 
 void MVM_spesh_pea(MVMThreadContext *tc, MVMSpeshGraph *g) {
+    MVMSpeshBB **rpo;
     MVMuint32 i;
 
     GraphState gs;
@@ -698,15 +898,20 @@ void MVM_spesh_pea(MVMThreadContext *tc, MVMSpeshGraph *g) {
         MVM_free(sf_cuuid);
     }
 
-    if (analyze(tc, g, &gs)) {
-        MVMSpeshBB *bb = g->entry;
+    /* Analyze the graph, then apply the transforms. We apply them in reverse
+     * postorder too, so the register version that a replaced read takes is
+     * always that of a bind in a dominating block. */
+    rpo = MVM_spesh_graph_reverse_postorder(tc, g);
+    if (analyze(tc, g, &gs, rpo)) {
+        MVMuint32 j;
         gs.attr_regs = MVM_spesh_alloc(tc, g, gs.latest_hypothetical_reg_idx * sizeof(MVMuint16));
-        while (bb) {
+        for (j = 0; j < g->num_bbs; j++) {
+            MVMSpeshBB *bb = rpo[j];
             for (i = 0; i < MVM_VECTOR_ELEMS(gs.bb_states[bb->idx].transformations); i++)
                 apply_transform(tc, g, &gs, bb, gs.bb_states[bb->idx].transformations[i]);
-            bb = bb->linear_next;
         }
     }
+    MVM_free(rpo);
 
     for (i = 0; i < g->num_bbs; i++)
         MVM_VECTOR_DESTROY(gs.bb_states[i].transformations);
@@ -1,7 +1,8 @@
 /* Information about an allocation we are tracking in partial escape analysis. */
 struct MVMSpeshPEAAllocation {
-    /* The allocating instruction. */
+    /* The allocating instruction, and the basic block it is in. */
     MVMSpeshIns *allocator;
+    MVMSpeshBB *allocator_bb;
 
     /* The allocated type. */
    MVMObject *type; 
@@ -10,6 +11,11 @@ struct MVMSpeshPEAAllocation {
      * the attributes of this type. */
     MVMuint16 *hypothetical_attr_reg_idxs;
 
+    /* Which attributes have been bound so far during the analysis. In a
+     * graph with loops, reading an attribute that has not been bound would
+     * see the value left in its register by an earlier iteration. */
+    MVMuint8 *bound_attrs;
+
     /* Have we seen something that invalidates our ability to scalar replace
      * this? */
     MVMuint8 irreplaceable;
@@ -53,7 +59,8 @@ struct MVMSpeshPEAMaterializeInfo {
     MVMuint16 num_attr_regs;
 
     /* A list of the registers holding the attributes to put into the
-     * materialized object. */
+     * materialized object. For a box (P6int, P6num, P6str), there is just
+     * the one, holding its value. */
     MVMuint16 *attr_regs;
 };
 
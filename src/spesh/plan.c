@@ -1,15 +1,20 @@
 #include "moar.h"
 
-/* Checks if we have any existing specialization of this. */
-MVMint32 have_existing_specialization(MVMThreadContext *tc, MVMStaticFrame *sf,
-        MVMCallsite *cs, MVMSpeshStatsType *type_tuple) {
+/* Checks if we have any existing specialization of this. A baseline candidate
+ * only counts as an existing certain specialization if we're looking to make
+ * another baseline one. */
+MVMint32 MVM_spesh_plan_have_existing_specialization(MVMThreadContext *tc, MVMStaticFrame *sf,
+        MVMCallsite *cs, MVMSpeshStatsType *type_tuple, MVMint32 baseline) {
     MVMStaticFrameSpesh *sfs = sf->body.spesh;
     MVMuint32 i;
     for (i = 0; i < sfs->body.num_spesh_candidates; i++) {
         if (sfs->body.spesh_candidates[i]->cs == cs) {
             /* Callsite matches. Is it a matching certain specialization? */
             MVMSpeshStatsType *cand_type_tuple = sfs->body.spesh_candidates[i]->type_tuple;
-            if (type_tuple == NULL && cand_type_tuple == NULL) {
+            if (sfs->body.spesh_candidates[i]->is_baseline && !baseline) {
+                /* Doesn't count. */
+            }
+            else if (type_tuple == NULL && cand_type_tuple == NULL) {
                 /* Yes, so we're done. */
                 return 1;
             }
@@ -33,7 +38,8 @@ void add_planned(MVMThreadContext *tc, MVMSpeshPlan *plan, MVMSpeshPlannedKind k
                  MVMuint32 num_type_stats) {
     MVMSpeshPlanned *p;
     if (sf->body.bytecode_size > MVM_SPESH_MAX_BYTECODE_SIZE ||
-        have_existing_specialization(tc, sf, cs_stats->cs, type_tuple)) {
+        MVM_spesh_plan_have_existing_specialization(tc, sf, cs_stats->cs, type_tuple,
+            kind == MVM_SPESH_PLANNED_BASELINE)) {
         /* Clean up allocated memory.
          * NB - the only caller is plan_for_cs, which means that we could do the
          * allocations in here, except that we need the type tuple for the
@@ -247,6 +253,17 @@ void plan_for_sf(MVMThreadContext *tc, MVMSpeshPlan *plan, MVMStaticFrame *sf,
                 plan_for_cs(tc, plan, sf, by_cs, in_certain_specialization, in_observed_specialization, in_osr_specialization);
         }
     }
+    else if (tc->instance->spesh_baseline_enabled && ss->hits >= MVM_SPESH_PLAN_BASELINE_MIN) {
+        /* The frame is warm but not yet hot; JIT-compile the unoptimized
+         * code for the callsites it is being called with, to get rid of the
+         * interpreter overhead until we know enough to specialize it. */
+        MVMuint32 i;
+        for (i = 0; i < ss->num_by_callsite; i++) {
+            MVMSpeshStatsByCallsite *by_cs = &(ss->by_callsite[i]);
+            if (by_cs->cs && by_cs->hits >= MVM_SPESH_PLAN_BASELINE_MIN)
+                add_planned(tc, plan, MVM_SPESH_PLANNED_BASELINE, sf, by_cs, NULL, NULL, 0);
+        }
+    }
 }
 
 /* Maximum stack depth is a decent heuristic for the order to specialize in,
@@ -8,6 +8,11 @@
  * consider. */
 #define MVM_SPESH_PLAN_CS_MIN_OSR   100
 
+/* The minimum number of hits a static frame and interned callsite combination
+ * have to have before a baseline candidate is produced for it, if that is
+ * enabled and the frame isn't yet hot enough to specialize properly. */
+#define MVM_SPESH_PLAN_BASELINE_MIN 30
+
 /* The percentage of hits or OSR hits that a type tuple should receive, out of
  * the total callsite hits, to receive an "observed types" specialization. */
 #define MVM_SPESH_PLAN_TT_OBS_PERCENT       25
@@ -36,7 +41,11 @@ typedef enum {
     /* A specialization based on analysis of various argument types that
      * showed up. This may happen when one argument type is predcitable, but
      * others are not. */
-    MVM_SPESH_PLANNED_DERIVED_TYPES
+    MVM_SPESH_PLANNED_DERIVED_TYPES,
+
+    /* A baseline specialization based only on callsite, which is not
+     * optimized, just JIT-compiled. */
+    MVM_SPESH_PLANNED_BASELINE
 } MVMSpeshPlannedKind;
 
 /* An planned specialization that should be produced. */
@@ -76,3 +85,4 @@ void MVM_spesh_plan_gc_mark(MVMThreadContext *tc, MVMSpeshPlan *plan, MVMGCWorkl
 void MVM_spesh_plan_gc_describe(MVMThreadContext *tc, MVMHeapSnapshotState *ss, MVMSpeshPlan *plan);
 void MVM_spesh_plan_destroy(MVMThreadContext *tc, MVMSpeshPlan *plan);
 MVMSpeshStatsType * MVM_spesh_plan_copy_type_tuple(MVMThreadContext *tc, MVMCallsite *cs, MVMSpeshStatsType *to_copy);
+MVMint32 MVM_spesh_plan_have_existing_specialization(MVMThreadContext *tc, MVMStaticFrame *sf, MVMCallsite *cs, MVMSpeshStatsType *type_tuple, MVMint32 baseline);
@@ -0,0 +1,475 @@
+#include "moar.h"
+#include "platform/io.h"
+
+/* Hex encodes a string's UTF-8 form, so it can go in a statistics file
+ * whatever characters it contains. An empty string is written as "-". */
+static char * hex_of(MVMThreadContext *tc, MVMString *s) {
+    char *utf8 = MVM_string_utf8_encode_C_string(tc, s);
+    size_t len = strlen(utf8);
+    char *hex = MVM_malloc(len * 2 + 2);
+    size_t i;
+    for (i = 0; i < len; i++)
+        snprintf(hex + i * 2, 3, "%02x", (unsigned char)utf8[i]);
+    if (len == 0)
+        strcpy(hex, "-");
+    MVM_free(utf8);
+    return hex;
+}
+
+/* Copies part of a string. */
+static char * copy_chars(const char *from, size_t len) {
+    char *copy = MVM_malloc(len + 1);
+    memcpy(copy, from, len);
+    copy[len] = '\0';
+    return copy;
+}
+
+/* Splits a line off the front of a buffer, terminating it, and returns the
+ * rest of the buffer (or NULL if there is no more). */
+static char * next_line(char *line) {
+    char *end = strchr(line, '\n');
+    if (!end)
+        return NULL;
+    *end = '\0';
+    return end + 1;
+}
+
+/* Reads a preload file, keeping the records in it until the compilation
+ * units they are for get loaded. */
+void MVM_spesh_preload_read(MVMInstance *instance, const char *filename) {
+    FILE *fh = MVM_platform_fopen(filename, "rb");
+    MVMSpeshPreloadRecord record;
+    char *buffer, *line, *next, *stats_start;
+    MVMint32 in_record;
+    long size;
+
+    /* Slurp the file. */
+    if (!fh)
+        return;
+    if (fseek(fh, 0, SEEK_END) != 0 || (size = ftell(fh)) < 0 || fseek(fh, 0, SEEK_SET) != 0) {
+        fclose(fh);
+        return;
+    }
+    buffer = MVM_malloc(size + 1);
+    size = (long)fread(buffer, 1, size, fh);
+    buffer[size] = '\0';
+    fclose(fh);
+
+    /* Make sure it's a statistics file in the format we understand. */
+    next = next_line(buffer);
+    if (strcmp(buffer, MVM_SPESH_PRELOAD_HEADER) != 0) {
+        MVM_free(buffer);
+        return;
+    }
+
+    /* Go through the records. Each starts with a frame line and finishes with
+     * an end line; we keep what's in between as text until we know which
+     * static frame it is for. */
+    in_record = 0;
+    stats_start = NULL;
+    for (line = next; line && *line; line = next) {
+        next = next_line(line);
+        if (strncmp(line, "frame ", 6) == 0) {
+            int cuuid_pos = 0;
+            if (in_record)
+                MVM_free(record.cuuid);
+            in_record = sscanf(line, "frame %"SCNx64" %"SCNu32" %n",
+                &(record.cu_hash), &(record.frame_idx), &cuuid_pos) == 2 && cuuid_pos;
+            if (in_record) {
+                record.cuuid = copy_chars(line + cuuid_pos, strlen(line + cuuid_pos));
+                stats_start = next;
+            }
+        }
+        else if (strcmp(line, "end") == 0 && in_record) {
+            size_t len = line - stats_start;
+            size_t i;
+            record.stats = copy_chars(stats_start, len);
+            for (i = 0; i < len; i++)
+                if (record.stats[i] == '\0')
+                    record.stats[i] = '\n';
+            MVM_VECTOR_PUSH(instance->spesh_preload_records, record);
+            in_record = 0;
+        }
+    }
+    if (in_record)
+        MVM_free(record.cuuid);
+
+    MVM_free(buffer);
+}
+
+/* Called when a compilation unit has been loaded. Hands any statistics
+ * recorded for its frames to them. */
+void MVM_spesh_preload_attach(MVMThreadContext *tc, MVMCompUnit *cu) {
+    MVMInstance *instance = tc->instance;
+    size_t num = MVM_VECTOR_ELEMS(instance->spesh_preload_records);
+    MVMuint64 cu_hash;
+    size_t i;
+
+    /* Even if there's nothing to preload, we need the hash for dumping. */
+    if (!instance->spesh_enabled || (num == 0 && !instance->spesh_stats_dump_fh))
+        return;
+    cu_hash = MVM_spesh_cache_hash(tc, cu);
+
+    for (i = 0; i < num; i++) {
+        MVMSpeshPreloadRecord *record = &(instance->spesh_preload_records[i]);
+        MVMStaticFrame *sf;
+        char *cuuid;
+        MVMint32 matches;
+        if (record->cu_hash != cu_hash || !record->stats || record->frame_idx >= cu->body.orig_frames)
+            continue;
+
+        /* Make sure it's the frame we think it is. */
+        sf = ((MVMCode *)cu->body.coderefs[record->frame_idx])->body.sf;
+        cuuid = hex_of(tc, sf->body.cuuid);
+        matches = strcmp(cuuid, record->cuuid) == 0;
+        MVM_free(cuuid);
+        if (!matches)
+            continue;
+
+        /* If a frame was dumped more than once, the last is the most
+         * complete. */
+        MVM_free(sf->body.spesh_preload);
+        sf->body.spesh_preload = record->stats;
+        record->stats = NULL;
+    }
+}
+
+/* Looks for the interned callsite described in a statistics file. */
+static MVMCallsite * find_callsite(MVMThreadContext *tc, MVMuint32 num_pos,
+        const char *flags_hex, const char *names) {
+    MVMCallsiteInterns *interns = tc->instance->callsite_interns;
+    MVMCallsiteEntry flags[MVM_INTERN_ARITY_LIMIT];
+    size_t flag_count = strlen(flags_hex) / 2;
+    MVMCallsite *found = NULL;
+    MVMint32 i;
+    size_t j;
+
+    if (strcmp(flags_hex, "-") == 0)
+        flag_count = 0;
+    else if (strlen(flags_hex) % 2 != 0 || flag_count >= MVM_INTERN_ARITY_LIMIT)
+        return NULL;
+    for (j = 0; j < flag_count; j++) {
+        unsigned int flag;
+        if (sscanf(flags_hex + j * 2, "%2x", &flag) != 1)
+            return NULL;
+        flags[j] = (MVMCallsiteEntry)flag;
+    }
+
+    uv_mutex_lock(&tc->instance->mutex_callsite_interns);
+    for (i = 0; i < interns->num_by_arity[flag_count] && !found; i++) {
+        MVMCallsite *cs = interns->by_arity[flag_count][i];
+        MVMuint16 num_nameds, k;
+        const char *name;
+        if (cs->num_pos != num_pos || (flag_count && memcmp(cs->arg_flags, flags, flag_count) != 0))
+            continue;
+
+        /* The names are a comma-separated list, or "-" if there are none. */
+        num_nameds = MVM_callsite_num_nameds(tc, cs);
+        name = strcmp(names, "-") == 0 ? "" : names;
+        for (k = 0; k < num_nameds; k++) {
+            const char *name_end = strchr(name, ',');
+            size_t name_len = name_end ? (size_t)(name_end - name) : strlen(name);
+            char *hex = hex_of(tc, cs->arg_names[k]);
+            MVMint32 matches = strlen(hex) == name_len && strncmp(hex, name, name_len) == 0;
+            MVM_free(hex);
+            if (!matches)
+                break;
+            name += name_len + (name_end ? 1 : 0);
+        }
+        if (k == num_nameds && *name == '\0')
+            found = cs;
+    }
+    uv_mutex_unlock(&tc->instance->mutex_callsite_interns);
+
+    return found;
+}
+
+/* Looks up a type referred to in a statistics file by SC handle and index.
+ * Sets *type to NULL for "-". Returns zero if the type can't be found (for
+ * example, because its SC isn't loaded). This does not allocate, so the type
+ * can't move before it is stored. */
+static MVMint32 find_type(MVMThreadContext *tc, const char *ref, size_t ref_len, MVMObject **type) {
+    MVMInstance *instance = tc->instance;
+    const char *dot;
+    MVMuint32 i;
+    MVMint64 idx;
+
+    *type = NULL;
+    if (ref_len == 1 && ref[0] == '-')
+        return 1;
+    dot = memchr(ref, '.', ref_len);
+    if (!dot)
+        return 0;
+    idx = strtoll(dot + 1, NULL, 10);
+
+    /* The list of all SCs may be read without holding the registry lock. */
+    for (i = 1; i < instance->all_scs_next_idx; i++) {
+        MVMSerializationContextBody *scb = instance->all_scs[i];
+        char *hex;
+        MVMint32 matches;
+        if (!scb || !scb->sc)
+            continue;
+        hex = hex_of(tc, scb->handle);
+        matches = strlen(hex) == (size_t)(dot - ref) && strncmp(hex, ref, dot - ref) == 0;
+        MVM_free(hex);
+        if (matches) {
+            if (!MVM_sc_is_object_immediately_available(tc, scb->sc, idx))
+                return 0;
+            *type = scb->sc->body->root_objects[idx];
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* Adds the by-callsite statistics described by a line of a statistics file.
+ * Returns the index of the entry, or -1 if the callsite can't be found. */
+static MVMint32 seed_callsite(MVMThreadContext *tc, MVMSpeshStats *ss, char *line) {
+    MVMSpeshStatsByCallsite *css;
+    MVMCallsite *cs = NULL;
+    MVMuint32 hits, osr_hits, max_depth, num_pos;
+    char flags_hex[MVM_INTERN_ARITY_LIMIT * 2 + 1];
+    char names[1024];
+    int pos = 0;
+    MVMuint32 idx;
+
+    if (sscanf(line, "%"SCNu32" %"SCNu32" %"SCNu32" %n", &hits, &osr_hits, &max_depth, &pos) != 3 || !pos)
+        return -1;
+    if (strcmp(line + pos, "-") != 0) {
+        if (strlen(line + pos) >= sizeof(names))
+            return -1;
+        if (sscanf(line + pos, "%"SCNu32" %16s %1023s", &num_pos, flags_hex, names) != 3)
+            return -1;
+        cs = find_callsite(tc, num_pos, flags_hex, names);
+        if (!cs)
+            return -1;
+    }
+
+    idx = ss->num_by_callsite++;
+    ss->by_callsite = MVM_realloc(ss->by_callsite,
+        ss->num_by_callsite * sizeof(MVMSpeshStatsByCallsite));
+    css = &(ss->by_callsite[idx]);
+    memset(css, 0, sizeof(MVMSpeshStatsByCallsite));
+    css->cs = cs;
+    css->hits = hits;
+    css->osr_hits = osr_hits;
+    css->max_depth = max_depth;
+    ss->hits += hits;
+    ss->osr_hits += osr_hits;
+    return (MVMint32)idx;
+}
+
+/* Adds the by-type statistics described by a line of a statistics file, if
+ * all of the types in it can be found. */
+static void seed_type(MVMThreadContext *tc, MVMStaticFrame *sf, MVMSpeshStats *ss,
+        MVMuint32 callsite_idx, char *line) {
+    MVMSpeshStatsByCallsite *css = &(ss->by_callsite[callsite_idx]);
+    MVMCallsite *cs = css->cs;
+    MVMSpeshStatsType *arg_types;
+    MVMSpeshStatsByType *tss;
+    MVMuint32 hits, osr_hits, max_depth, i;
+    int pos = 0;
+    char *slot;
+
+    if (!cs)
+        return;
+    if (sscanf(line, "%"SCNu32" %"SCNu32" %"SCNu32"%n", &hits, &osr_hits, &max_depth, &pos) != 3 || !pos)
+        return;
+
+    /* Each slot is "-" for a non-object argument, or the type, the decont
+     * type, and the concreteness and rw flags, separated by slashes. */
+    arg_types = MVM_calloc(cs->flag_count ? cs->flag_count : 1, sizeof(MVMSpeshStatsType));
+    slot = line + pos;
+    for (i = 0; i < cs->flag_count; i++) {
+        char *type_end, *decont_end;
+        size_t slot_len;
+        MVMObject *type, *decont_type;
+        if (*slot != ' ')
+            goto fail;
+        slot++;
+        slot_len = strcspn(slot, " ");
+        if (!(cs->arg_flags[i] & MVM_CALLSITE_ARG_OBJ)) {
+            if (slot_len != 1 || *slot != '-')
+                goto fail;
+            slot += slot_len;
+            continue;
+        }
+        type_end = memchr(slot, '/', slot_len);
+        if (!type_end)
+            goto fail;
+        decont_end = memchr(type_end + 1, '/', slot_len - (type_end + 1 - slot));
+        if (!decont_end || slot + slot_len - (decont_end + 1) != 3)
+            goto fail;
+        if (!find_type(tc, slot, type_end - slot, &type) || !type)
+            goto fail;
+        if (!find_type(tc, type_end + 1, decont_end - (type_end + 1), &decont_type))
+            goto fail;
+        MVM_ASSIGN_REF(tc, &(sf->body.spesh->common.header), arg_types[i].type, type);
+        MVM_ASSIGN_REF(tc, &(sf->body.spesh->common.header), arg_types[i].decont_type, decont_type);
+        arg_types[i].type_concrete        = decont_end[1] == '1';
+        arg_types[i].decont_type_concrete = decont_end[2] == '1';
+        arg_types[i].rw_cont              = decont_end[3] == '1';
+        slot += slot_len;
+    }
+
+    css->by_type = MVM_realloc(css->by_type,
+        (css->num_by_type + 1) * sizeof(MVMSpeshStatsByType));
+    tss = &(css->by_type[css->num_by_type++]);
+    memset(tss, 0, sizeof(MVMSpeshStatsByType));
+    tss->arg_types = arg_types;
+    tss->hits = hits;
+    tss->osr_hits = osr_hits;
+    tss->max_depth = max_depth;
+    return;
+
+  fail:
+    MVM_free(arg_types);
+}
+
+/* Seeds a static frame's newly created statistics with those recorded for it
+ * in an earlier run. Called by the specialization worker. */
+void MVM_spesh_preload_seed(MVMThreadContext *tc, MVMStaticFrame *sf, MVMSpeshStats *ss) {
+    char *stats = sf->body.spesh_preload;
+    char *line, *next;
+    MVMint32 callsite_idx = -1;
+    sf->body.spesh_preload = NULL;
+    for (line = stats; line && *line; line = next) {
+        next = next_line(line);
+        if (strncmp(line, "cs ", 3) == 0)
+            callsite_idx = seed_callsite(tc, ss, line + 3);
+        else if (strncmp(line, "type ", 5) == 0 && callsite_idx >= 0)
+            seed_type(tc, sf, ss, callsite_idx, line + 5);
+    }
+    MVM_free(stats);
+}
+
+/* Checks if a type can be referred to in a statistics file, which it can if
+ * it lives in an SC. */
+static MVMint32 can_refer_to(MVMThreadContext *tc, MVMObject *type) {
+    MVMSerializationContext *sc;
+    MVMuint32 idx;
+    if (!type)
+        return 1;
+    if (MVM_sc_get_idx_of_sc(&type->header) == 0)
+        return 0;
+    sc = MVM_sc_get_obj_sc(tc, type);
+    idx = MVM_sc_get_idx_in_sc(&type->header);
+    return sc && idx < sc->body->num_objects && sc->body->root_objects[idx] == type;
+}
+
+/* Writes a reference to a type, by SC handle and index. */
+static void write_type_ref(MVMThreadContext *tc, FILE *fh, MVMObject *type) {
+    if (type) {
+        char *handle = hex_of(tc, MVM_sc_get_handle(tc, MVM_sc_get_obj_sc(tc, type)));
+        fprintf(fh, "%s.%"PRIu32, handle, MVM_sc_get_idx_in_sc(&type->header));
+        MVM_free(handle);
+    }
+    else {
+        fputc('-', fh);
+    }
+}
+
+/* Writes the statistics for a type tuple, provided all of the types in it
+ * can be referred to. */
+static void dump_type(MVMThreadContext *tc, FILE *fh, MVMCallsite *cs, MVMSpeshStatsByType *tss) {
+    MVMuint32 i;
+    for (i = 0; i < cs->flag_count; i++)
+        if (cs->arg_flags[i] & MVM_CALLSITE_ARG_OBJ)
+            if (!tss->arg_types[i].type || !can_refer_to(tc, tss->arg_types[i].type)
+                    || !can_refer_to(tc, tss->arg_types[i].decont_type))
+                return;
+    fprintf(fh, "type %"PRIu32" %"PRIu32" %"PRIu32, tss->hits, tss->osr_hits, tss->max_depth);
+    for (i = 0; i < cs->flag_count; i++) {
+        MVMSpeshStatsType *type = &(tss->arg_types[i]);
+        fputc(' ', fh);
+        if (cs->arg_flags[i] & MVM_CALLSITE_ARG_OBJ) {
+            write_type_ref(tc, fh, type->type);
+            fputc('/', fh);
+            write_type_ref(tc, fh, type->decont_type);
+            fprintf(fh, "/%d%d%d", type->type_concrete ? 1 : 0,
+                type->decont_type_concrete ? 1 : 0, type->rw_cont ? 1 : 0);
+        }
+        else {
+            fputc('-', fh);
+        }
+    }
+    fputc('\n', fh);
+}
+
+/* Writes the statistics for a callsite, followed by those for each of its
+ * type tuples. */
+static void dump_callsite(MVMThreadContext *tc, FILE *fh, MVMSpeshStatsByCallsite *css) {
+    MVMCallsite *cs = css->cs;
+    MVMuint32 i;
+    fprintf(fh, "cs %"PRIu32" %"PRIu32" %"PRIu32" ", css->hits, css->osr_hits, css->max_depth);
+    if (!cs) {
+        fprintf(fh, "-\n");
+        return;
+    }
+    fprintf(fh, "%"PRIu16" ", cs->num_pos);
+    if (cs->flag_count == 0)
+        fputc('-', fh);
+    for (i = 0; i < cs->flag_count; i++)
+        fprintf(fh, "%02x", cs->arg_flags[i]);
+    fputc(' ', fh);
+    if (MVM_callsite_num_nameds(tc, cs) == 0)
+        fputc('-', fh);
+    for (i = 0; i < MVM_callsite_num_nameds(tc, cs); i++) {
+        char *name = hex_of(tc, cs->arg_names[i]);
+        fprintf(fh, i ? ",%s" : "%s", name);
+        MVM_free(name);
+    }
+    fputc('\n', fh);
+    for (i = 0; i < css->num_by_type; i++)
+        dump_type(tc, fh, cs, &(css->by_type[i]));
+}
+
+/* Writes the statistics of a static frame. */
+static void dump_frame(MVMThreadContext *tc, FILE *fh, MVMStaticFrame *sf) {
+    MVMSpeshStats *ss = sf->body.spesh->body.spesh_stats;
+    MVMCompUnit *cu = sf->body.cu;
+    MVMint64 idx;
+    char *cuuid;
+    MVMuint32 i;
+    if (!ss || !cu->body.spesh_cache_hash)
+        return;
+    idx = MVM_spesh_cache_frame_index(tc, sf);
+    if (idx < 0)
+        return;
+    cuuid = hex_of(tc, sf->body.cuuid);
+    fprintf(fh, "frame %016"PRIx64" %"PRIi64" %s\n", cu->body.spesh_cache_hash, idx, cuuid);
+    MVM_free(cuuid);
+    for (i = 0; i < ss->num_by_callsite; i++)
+        dump_callsite(tc, fh, &(ss->by_callsite[i]));
+    fprintf(fh, "end\n");
+}
+
+/* Writes the statistics of each frame in a specialization plan to the dump
+ * file. Called by the specialization worker while it holds the statistics
+ * lock for writing. */
+void MVM_spesh_preload_dump_plan(MVMThreadContext *tc, MVMSpeshPlan *plan) {
+    FILE *fh = tc->instance->spesh_stats_dump_fh;
+    MVMuint32 i, j;
+    for (i = 0; i < plan->num_planned; i++) {
+        MVMStaticFrame *sf = plan->planned[i].sf;
+        for (j = 0; j < i; j++)
+            if (plan->planned[j].sf == sf)
+                break;
+        if (j == i)
+            dump_frame(tc, fh, sf);
+    }
+    fflush(fh);
+}
+
+/* Frees the memory associated with preloading. */
+void MVM_spesh_preload_destroy(MVMInstance *instance) {
+    size_t i;
+    for (i = 0; i < MVM_VECTOR_ELEMS(instance->spesh_preload_records); i++) {
+        MVM_free(instance->spesh_preload_records[i].cuuid);
+        MVM_free(instance->spesh_preload_records[i].stats);
+    }
+    MVM_VECTOR_DESTROY(instance->spesh_preload_records);
+    if (instance->spesh_stats_dump_fh)
+        fclose(instance->spesh_stats_dump_fh);
+    instance->spesh_stats_dump_fh = NULL;
+}
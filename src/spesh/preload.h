@@ -0,0 +1,41 @@
+/* Statistics preloading lets a run start out with the statistics that an
+ * earlier run gathered, so frames are specialized the first time they show
+ * up in a log rather than after MVM_spesh_threshold calls. When a dump file
+ * is configured, the worker writes out the callsite and type tuple
+ * statistics of each frame it plans specializations for. When a preload file
+ * is given, those statistics are attached to the matching frames as their
+ * compilation units are loaded, and used to seed their statistics when they
+ * are first logged.
+ *
+ * Frames are identified by the hash of their compilation unit's bytecode
+ * and their index in it, and types by their serialization context handle
+ * and index in it; statistics involving anything else can't be carried
+ * over, and are left out. Only the hit counts and type tuples are carried
+ * over, not what was logged at each bytecode offset; that is gathered in
+ * the new run as usual. */
+
+/* The first line of a statistics file; bump the version if the format
+ * changes. */
+#define MVM_SPESH_PRELOAD_HEADER "MoarVM spesh stats 1"
+
+/* The statistics recorded for a frame, read from a preload file. */
+struct MVMSpeshPreloadRecord {
+    /* The hash of the bytecode of the frame's compilation unit. */
+    MVMuint64 cu_hash;
+
+    /* The index of the frame in the compilation unit. */
+    MVMuint32 frame_idx;
+
+    /* The frame's compilation unit unique ID, hex encoded. */
+    char *cuuid;
+
+    /* The callsite and type lines of the record. Moved to the static frame
+     * once it is found. */
+    char *stats;
+};
+
+void MVM_spesh_preload_read(MVMInstance *instance, const char *filename);
+void MVM_spesh_preload_attach(MVMThreadContext *tc, MVMCompUnit *cu);
+void MVM_spesh_preload_seed(MVMThreadContext *tc, MVMStaticFrame *sf, MVMSpeshStats *ss);
+void MVM_spesh_preload_dump_plan(MVMThreadContext *tc, MVMSpeshPlan *plan);
+void MVM_spesh_preload_destroy(MVMInstance *instance);
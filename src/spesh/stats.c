@@ -3,8 +3,11 @@
 /* Gets the statistics for a static frame, creating them if needed. */
 MVMSpeshStats * stats_for(MVMThreadContext *tc, MVMStaticFrame *sf) {
     MVMStaticFrameSpesh *spesh = sf->body.spesh;
-    if (!spesh->body.spesh_stats)
+    if (!spesh->body.spesh_stats) {
         spesh->body.spesh_stats = MVM_calloc(1, sizeof(MVMSpeshStats));
+        if (sf->body.spesh_preload)
+            MVM_spesh_preload_seed(tc, sf, spesh->body.spesh_stats);
+    }
     return spesh->body.spesh_stats;
 }
 
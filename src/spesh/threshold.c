@@ -6,6 +6,11 @@ MVMuint32 MVM_spesh_threshold(MVMThreadContext *tc, MVMStaticFrame *sf) {
     MVMuint32 bs = sf->body.bytecode_size;
     if (tc->instance->spesh_nodelay)
         return 1;
+    /* Frames the specialization cache saw get hot in an earlier run are
+     * planned after a few calls, from statistics gathered in this run (or
+     * seeded by a statistics preload). */
+    if (sf->body.spesh_cache_hot)
+        return MVM_SPESH_CACHE_THRESHOLD;
     if (bs <= 2048)
         return 150;
     else if (bs <= 8192)
@@ -1,8 +1,56 @@
 #include "moar.h"
 
-/* The specialization worker thread receives logs from other threads about
- * calls and types that showed up at runtime. It uses this to produce
- * specialized versions of code. */
+/* The specialization worker threads receive logs from other threads about
+ * calls and types that showed up at runtime. They use these to produce
+ * specialized versions of code.
+ *
+ * There may be several workers. The statistics model is shared between them,
+ * and the stack simulation carries over from one log to the next, so logs
+ * are applied to the statistics one at a time, in the order they were sent,
+ * under the write side of the statistics lock. The worker that applied a log
+ * also plans what to specialize from it. Producing the specializations is
+ * where the time goes, and many workers can do it at once, holding the read
+ * side of the lock so the statistics the plan points into stay put. The
+ * write side is downgraded to the read side without letting go of it, since
+ * another worker updating the statistics in between could move or free the
+ * parts of them that the plan points into. */
+
+/* Takes a lock, marking the thread as blocked while waiting for it so as not
+ * to hold up GC. */
+static void lock_intake(MVMThreadContext *tc) {
+    MVM_gc_mark_thread_blocked(tc);
+    uv_mutex_lock(&(tc->instance->mutex_spesh_intake));
+    MVM_gc_mark_thread_unblocked(tc);
+}
+static void lock_stats_for_update(MVMThreadContext *tc) {
+    MVMInstance *instance = tc->instance;
+    MVM_gc_mark_thread_blocked(tc);
+    uv_mutex_lock(&(instance->mutex_spesh_stats));
+    while (instance->spesh_stats_writing || instance->spesh_stats_readers)
+        uv_cond_wait(&(instance->cond_spesh_stats), &(instance->mutex_spesh_stats));
+    instance->spesh_stats_writing = 1;
+    uv_mutex_unlock(&(instance->mutex_spesh_stats));
+    MVM_gc_mark_thread_unblocked(tc);
+}
+
+/* Turns holding the statistics lock for writing into holding it for
+ * reading. */
+static void downgrade_stats_lock(MVMThreadContext *tc) {
+    MVMInstance *instance = tc->instance;
+    uv_mutex_lock(&(instance->mutex_spesh_stats));
+    instance->spesh_stats_writing = 0;
+    instance->spesh_stats_readers++;
+    uv_mutex_unlock(&(instance->mutex_spesh_stats));
+}
+
+/* Lets go of the statistics lock held for reading. */
+static void unlock_stats(MVMThreadContext *tc) {
+    MVMInstance *instance = tc->instance;
+    uv_mutex_lock(&(instance->mutex_spesh_stats));
+    if (--instance->spesh_stats_readers == 0)
+        uv_cond_broadcast(&(instance->cond_spesh_stats));
+    uv_mutex_unlock(&(instance->mutex_spesh_stats));
+}
 
 /* Enters the work loop. */
 static void worker(MVMThreadContext *tc, MVMCallsite *callsite, MVMRegister *args) {
@@ -15,8 +63,6 @@ static void worker(MVMThreadContext *tc, MVMCallsite *callsite, MVMRegister *arg
             tc->instance->boot_types.BOOTArray);
     });
 
-    tc->instance->speshworker_thread_id = tc->thread_obj->body.thread_id;
-
     MVMROOT2(tc, updated_static_frames, previous_static_frames, {
         while (1) {
             MVMObject *log_obj;
@@ -28,8 +74,20 @@ static void worker(MVMThreadContext *tc, MVMCallsite *callsite, MVMRegister *arg
 
             MVMObject *spesh_overview_event = NULL;
 
+            /* Take the next log. We keep hold of the intake lock until we
+             * have the statistics lock, so another worker can't get in ahead
+             * of us with a later log. */
             start_time = uv_hrtime();
+            lock_intake(tc);
             log_obj = MVM_repr_shift_o(tc, tc->instance->spesh_queue);
+            if (MVM_is_null(tc, log_obj)) {
+                /* This is a stop signal, so quit processing */
+                uv_mutex_unlock(&(tc->instance->mutex_spesh_intake));
+                break;
+            }
+            else if (log_obj->st->REPR->ID != MVM_REPR_ID_MVMSpeshLog) {
+                MVM_panic(1, "Unexpected object sent to specialization worker");
+            }
             if (MVM_spesh_debug_enabled(tc)) {
                 MVM_spesh_debug_printf(tc,
                     "Received Logs\n"
@@ -65,11 +123,10 @@ static void worker(MVMThreadContext *tc, MVMCallsite *callsite, MVMRegister *arg
             interval_id = MVM_telemetry_interval_start(tc, "spesh worker consuming a log");
 
             uv_mutex_lock(&(tc->instance->mutex_spesh_sync));
-            tc->instance->spesh_working = 1;
+            tc->instance->spesh_working++;
             uv_mutex_unlock(&(tc->instance->mutex_spesh_sync));
 
-            tc->instance->spesh_stats_version++;
-            if (log_obj->st->REPR->ID == MVM_REPR_ID_MVMSpeshLog) {
+            {
                 MVMSpeshLog *sl = (MVMSpeshLog *)log_obj;
                 MVM_telemetry_interval_annotate((uintptr_t)sl->body.thread->body.tc, interval_id, "from this thread");
                 if (overview_data) {
@@ -86,8 +143,11 @@ static void worker(MVMThreadContext *tc, MVMCallsite *callsite, MVMRegister *arg
                     MVMuint64 observed_spesh;
                     MVMuint64 osr_spesh;
 
+                    lock_stats_for_update(tc);
+                    uv_mutex_unlock(&(tc->instance->mutex_spesh_intake));
+
                     /* Update stats, and if we're logging dump each of them. */
-                    tc->instance->spesh_stats_version++;
+                    tc->instance->spesh_stats_version += 2;
                     start_time = uv_hrtime();
                     MVM_spesh_stats_update(tc, sl, updated_static_frames, &newly_seen, &updated);
                     n = MVM_repr_elems(tc, updated_static_frames);
@@ -114,9 +174,9 @@ static void worker(MVMThreadContext *tc, MVMCallsite *callsite, MVMRegister *arg
 
                     /* Form a specialization plan. */
                     start_time = uv_hrtime();
-                    tc->instance->spesh_plan = MVM_spesh_plan(tc, updated_static_frames, &certain_spesh, &observed_spesh, &osr_spesh);
+                    tc->spesh_plan = MVM_spesh_plan(tc, updated_static_frames, &certain_spesh, &observed_spesh, &osr_spesh);
                     if (MVM_spesh_debug_enabled(tc)) {
-                        n = tc->instance->spesh_plan->num_planned;
+                        n = tc->spesh_plan->num_planned;
                         MVM_spesh_debug_printf(tc,
                             "Specialization Plan\n"
                             "===================\n"
@@ -124,7 +184,7 @@ static void worker(MVMThreadContext *tc, MVMCallsite *callsite, MVMRegister *arg
                             n, (int)((uv_hrtime() - start_time) / 1000));
                         for (i = 0; i < n; i++) {
                             char *dump = MVM_spesh_dump_planned(tc,
-                                &(tc->instance->spesh_plan->planned[i]));
+                                &(tc->spesh_plan->planned[i]));
                             MVM_spesh_debug_printf(tc, "%s==========\n\n", dump);
                             MVM_free(dump);
                         }
@@ -137,28 +197,19 @@ static void worker(MVMThreadContext *tc, MVMCallsite *callsite, MVMRegister *arg
                         overview_data[11] = osr_spesh;
                     }
 
-                    MVM_telemetry_interval_annotate((uintptr_t)tc->instance->spesh_plan->num_planned, interval_id,
+                    /* If we're dumping statistics for later runs, write out
+                     * those of the frames we're about to specialize. */
+                    if (tc->instance->spesh_stats_dump_fh)
+                        MVM_spesh_preload_dump_plan(tc, tc->spesh_plan);
+
+                    MVM_telemetry_interval_annotate((uintptr_t)tc->spesh_plan->num_planned, interval_id,
                             "this many specializations planned");
                     GC_SYNC_POINT(tc);
 
-                    start_time = uv_hrtime();
-
-                    /* Implement the plan and then discard it. */
-                    n = tc->instance->spesh_plan->num_planned;
-                    for (i = 0; i < n; i++) {
-                        MVM_spesh_candidate_add(tc, &(tc->instance->spesh_plan->planned[i]));
-                        GC_SYNC_POINT(tc);
-                    }
-                    MVM_spesh_plan_destroy(tc, tc->instance->spesh_plan);
-                    tc->instance->spesh_plan = NULL;
-
-                    if (overview_data) {
-                        overview_data[12] = (uv_hrtime() - start_time) / 1000;
-                    }
-
                     /* Clear up stats that didn't get updated for a while,
                      * then add frames updated this time into the previously
-                     * updated array. */
+                     * updated array. The frames in the plan were all just
+                     * updated, so their stats survive this. */
                     MVM_spesh_stats_cleanup(tc, previous_static_frames);
                     n = MVM_repr_elems(tc, updated_static_frames);
                     for (i = 0; i < n; i++)
@@ -172,6 +223,27 @@ static void worker(MVMThreadContext *tc, MVMCallsite *callsite, MVMRegister *arg
                     /* Clear updated static frames array. */
                     MVM_repr_pos_set_elems(tc, updated_static_frames, 0);
 
+                    /* Let other workers specialize alongside us, but keep
+                     * the statistics from changing while we implement the
+                     * plan. */
+                    downgrade_stats_lock(tc);
+
+                    start_time = uv_hrtime();
+
+                    /* Implement the plan and then discard it. */
+                    n = tc->spesh_plan->num_planned;
+                    for (i = 0; i < n; i++) {
+                        MVM_spesh_candidate_add(tc, &(tc->spesh_plan->planned[i]));
+                        GC_SYNC_POINT(tc);
+                    }
+                    MVM_spesh_plan_destroy(tc, tc->spesh_plan);
+                    tc->spesh_plan = NULL;
+                    unlock_stats(tc);
+
+                    if (overview_data) {
+                        overview_data[12] = (uv_hrtime() - start_time) / 1000;
+                    }
+
                     /* Allow the sending thread to produce more logs again,
                      * putting a new spesh log in place if needed. */
                     stc = sl->body.thread->body.tc;
@@ -200,13 +272,6 @@ static void worker(MVMThreadContext *tc, MVMCallsite *callsite, MVMRegister *arg
                         MVM_free(entries);
                     }
                 });
-
-            }
-            else if (MVM_is_null(tc, log_obj)) {
-                /* This is a stop signal, so quit processing */
-                break;
-            } else {
-                MVM_panic(1, "Unexpected object sent to specialization worker");
             }
 
             MVM_telemetry_interval_stop(tc, interval_id, "spesh worker finished");
@@ -229,8 +294,8 @@ static void worker(MVMThreadContext *tc, MVMCallsite *callsite, MVMRegister *arg
                 MVM_profiler_log_spesh_end(tc);
 
             uv_mutex_lock(&(tc->instance->mutex_spesh_sync));
-            tc->instance->spesh_working = 0;
-            uv_cond_broadcast(&(tc->instance->cond_spesh_sync));
+            if (--tc->instance->spesh_working == 0)
+                uv_cond_broadcast(&(tc->instance->cond_spesh_sync));
             uv_mutex_unlock(&(tc->instance->mutex_spesh_sync));
 
             work_sequence_number++;
@@ -241,35 +306,62 @@ static void worker(MVMThreadContext *tc, MVMCallsite *callsite, MVMRegister *arg
 /* Not thread safe per instance, but normally only used when instance is still
  * single-threaded */
 void MVM_spesh_worker_start(MVMThreadContext *tc) {
-    MVMObject *worker_entry_point;
-    if (tc->instance->spesh_enabled) {
+    MVMInstance *instance = tc->instance;
+    if (instance->spesh_enabled) {
+        MVMuint32 i;
+
+        if (!instance->spesh_threads) {
+            instance->spesh_threads = MVM_calloc(instance->spesh_workers, sizeof(MVMObject *));
+            instance->speshworker_thread_ids = MVM_calloc(instance->spesh_workers, sizeof(MVMuint32));
+        }
+
+        /* If we restart the workers, do not reinitialize the queue */
+        if (!instance->spesh_queue)
+            instance->spesh_queue = MVM_repr_alloc_init(tc, instance->boot_types.BOOTQueue);
 
-        /* There must not be a running thread now */
-        assert(tc->instance->spesh_thread == NULL);
+        for (i = 0; i < instance->spesh_workers; i++) {
+            MVMObject *worker_entry_point;
 
-        /* If we restart the worker, do not reinitialize the queue */
-        if (!tc->instance->spesh_queue)
-            tc->instance->spesh_queue = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTQueue);
-        worker_entry_point = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTCCode);
-        ((MVMCFunction *)worker_entry_point)->body.func = worker;
+            /* There must not be a running thread now */
+            assert(instance->spesh_threads[i] == NULL);
 
-        tc->instance->spesh_thread = MVM_thread_new(tc, worker_entry_point, 1);
-        MVM_thread_run(tc, tc->instance->spesh_thread);
+            worker_entry_point = MVM_repr_alloc_init(tc, instance->boot_types.BOOTCCode);
+            ((MVMCFunction *)worker_entry_point)->body.func = worker;
+            instance->spesh_threads[i] = MVM_thread_new(tc, worker_entry_point, 1);
+            instance->speshworker_thread_ids[i] =
+                ((MVMThread *)instance->spesh_threads[i])->body.thread_id;
+            MVM_thread_run(tc, instance->spesh_threads[i]);
+        }
     }
 }
 
 void MVM_spesh_worker_stop(MVMThreadContext *tc) {
-    /* Send stop sentinel */
+    /* Send a stop sentinel to each worker */
     if (tc->instance->spesh_enabled) {
-        MVM_repr_unshift_o(tc, tc->instance->spesh_queue, tc->instance->VMNull);
+        MVMuint32 i;
+        for (i = 0; i < tc->instance->spesh_workers; i++)
+            MVM_repr_unshift_o(tc, tc->instance->spesh_queue, tc->instance->VMNull);
     }
 }
 
 void MVM_spesh_worker_join(MVMThreadContext *tc) {
-    /* Join thread */
+    /* Join threads */
     if (tc->instance->spesh_enabled) {
-        assert(tc->instance->spesh_thread != NULL);
-        MVM_thread_join(tc, tc->instance->spesh_thread);
-        tc->instance->spesh_thread = NULL;
+        MVMuint32 i;
+        for (i = 0; i < tc->instance->spesh_workers; i++) {
+            assert(tc->instance->spesh_threads[i] != NULL);
+            MVM_thread_join(tc, tc->instance->spesh_threads[i]);
+            tc->instance->spesh_threads[i] = NULL;
+        }
     }
 }
+
+/* Checks if the thread with the specified ID is a specialization worker. */
+MVMint32 MVM_spesh_worker_is_worker_thread(MVMInstance *instance, MVMuint32 thread_id) {
+    MVMuint32 i;
+    if (instance->speshworker_thread_ids)
+        for (i = 0; i < instance->spesh_workers; i++)
+            if (instance->speshworker_thread_ids[i] == thread_id)
+                return 1;
+    return 0;
+}
@@ -1,4 +1,11 @@
+/* The number of specialization worker threads to run, unless configured
+ * otherwise. */
+#define MVM_SPESH_WORKERS_DEFAULT 1
+
+/* The most specialization workers we will run. */
+#define MVM_SPESH_WORKERS_MAX 64
+
 void MVM_spesh_worker_start(MVMThreadContext *tc);
 void MVM_spesh_worker_stop(MVMThreadContext *tc);
 void MVM_spesh_worker_join(MVMThreadContext *tc);
-
+MVMint32 MVM_spesh_worker_is_worker_thread(MVMInstance *instance, MVMuint32 thread_id);
@@ -146,6 +146,7 @@ char * MVM_string_latin1_encode_substr(MVMThreadContext *tc, MVMString *str, MVM
     size_t result_alloc;
     MVMuint8 *repl_bytes = NULL;
     MVMuint64 repl_length;
+    const MVMGrapheme8 *ascii;
 
     /* must check start first since it's used in the length check */
     if (start < 0 || start > strgraphs)
@@ -159,9 +160,10 @@ char * MVM_string_latin1_encode_substr(MVMThreadContext *tc, MVMString *str, MVM
 
     result_alloc = lengthu;
     result = MVM_malloc(result_alloc + 1);
-    if (str->body.storage_type == MVM_STRING_GRAPHEME_ASCII) {
+    ascii = MVM_string_plain_ascii_range(tc, str, start, lengthu, translate_newlines);
+    if (ascii) {
         /* No encoding needed; directly copy. */
-        memcpy(result, str->body.storage.blob_ascii, lengthu);
+        memcpy(result, ascii, lengthu);
         result[lengthu] = 0;
         if (output_size)
             *output_size = lengthu;
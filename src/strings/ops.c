@@ -541,22 +541,220 @@ static MVMint64 MVM_string_memmem_grapheme32 (MVMThreadContext *tc, MVMGrapheme3
     MVMGrapheme32 * rtrn = memmem_uint32(H_blob32 + H_start, H_graphs - H_start, n_blob32, n_graphs);
     return rtrn == NULL ? -1 : rtrn - H_blob32;
 }
-static MVMint64 MVM_string_memmem_grapheme32str (MVMThreadContext *tc, MVMString *Haystack, MVMString *needle, MVMint64 H_start, MVMStringIndex H_graphs, MVMStringIndex n_graphs) {
-    MVMGrapheme32 *needle_buf = NULL;
-    MVMint64 rtrn;
-    if (needle->body.storage_type != MVM_STRING_GRAPHEME_32) {
-        MVMStringIndex i;
+/* Needles of up to this many graphemes are searched for by filtering on their
+ * first and last graphemes; longer ones use two-way string matching, whose
+ * running time doesn't depend on how many positions get past such a filter. */
+#define MVM_STRING_INDEX_FILTER_MAX_NEEDLE 32
+/* How many positions the filter checks at a time. */
+#define MVM_STRING_INDEX_FILTER_BLOCK 16
+/* Defines a function that finds the first position at or after start in a
+ * flat buffer of graphemes where a needle occurs, or returns -1. A block of
+ * positions is checked at a time for the needle's first and last graphemes,
+ * in a loop the compiler can vectorize; only positions where both match are
+ * compared in full. */
+#define MVM_STRING_FIRST_LAST_SEARCH(NAME, TYPE) \
+static MVMint64 NAME(const TYPE *H, MVMint64 start, MVMint64 H_graphs, \
+        const TYPE *n, MVMint64 n_graphs) { \
+    const TYPE  first    = n[0]; \
+    const TYPE  last     = n[n_graphs - 1]; \
+    const TYPE *H_last   = H + n_graphs - 1; \
+    MVMint64    last_pos = H_graphs - n_graphs; \
+    MVMint64    i        = start; \
+    while (i + MVM_STRING_INDEX_FILTER_BLOCK - 1 <= last_pos) { \
+        MVMuint8 hits[MVM_STRING_INDEX_FILTER_BLOCK]; \
+        MVMuint8 any = 0; \
+        int j; \
+        MVM_VECTORIZE_LOOP \
+        for (j = 0; j < MVM_STRING_INDEX_FILTER_BLOCK; j++) { \
+            hits[j] = (H[i + j] == first) & (H_last[i + j] == last); \
+            any    |= hits[j]; \
+        } \
+        if (any) \
+            for (j = 0; j < MVM_STRING_INDEX_FILTER_BLOCK; j++) \
+                if (hits[j] && !memcmp(H + i + j + 1, n + 1, (n_graphs - 1) * sizeof(TYPE))) \
+                    return i + j; \
+        i += MVM_STRING_INDEX_FILTER_BLOCK; \
+    } \
+    for (; i <= last_pos; i++) \
+        if (H[i] == first && H_last[i] == last \
+                && !memcmp(H + i + 1, n + 1, (n_graphs - 1) * sizeof(TYPE))) \
+            return i; \
+    return -1; \
+}
+MVM_STRING_FIRST_LAST_SEARCH(first_last_search_8, MVMGrapheme8)
+MVM_STRING_FIRST_LAST_SEARCH(first_last_search_32, MVMGrapheme32)
+
+/* Search a flat buffer of 8-bit or 32-bit graphemes for a needle with the
+ * same size graphemes, from start. Returns the position found, or -1. */
+static MVMint64 flat_index_8(const MVMGrapheme8 *H, MVMint64 start, MVMint64 H_graphs,
+        const MVMGrapheme8 *n, MVMint64 n_graphs) {
+    void *found;
+    if (n_graphs <= MVM_STRING_INDEX_FILTER_MAX_NEEDLE)
+        return first_last_search_8(H, start, H_graphs, n, n_graphs);
+    found = MVM_memmem(H + start, (H_graphs - start) * sizeof(MVMGrapheme8),
+        n, n_graphs * sizeof(MVMGrapheme8));
+    return found ? (const MVMGrapheme8 *)found - H : -1;
+}
+static MVMint64 flat_index_32(const MVMGrapheme32 *H, MVMint64 start, MVMint64 H_graphs,
+        const MVMGrapheme32 *n, MVMint64 n_graphs) {
+    void *found;
+    if (n_graphs <= MVM_STRING_INDEX_FILTER_MAX_NEEDLE)
+        return first_last_search_32(H, start, H_graphs, n, n_graphs);
+    found = memmem_uint32(H + start, H_graphs - start, n, n_graphs);
+    return found ? (const MVMGrapheme32 *)found - H : -1;
+}
+
+/* Gets the flat 8-bit grapheme buffer of a string with ASCII or 8-bit
+ * storage. */
+MVM_STATIC_INLINE const MVMGrapheme8 * blob_8_of(MVMString *s) {
+    return s->body.storage_type == MVM_STRING_GRAPHEME_ASCII
+        ? (const MVMGrapheme8 *)s->body.storage.blob_ascii
+        : s->body.storage.blob_8;
+}
+
+/* Gets the graphemes of a needle as a flat buffer of 32-bit graphemes. If
+ * they have to be copied, *to_free is set to the copy, which the caller must
+ * free. */
+static const MVMGrapheme32 * needle_buf_32(MVMThreadContext *tc, MVMString *needle,
+        MVMGrapheme32 **to_free) {
+    MVMStringIndex i, n_graphs = needle->body.num_graphs;
+    MVMGrapheme32 *buf;
+    if (needle->body.storage_type == MVM_STRING_GRAPHEME_32)
+        return needle->body.storage.blob_32;
+    buf = *to_free = MVM_malloc(n_graphs * sizeof(MVMGrapheme32));
+    if (needle->body.storage_type == MVM_STRING_STRAND) {
         MVMGraphemeIter n_gi;
-        needle_buf = MVM_malloc(needle->body.num_graphs * sizeof(MVMGrapheme32));
-        if (needle->body.storage_type != MVM_STRING_GRAPHEME_8) MVM_string_gi_init(tc, &n_gi, needle);
-        for (i = 0; i < needle->body.num_graphs; i++) {
-            needle_buf[i] = needle->body.storage_type == MVM_STRING_GRAPHEME_8 ? needle->body.storage.blob_8[i] : MVM_string_gi_get_grapheme(tc, &n_gi);
+        MVM_string_gi_init(tc, &n_gi, needle);
+        for (i = 0; i < n_graphs; i++)
+            buf[i] = MVM_string_gi_get_grapheme(tc, &n_gi);
+    }
+    else {
+        const MVMGrapheme8 *blob_8 = blob_8_of(needle);
+        MVM_VECTORIZE_LOOP
+        for (i = 0; i < n_graphs; i++)
+            buf[i] = blob_8[i];
+    }
+    return buf;
+}
+
+/* Gets the graphemes of a needle as a flat buffer of 8-bit graphemes, with
+ * *to_free set as for needle_buf_32. Returns NULL if any of them doesn't fit
+ * into 8 bits, as then it can't occur in an 8-bit haystack. */
+static const MVMGrapheme8 * needle_buf_8(MVMThreadContext *tc, MVMString *needle,
+        MVMGrapheme8 **to_free) {
+    MVMStringIndex i, n_graphs = needle->body.num_graphs;
+    MVMGrapheme8 *buf;
+    switch (needle->body.storage_type) {
+        case MVM_STRING_GRAPHEME_ASCII:
+        case MVM_STRING_GRAPHEME_8:
+            return blob_8_of(needle);
+        case MVM_STRING_GRAPHEME_32:
+            if (!MVM_string_buf32_can_fit_into_8bit(needle->body.storage.blob_32, n_graphs))
+                return NULL;
+            buf = *to_free = MVM_malloc(n_graphs * sizeof(MVMGrapheme8));
+            MVM_VECTORIZE_LOOP
+            for (i = 0; i < n_graphs; i++)
+                buf[i] = needle->body.storage.blob_32[i];
+            return buf;
+        default: {
+            MVMGraphemeIter n_gi;
+            buf = *to_free = MVM_malloc(n_graphs * sizeof(MVMGrapheme8));
+            MVM_string_gi_init(tc, &n_gi, needle);
+            for (i = 0; i < n_graphs; i++) {
+                MVMGrapheme32 g = MVM_string_gi_get_grapheme(tc, &n_gi);
+                if (!can_fit_into_8bit(g)) {
+                    MVM_free(buf);
+                    *to_free = NULL;
+                    return NULL;
+                }
+                buf[i] = g;
+            }
+            return buf;
+        }
+    }
+}
+
+/* Searches a haystack made of strands a segment at a time, a segment being a
+ * strand or one repetition of it. Within a segment, the flat search is done
+ * directly on the blob the strand refers to. Matches that start in a segment
+ * but run past its end are looked for by copying the graphemes around the
+ * boundary into a small window and doing a flat search on that. The 32-bit
+ * form of the needle is only made once a 32-bit segment or a window needs
+ * it. */
+static MVMint64 strand_index(MVMThreadContext *tc, MVMString *Haystack, MVMString *needle,
+        MVMint64 start, MVMStringIndex H_graphs, MVMStringIndex n_graphs) {
+    MVMGrapheme32       *n_32_free = NULL;
+    MVMGrapheme8        *n_8_free  = NULL;
+    const MVMGrapheme32 *n_32      = NULL;
+    const MVMGrapheme8  *n_8       = needle_buf_8(tc, needle, &n_8_free);
+    MVMGrapheme32       *window    = n_graphs > 1
+        ? MVM_malloc(2 * (n_graphs - 1) * sizeof(MVMGrapheme32))
+        : NULL;
+    MVMint64 result    = -1;
+    MVMint64 seg_start = 0;
+    MVMuint16 s;
+    for (s = 0; s < Haystack->body.num_strands && result == -1; s++) {
+        MVMStringStrand *strand = &(Haystack->body.storage.strands[s]);
+        MVMString *blob_string  = strand->blob_string;
+        MVMint64 seg_graphs     = strand->end - strand->start;
+        MVMuint32 r;
+        for (r = 0; r <= strand->repetitions; r++, seg_start += seg_graphs) {
+            MVMint64 seg_end = seg_start + seg_graphs;
+            MVMint64 from    = start > seg_start ? start : seg_start;
+            if (seg_end <= from)
+                continue;
+
+            /* Matches entirely within the segment. */
+            if (seg_end - from >= n_graphs) {
+                MVMint64 found = -1;
+                if (blob_string->body.storage_type == MVM_STRING_GRAPHEME_32) {
+                    if (!n_32)
+                        n_32 = needle_buf_32(tc, needle, &n_32_free);
+                    found = flat_index_32(blob_string->body.storage.blob_32 + strand->start,
+                        from - seg_start, seg_graphs, n_32, n_graphs);
+                }
+                else if (n_8)
+                    found = flat_index_8(blob_8_of(blob_string) + strand->start,
+                        from - seg_start, seg_graphs, n_8, n_graphs);
+                if (found != -1) {
+                    result = seg_start + found;
+                    break;
+                }
+            }
+
+            /* Matches starting in the segment that span its end. Any that
+             * start in an earlier segment were covered by its window. */
+            if (window && seg_end < H_graphs) {
+                MVMint64 win_start = seg_end - (MVMint64)(n_graphs - 1);
+                MVMint64 win_end   = seg_end + (MVMint64)(n_graphs - 1);
+                if (win_start < from)
+                    win_start = from;
+                if (win_end > H_graphs)
+                    win_end = H_graphs;
+                if (win_end - win_start >= n_graphs) {
+                    MVMGraphemeIter H_gi;
+                    MVMint64 i, found;
+                    MVM_string_gi_init(tc, &H_gi, Haystack);
+                    MVM_string_gi_move_to(tc, &H_gi, win_start);
+                    for (i = 0; i < win_end - win_start; i++)
+                        window[i] = MVM_string_gi_get_grapheme(tc, &H_gi);
+                    if (!n_32)
+                        n_32 = needle_buf_32(tc, needle, &n_32_free);
+                    found = flat_index_32(window, 0, win_end - win_start, n_32, n_graphs);
+                    if (found != -1 && win_start + found < seg_end) {
+                        result = win_start + found;
+                        break;
+                    }
+                }
+            }
         }
     }
-    rtrn = MVM_string_memmem_grapheme32(tc, Haystack->body.storage.blob_32, needle_buf ? needle_buf : needle->body.storage.blob_32, H_start, H_graphs, n_graphs);
-    if (needle_buf) MVM_free(needle_buf);
-    return rtrn;
+    MVM_free(window);
+    MVM_free(n_8_free);
+    MVM_free(n_32_free);
+    return result;
 }
+
 /* Returns the location of one string in another or -1  */
 MVMint64 MVM_string_index(MVMThreadContext *tc, MVMString *Haystack, MVMString *needle, MVMint64 start) {
     size_t index           = (size_t)start;
@@ -578,50 +776,41 @@ MVMint64 MVM_string_index(MVMThreadContext *tc, MVMString *Haystack, MVMString *
     if (H_graphs < n_graphs || n_graphs < 1)
         return -1;
 
-    /* Fast paths when storage types are identical. Uses memmem function, which
-     * uses Knuth-Morris-Pratt algorithm on Linux and on others
-     * Crochemore+Perrin two-way string matching */
+    /* Fast paths for flat haystacks, with the needle converted to the same
+     * grapheme size if it differs. Short needles are found by filtering on
+     * their first and last graphemes, longer ones by two-way string matching
+     * (memmem). */
     switch (Haystack->body.storage_type) {
-        case MVM_STRING_GRAPHEME_32:
-            if (needle->body.storage_type == MVM_STRING_GRAPHEME_32 || needle->body.num_graphs < 100) {
-                return MVM_string_memmem_grapheme32str(tc, Haystack, needle, start, H_graphs, n_graphs);
-            }
-            break;
-        case MVM_STRING_GRAPHEME_8:
-            if (needle->body.storage_type == MVM_STRING_GRAPHEME_8 || needle->body.num_graphs < 100) {
-                void         *mm_return_8 = NULL;
-                MVMGrapheme8 *needle_buf  = NULL;
-                if (needle->body.storage_type != MVM_STRING_GRAPHEME_8) {
-                    MVMStringIndex i;
-                    MVMGraphemeIter n_gi;
-                    needle_buf = MVM_malloc(needle->body.num_graphs * sizeof(MVMGrapheme8));
-                    if (needle->body.storage_type != MVM_STRING_GRAPHEME_32) MVM_string_gi_init(tc, &n_gi, needle);
-                    for (i = 0; i < needle->body.num_graphs; i++) {
-                        MVMGrapheme32 g = needle->body.storage_type == MVM_STRING_GRAPHEME_32
-                            ? needle->body.storage.blob_32[i]
-                            : MVM_string_gi_get_grapheme(tc, &n_gi);
-                        /* Haystack is 8 bit, needle is 32 bit. if we encounter a non8bit grapheme
-                         * it's impossible to match */
-                        if (!can_fit_into_8bit(g)) {
-                            MVM_free(needle_buf);
-                            return -1;
-                        }
-                        needle_buf[i] = g;
-                    }
-                }
-                mm_return_8 = MVM_memmem(
-                    Haystack->body.storage.blob_8 + start, /* start position */
-                    (H_graphs - start) * sizeof(MVMGrapheme8), /* length of Haystack from start position to end */
-                    needle_buf ? needle_buf : needle->body.storage.blob_8, /* needle start */
-                    n_graphs * sizeof(MVMGrapheme8) /* needle length */
-                );
-                if (needle_buf) MVM_free(needle_buf);
-                if (mm_return_8 == NULL)
-                    return -1;
-                else
-                    return (MVMGrapheme8*)mm_return_8 -  Haystack->body.storage.blob_8;
-            }
+        case MVM_STRING_GRAPHEME_32: {
+            MVMGrapheme32 *n_free = NULL;
+            const MVMGrapheme32 *n_buf = needle_buf_32(tc, needle, &n_free);
+            MVMint64 result = flat_index_32(Haystack->body.storage.blob_32, start, H_graphs,
+                n_buf, n_graphs);
+            MVM_free(n_free);
+            return result;
+        }
+        case MVM_STRING_GRAPHEME_ASCII:
+        case MVM_STRING_GRAPHEME_8: {
+            MVMGrapheme8 *n_free = NULL;
+            const MVMGrapheme8 *n_buf = needle_buf_8(tc, needle, &n_free);
+            MVMint64 result = n_buf
+                ? flat_index_8(blob_8_of(Haystack), start, H_graphs, n_buf, n_graphs)
+                : -1;
+            MVM_free(n_free);
+            return result;
+        }
+        case MVM_STRING_STRAND: {
+            /* Search strand by strand, unless there are so many segments
+             * (usually due to repetitions) for the needle length that the
+             * searches around their boundaries would dominate. */
+            MVMuint64 segments = 0;
+            MVMuint16 s;
+            for (s = 0; s < Haystack->body.num_strands; s++)
+                segments += (MVMuint64)Haystack->body.storage.strands[s].repetitions + 1;
+            if (segments * n_graphs <= H_graphs)
+                return strand_index(tc, Haystack, needle, start, H_graphs, n_graphs);
             break;
+        }
     }
     /* Minimal code version for needles of size 1 */
     if (n_graphs == 1) {
@@ -1823,6 +2012,7 @@ MVMObject * MVM_string_encode_to_buf(MVMThreadContext *tc, MVMString *s, MVMStri
 MVMString * MVM_string_decode_from_buf_config(MVMThreadContext *tc, MVMObject *buf,
         MVMString *enc_name, MVMString *replacement, MVMint64 config) {
     MVMArrayREPRData *buf_rd;
+    MVMArrayMapping *mapping;
     MVMuint8 encoding_flag;
     MVMuint8 elem_size = 0;
 
@@ -1849,6 +2039,25 @@ MVMString * MVM_string_decode_from_buf_config(MVMThreadContext *tc, MVMObject *b
     MVMROOT(tc, buf, {
         encoding_flag = MVM_string_find_encoding(tc, enc_name);
     });
+
+    /* A private copy of a file made by map_fhb never changes, so if it's
+     * ASCII, and the encoding is one that ASCII decodes to itself in, the
+     * string can be a view of it rather than a copy. (A mapping of the file
+     * itself can't be viewed, as it changes along with the file.) */
+    mapping = ((MVMArray *)buf)->body.mapping;
+    if (mapping && mapping->private_copy && elem_size == 1
+            && ((MVMArray *)buf)->body.slots.any == mapping->block && (
+            encoding_flag == MVM_encoding_type_utf8 ||
+            encoding_flag == MVM_encoding_type_ascii ||
+            encoding_flag == MVM_encoding_type_latin1 ||
+            encoding_flag == MVM_encoding_type_utf8_c8)) {
+        MVMString *view = MVM_string_ascii_view(tc, buf,
+            (char *)(((MVMArray *)buf)->body.slots.i8 + ((MVMArray *)buf)->body.start),
+            ((MVMArray *)buf)->body.elems);
+        if (view)
+            return view;
+    }
+
     return MVM_string_decode_config(tc, tc->instance->VMString,
         (char *)(((MVMArray *)buf)->body.slots.i8 + ((MVMArray *)buf)->body.start),
         ((MVMArray *)buf)->body.elems * elem_size,
@@ -1982,6 +2191,31 @@ MVMString * MVM_string_ascii_from_buf_nocheck(MVMThreadContext *tc, MVMGrapheme8
     result->body.storage.blob_8 = buf;
     return result;
 }
+/* Makes a string that is a view of a blob of bytes held by the specified
+ * owner, rather than a copy of them. The bytes must never change or go away
+ * while the owner is alive. This is only possible if the bytes are already
+ * in NFG as ASCII; if not, returns NULL, and they should be decoded as usual
+ * instead. */
+MVMString * MVM_string_ascii_view(MVMThreadContext *tc, MVMObject *owner, const char *bytes, size_t length) {
+    MVMSTable *st = STABLE(tc->instance->VMString);
+    MVMStringView *result;
+    if (length > MAX_GRAPHEMES || !MVM_string_bytes_are_nfg_ascii((const MVMuint8 *)bytes, length))
+        return NULL;
+
+    /* Allocate it with room for the owner; see MVMStringView. */
+    MVMROOT2(tc, owner, st, {
+        result = (MVMStringView *)MVM_gc_allocate_zeroed(tc, sizeof(MVMStringView));
+    });
+    result->str.common.header.size  = sizeof(MVMStringView);
+    result->str.common.header.owner = tc->thread_id;
+    MVM_ASSIGN_REF(tc, &(result->str.common.header), result->str.common.st, st);
+
+    result->str.body.num_graphs     = (MVMStringIndex)length;
+    result->str.body.storage_type   = MVM_STRING_GRAPHEME_ASCII;
+    result->str.body.storage.blob_8 = (MVMGrapheme8 *)bytes;
+    MVM_ASSIGN_REF(tc, &(result->str.common.header), result->view_of, owner);
+    return (MVMString *)result;
+}
 MVMString * MVM_string_join(MVMThreadContext *tc, MVMString *separator, MVMObject *input) {
     MVMString  *result = NULL;
     MVMString **pieces = NULL;
@@ -75,6 +75,56 @@ MVM_STATIC_INLINE int MVM_string_buf32_can_fit_into_8bit(MVMGrapheme32 *active_b
     }
     return val ? 0 : 1;
 }
+/* Checks if a buffer of 8-bit graphemes is all ASCII, with no synthetics, in
+ * which case it encodes to the same bytes in ASCII, Latin-1, and UTF-8. When
+ * newlines are to be translated, a \n also rules that out. */
+MVM_STATIC_INLINE int MVM_string_buf8_is_plain_ascii(const MVMGrapheme8 *blob, MVMStringIndex blob_len,
+        MVMint32 translate_newlines) {
+    MVMStringIndex i;
+    MVMuint8 high    = 0;
+    MVMuint8 newline = 0;
+    MVM_VECTORIZE_LOOP
+    for (i = 0; i < blob_len; i++) {
+        high    |= (MVMuint8)blob[i] & 0x80;
+        newline |= blob[i] == '\n';
+    }
+    return !high && !(translate_newlines && newline);
+}
+/* Checks if a buffer of bytes is all ASCII other than \r, and so is already
+ * in NFG with each byte a grapheme. (\r is ruled out because it combines with
+ * a following \n into a single grapheme.) */
+MVM_STATIC_INLINE int MVM_string_bytes_are_nfg_ascii(const MVMuint8 *bytes, size_t length) {
+    size_t i;
+    MVMuint8 high = 0;
+    MVMuint8 cr   = 0;
+    MVM_VECTORIZE_LOOP
+    for (i = 0; i < length; i++) {
+        high |= bytes[i] & 0x80;
+        cr   |= bytes[i] == '\r';
+    }
+    return !high && !cr;
+}
+/* If the specified range of a string is held in a flat buffer of 8-bit
+ * graphemes that are all plain ASCII, returns a pointer to the start of the
+ * range, so that an encoder can copy or widen it directly rather than going
+ * through a codepoint iterator. Otherwise, returns NULL. */
+MVM_STATIC_INLINE const MVMGrapheme8 * MVM_string_plain_ascii_range(MVMThreadContext *tc, MVMString *s,
+        MVMint64 start, MVMint64 length, MVMint32 translate_newlines) {
+    const MVMGrapheme8 *blob;
+    switch (s->body.storage_type) {
+        case MVM_STRING_GRAPHEME_ASCII:
+            blob = (const MVMGrapheme8 *)s->body.storage.blob_ascii + start;
+            break;
+        case MVM_STRING_GRAPHEME_8:
+            blob = s->body.storage.blob_8 + start;
+            break;
+        default:
+            return NULL;
+    }
+    return MVM_string_buf8_is_plain_ascii(blob, (MVMStringIndex)length, translate_newlines)
+        ? blob
+        : NULL;
+}
 MVMGrapheme32 MVM_string_get_grapheme_at_nocheck(MVMThreadContext *tc, MVMString *a, MVMint64 index);
 MVMint64 MVM_string_equal(MVMThreadContext *tc, MVMString *a, MVMString *b);
 MVMint64 MVM_string_substrings_equal_nocheck(MVMThreadContext *tc, MVMString *a,
@@ -135,6 +185,7 @@ MVMString * MVM_string_chr(MVMThreadContext *tc, MVMint64 cp);
 MVMint64 MVM_string_grapheme_is_cclass(MVMThreadContext *tc, MVMint64 cclass, MVMGrapheme32 g);
 void MVM_string_compute_hash_code(MVMThreadContext *tc, MVMString *s);
 MVMString * MVM_string_ascii_from_buf_nocheck(MVMThreadContext *tc, MVMGrapheme8 *buf, MVMStringIndex len);
+MVMString * MVM_string_ascii_view(MVMThreadContext *tc, MVMObject *owner, const char *bytes, size_t length);
 char * MVM_string_encoding_cname(MVMThreadContext *tc, MVMint64 encoding);
 /* If MVM_DEBUG_NFG is 1, calls to NFG_CHECK will re_nfg the given string
  * and compare num_graphs before and after the normalization.
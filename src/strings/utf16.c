@@ -327,6 +327,7 @@ char * MVM_string_utf16_encode_substr_main(MVMThreadContext *tc, MVMString *str,
     MVMuint64 repl_length = 0;
     MVMint32 alloc_size;
     MVMuint64 scratch_space = 0;
+    const MVMGrapheme8 *ascii;
     int enable_byte_swap = 0;
 #ifdef MVM_BIGENDIAN
     if (endianess == UTF16_DECODE_LITTLE_ENDIAN)
@@ -348,6 +349,28 @@ char * MVM_string_utf16_encode_substr_main(MVMThreadContext *tc, MVMString *str,
     alloc_size = lengthu * 2;
     result = MVM_malloc(alloc_size + 2);
     result_pos = result;
+
+    /* Plain ASCII just needs widening to 16 bits. */
+    ascii = MVM_string_plain_ascii_range(tc, str, start, lengthu, translate_newlines);
+    if (ascii) {
+        MVMuint32 i;
+        if (enable_byte_swap) {
+            MVM_VECTORIZE_LOOP
+            for (i = 0; i < lengthu; i++)
+                result[i] = (MVMuint16)((MVMuint8)ascii[i] << 8);
+        }
+        else {
+            MVM_VECTORIZE_LOOP
+            for (i = 0; i < lengthu; i++)
+                result[i] = (MVMuint8)ascii[i];
+        }
+        result[lengthu] = 0;
+        if (output_size)
+            *output_size = (MVMuint64)lengthu * 2;
+        MVM_free(repl_bytes);
+        return (char *)result;
+    }
+
     MVM_string_ci_init(tc, &ci, str, translate_newlines, 0);
     while (MVM_string_ci_has_more(tc, &ci)) {
         int bytes_needed;
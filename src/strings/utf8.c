@@ -168,6 +168,35 @@ static MVMint32 utf8_encode(MVMuint8 *bp, MVMCodepoint cp) {
 
 #define UTF8_MAXINC (32 * 1024 * 1024)
 
+/* Runs of ASCII are checked for a block of this many bytes at a time, and
+ * shorter runs aren't worth taking the fast paths for. */
+#define UTF8_ASCII_BLOCK 16
+
+/* Finds how many of the bytes at the start of the buffer are ASCII other than
+ * \r. Each of those decodes to a codepoint of the same value, which can't
+ * combine with another one of them into a grapheme (\r is the exception, as
+ * it combines with a following \n), so they need neither the DFA nor the
+ * normalizer. The inner loop is written so the compiler can vectorize it. */
+static size_t ascii_run_length(const MVMuint8 *bytes, size_t length) {
+    size_t pos = 0;
+    while (length - pos >= UTF8_ASCII_BLOCK) {
+        MVMuint8 high = 0;
+        MVMuint8 cr   = 0;
+        size_t i;
+        MVM_VECTORIZE_LOOP
+        for (i = 0; i < UTF8_ASCII_BLOCK; i++) {
+            high |= bytes[pos + i] & 0x80;
+            cr   |= bytes[pos + i] == '\r';
+        }
+        if (high | cr)
+            break;
+        pos += UTF8_ASCII_BLOCK;
+    }
+    while (pos < length && bytes[pos] < 0x80 && bytes[pos] != '\r')
+        pos++;
+    return pos;
+}
+
 /* Decodes the specified number of bytes of utf8 into an NFG string, creating
  * a result of the specified type. The type must have the MVMString REPR. */
 MVMString * MVM_string_utf8_decode(MVMThreadContext *tc, const MVMObject *result_type, const char *utf8, size_t bytes) {
@@ -177,21 +206,75 @@ MVMString * MVM_string_utf8_decode(MVMThreadContext *tc, const MVMObject *result
     MVMint32 line_ending = 0;
     MVMint32 state = 0;
     MVMint32 bufsize = bytes;
-    MVMGrapheme32 *buffer = MVM_malloc(sizeof(MVMGrapheme32) * bufsize);
+    MVMGrapheme32 *buffer;
     size_t orig_bytes;
     const char *orig_utf8;
+    const char *ascii_scan_from;
+    size_t ascii_prefix;
     MVMint32 line;
     MVMint32 col;
     MVMint32 ready;
+    MVMNormalizer norm;
+
+    /* If it's all ASCII, which is common enough, then it's already in NFG
+     * and can be copied straight into an 8-bit buffer. */
+    ascii_prefix = ascii_run_length((const MVMuint8 *)utf8, bytes);
+    if (ascii_prefix == bytes) {
+        MVMGrapheme8 *new_buffer = MVM_malloc(sizeof(MVMGrapheme8) * bytes);
+        memcpy(new_buffer, utf8, bytes);
+        result->body.storage.blob_8  = new_buffer;
+        result->body.storage_type    = MVM_STRING_GRAPHEME_8;
+        result->body.num_graphs      = bytes;
+        return result;
+    }
+    buffer = MVM_malloc(sizeof(MVMGrapheme32) * bufsize);
 
     /* Need to normalize to NFG as we decode. */
-    MVMNormalizer norm;
     MVM_unicode_normalizer_init(tc, &norm, MVM_NORMALIZE_NFG);
 
     orig_bytes = bytes;
     orig_utf8 = utf8;
+    ascii_scan_from = utf8;
 
     for (; bytes; ++utf8, --bytes) {
+        /* Look for a run of ASCII to copy directly, unless we already know
+         * there isn't one starting before the last place we looked. The
+         * first byte of the run may combine with what the normalizer has
+         * held on to (for example, a \n after a \r), and the last one may
+         * combine with what follows it, so those two are decoded as usual.
+         * Nothing in between can combine with anything, so once the first
+         * has been processed, we flush the normalizer and copy the rest. */
+        if (state == UTF8_ACCEPT && utf8 >= ascii_scan_from) {
+            size_t run = utf8 == orig_utf8
+                ? ascii_prefix
+                : ascii_run_length((const MVMuint8 *)utf8, bytes);
+            ascii_scan_from = utf8 + run + 1;
+            if (run >= UTF8_ASCII_BLOCK) {
+                MVMGrapheme32 g;
+                MVMint32 available;
+                size_t i;
+                ready = MVM_unicode_normalizer_process_codepoint_to_grapheme(tc,
+                    &norm, (MVMuint8)*utf8, &g);
+                MVM_unicode_normalizer_eof(tc, &norm);
+                available = MVM_unicode_normalizer_available(tc, &norm);
+                while (count + (ready ? 1 : 0) + available + (run - 2) > (size_t)bufsize) {
+                    buffer = MVM_realloc(buffer, sizeof(MVMGrapheme32) * (
+                        bufsize >= UTF8_MAXINC ? (bufsize += UTF8_MAXINC) : (bufsize *= 2)
+                    ));
+                }
+                if (ready)
+                    buffer[count++] = g;
+                while (available--)
+                    buffer[count++] = MVM_unicode_normalizer_get_grapheme(tc, &norm);
+                MVM_VECTORIZE_LOOP
+                for (i = 1; i < run - 1; i++)
+                    buffer[count + i - 1] = (MVMuint8)utf8[i];
+                count += run - 2;
+                utf8  += run - 1;
+                bytes -= run - 1;
+            }
+        }
+
         switch(MVM_EXPECT(decode_utf8_byte(&state, &codepoint, (MVMuint8)*utf8), UTF8_ACCEPT)) {
         case UTF8_ACCEPT: { /* got a codepoint */
             MVMGrapheme32 g;
@@ -405,6 +488,7 @@ MVMuint32 MVM_string_utf8_decodestream(MVMThreadContext *tc, MVMDecodeStream *ds
             /* Lift the no lag codepoint case out of the hot loop below,
              * to save on a couple of branches. */
             MVMCodepoint first_significant = ds->norm.first_significant;
+            MVMint32 ascii_scan_from;
             while (lag_codepoint == -1 && pos < cur_bytes->length) {
                 switch(MVM_EXPECT(decode_utf8_byte(&state, &codepoint, bytes[pos++]), UTF8_ACCEPT)) {
                 case UTF8_ACCEPT: {
@@ -427,7 +511,41 @@ MVMuint32 MVM_string_utf8_decodestream(MVMThreadContext *tc, MVMDecodeStream *ds
                 }
             }
 
+            ascii_scan_from = pos;
             while (pos < cur_bytes->length) {
+                /* Long runs of ASCII don't need the DFA or the checks for
+                 * codepoints significant to normalization; we just emit the
+                 * lagging codepoint and lag each byte in turn, leaving the
+                 * final byte of the run to be decoded as usual. */
+                if (state == UTF8_ACCEPT && pos >= ascii_scan_from) {
+                    MVMint32 run = (MVMint32)ascii_run_length(bytes + pos,
+                        cur_bytes->length - pos);
+                    ascii_scan_from = pos + run + 1;
+                    if (run >= UTF8_ASCII_BLOCK) {
+                        MVMint32 end = pos + run - 1;
+                        while (pos < end) {
+                            if (count == bufsize) {
+                                MVM_string_decodestream_add_chars(tc, ds, buffer, bufsize);
+                                buffer = MVM_malloc(bufsize * sizeof(MVMGrapheme32));
+                                count = 0;
+                            }
+                            buffer[count++] = lag_codepoint;
+                            total++;
+                            if (MVM_string_decode_stream_maybe_sep(tc, seps, lag_codepoint) ||
+                                    (stopper_chars && *stopper_chars == total)) {
+                                reached_stopper = 1;
+                                last_accept_bytes = lag_last_accept_bytes;
+                                last_accept_pos = lag_last_accept_pos;
+                                goto done;
+                            }
+                            lag_codepoint = bytes[pos++];
+                            lag_last_accept_bytes = cur_bytes;
+                            lag_last_accept_pos = pos;
+                        }
+                        continue;
+                    }
+                }
+
                 switch(MVM_EXPECT(decode_utf8_byte(&state, &codepoint, bytes[pos++]), UTF8_ACCEPT)) {
                 case UTF8_ACCEPT: {
                     /* If we hit something that needs the normalizer, we put
@@ -559,6 +677,7 @@ char * MVM_string_utf8_encode_substr(MVMThreadContext *tc,
     MVMStringIndex   strgraphs  = MVM_string_graphs(tc, str);
     MVMuint8        *repl_bytes = NULL;
     MVMuint64        repl_length;
+    const MVMGrapheme8 *ascii;
 
     if (start < 0 || start > strgraphs)
         MVM_exception_throw_adhoc(tc, "start (%"PRId64") out of range (0..%"PRIu32")", start, strgraphs);
@@ -567,6 +686,16 @@ char * MVM_string_utf8_encode_substr(MVMThreadContext *tc,
     if (length < 0 || start + length > strgraphs)
         MVM_exception_throw_adhoc(tc, "length (%"PRId64") out of range (0..%"PRIu32")", length, strgraphs);
 
+    /* Plain ASCII is already UTF-8, so can just be copied. */
+    ascii = MVM_string_plain_ascii_range(tc, str, start, length, translate_newlines);
+    if (ascii) {
+        result = MVM_malloc(length + 1);
+        memcpy(result, ascii, length);
+        if (output_size)
+            *output_size = (MVMuint64)length;
+        return (char *)result;
+    }
+
     if (replacement)
         repl_bytes = (MVMuint8 *) MVM_string_utf8_encode_substr(tc,
             replacement, &repl_length, 0, -1, NULL, translate_newlines);
@@ -5,6 +5,7 @@ typedef struct MVMArgInfo MVMArgInfo;
 typedef struct MVMArgProcContext MVMArgProcContext;
 typedef struct MVMArray MVMArray;
 typedef struct MVMArrayBody MVMArrayBody;
+typedef struct MVMArrayMapping MVMArrayMapping;
 typedef struct MVMArrayREPRData MVMArrayREPRData;
 typedef struct MVMAsyncTask MVMAsyncTask;
 typedef struct MVMAsyncTaskBody MVMAsyncTaskBody;
@@ -65,6 +66,8 @@ typedef struct MVMHashBody MVMHashBody;
 typedef struct MVMHashEntry MVMHashEntry;
 typedef struct MVMHLLConfig MVMHLLConfig;
 typedef struct MVMIntConstCache MVMIntConstCache;
+typedef struct MVMIndexHashBucket MVMIndexHashBucket;
+typedef struct MVMIndexHashTable MVMIndexHashTable;
 typedef struct MVMInstance MVMInstance;
 typedef struct MVMInvocationSpec MVMInvocationSpec;
 typedef struct MVMIter MVMIter;
@@ -73,7 +76,6 @@ typedef struct MVMKnowHOWAttributeREPR MVMKnowHOWAttributeREPR;
 typedef struct MVMKnowHOWAttributeREPRBody MVMKnowHOWAttributeREPRBody;
 typedef struct MVMKnowHOWREPR MVMKnowHOWREPR;
 typedef struct MVMKnowHOWREPRBody MVMKnowHOWREPRBody;
-typedef struct MVMLexicalRegistry MVMLexicalRegistry;
 typedef struct MVMLoadedCompUnitName MVMLoadedCompUnitName;
 typedef struct MVMNFA MVMNFA;
 typedef struct MVMNFABody MVMNFABody;
@@ -126,6 +128,9 @@ typedef struct MVMSemaphoreBody MVMSemaphoreBody;
 typedef struct MVMConcBlockingQueue MVMConcBlockingQueue;
 typedef struct MVMConcBlockingQueueBody MVMConcBlockingQueueBody;
 typedef struct MVMConcBlockingQueueNode MVMConcBlockingQueueNode;
+typedef struct MVMWorkStealingDeque MVMWorkStealingDeque;
+typedef struct MVMWorkStealingDequeBody MVMWorkStealingDequeBody;
+typedef struct MVMWorkStealingDequeArray MVMWorkStealingDequeArray;
 typedef struct MVMObject MVMObject;
 typedef struct MVMObjectId MVMObjectId;
 typedef struct MVMObjectStooge MVMObjectStooge;
@@ -164,6 +169,8 @@ typedef struct MVMSpeshGraph MVMSpeshGraph;
 typedef struct MVMSpeshMemBlock MVMSpeshMemBlock;
 typedef struct MVMSpeshTemporary MVMSpeshTemporary;
 typedef struct MVMSpeshBB MVMSpeshBB;
+typedef struct MVMSpeshCacheEntry MVMSpeshCacheEntry;
+typedef struct MVMSpeshPreloadRecord MVMSpeshPreloadRecord;
 typedef struct MVMSpeshIns MVMSpeshIns;
 typedef union MVMSpeshOperand MVMSpeshOperand;
 typedef struct MVMSpeshAnn MVMSpeshAnn;
@@ -221,6 +228,11 @@ typedef struct MVMString MVMString;
 typedef struct MVMStringBody MVMStringBody;
 typedef struct MVMStringConsts MVMStringConsts;
 typedef struct MVMStringStrand MVMStringStrand;
+typedef struct MVMStringView MVMStringView;
+typedef struct MVMStrHashBucket MVMStrHashBucket;
+typedef struct MVMStrHashHandle MVMStrHashHandle;
+typedef struct MVMStrHashIterator MVMStrHashIterator;
+typedef struct MVMStrHashTable MVMStrHashTable;
 typedef struct MVMGraphemeIter MVMGraphemeIter;
 typedef struct MVMCodepointIter MVMCodepointIter;
 typedef struct MVMThread MVMThread;
@@ -242,6 +254,7 @@ typedef struct MVMIOSeekable MVMIOSeekable;
 typedef struct MVMIOSockety MVMIOSockety;
 typedef struct MVMIOIntrospection MVMIOIntrospection;
 typedef struct MVMIOLockable MVMIOLockable;
+typedef struct MVMIOMappable MVMIOMappable;
 typedef struct MVMDecodeStream MVMDecodeStream;
 typedef struct MVMDecodeStreamBytes MVMDecodeStreamBytes;
 typedef struct MVMDecodeStreamChars MVMDecodeStreamChars;
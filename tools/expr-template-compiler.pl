@@ -387,8 +387,8 @@ sub compile_reference {
         my ($ref, $name) = $expr =~ m/^(\\?)\$(\w+)/;
     if (looks_like_number($name)) {
         my $opcode = $compiler->{opcode};
-        # special case for dec_i/inc_i
-        return 'i' => $name if $opcode =~ m/^(dec|inc)_i$/ and $name <= 1;
+        # special case for dec_i/inc_i/dec_u/inc_u
+        return 'i' => $name if $opcode =~ m/^(dec|inc)_[iu]$/ and $name <= 1;
         my @direction = operand_direction($opcode);
         die "Invalid operand reference $expr for $opcode"
             unless $name >= 0 && $name < @direction;